@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include "Controllers/CommandRouter.h"
+
+static constexpr size_t SUBCOMMAND_COUNT = 8;
+
+static dpp::slashcommand_t CreateEvent(const dpp::snowflake& id, const std::string& command, const std::string& subcommand)
+{
+    dpp::command_interaction interaction;
+    interaction.id = id;
+    interaction.name = command;
+
+    dpp::command_data_option option;
+    option.name = subcommand;
+    option.type = dpp::co_sub_command;
+    interaction.options.push_back(option);
+
+    dpp::slashcommand_t event(nullptr, "");
+    event.command.data = interaction;
+    return event;
+}
+
+static std::string CommandName(size_t i) { return "command_" + std::to_string(i); }
+static std::string SubcommandName(size_t i) { return "subcommand_" + std::to_string(i); }
+
+// Previous dispatch: every controller compares the command name, then the subcommand names in turn
+static void BM_DispatchLinear(benchmark::State& state)
+{
+    size_t commandCount = state.range(0);
+    size_t calls = 0;
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> controllers;
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+        controllers.emplace_back(CommandName(i), std::vector<std::string>());
+        for (size_t j = 0; j < SUBCOMMAND_COUNT; ++j)
+            controllers.back().second.push_back(SubcommandName(j));
+    }
+
+    auto event = CreateEvent(commandCount, CommandName(commandCount - 1), SubcommandName(SUBCOMMAND_COUNT - 1));
+
+    for (auto _ : state)
+    {
+        for (const auto& [command, subcommands] : controllers)
+        {
+            if (event.command.get_command_name() != command)
+                continue;
+
+            auto subcommand = event.command.get_command_interaction().options[0].name;
+            for (const auto& name : subcommands)
+            {
+                if (subcommand == name)
+                {
+                    ++calls;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    benchmark::DoNotOptimize(calls);
+}
+
+static void BM_DispatchRouter(benchmark::State& state)
+{
+    size_t commandCount = state.range(0);
+    size_t calls = 0;
+
+    CommandRouter router;
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+        for (size_t j = 0; j < SUBCOMMAND_COUNT; ++j)
+            router.addRoute(CommandName(i), SubcommandName(j), [&calls](const dpp::slashcommand_t&) { ++calls; });
+
+        router.bindCommandId(CommandName(i), i + 1);
+    }
+
+    auto event = CreateEvent(commandCount, CommandName(commandCount - 1), SubcommandName(SUBCOMMAND_COUNT - 1));
+
+    for (auto _ : state)
+        router.dispatch(event);
+
+    benchmark::DoNotOptimize(calls);
+}
+
+// Argument: number of commands, each having 8 subcommands
+BENCHMARK(BM_DispatchLinear)->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK(BM_DispatchRouter)->RangeMultiplier(10)->Range(1, 1000);
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <future>
+#include <latch>
+
+#include <dpp/dpp.h>
+
+#include "MockRestEndpoint.h"
+#include "Threading/WorkerPool.h"
+
+static constexpr size_t IN_FLIGHT = 256;
+static constexpr auto ENDPOINT_LATENCY = std::chrono::milliseconds(5);
+// Tasks of the previous iteration may still be accounted for when the next one starts
+static constexpr size_t POOL_CAPACITY = 2 * IN_FLIGHT;
+
+// Blocking handler: the worker waits for the REST answer
+static void BM_InteractionsBlocking(benchmark::State& state)
+{
+    WorkerPool pool(state.range(0), POOL_CAPACITY);
+    MockRestEndpoint endpoint(ENDPOINT_LATENCY);
+
+    for (auto _ : state)
+    {
+        std::latch done(IN_FLIGHT);
+
+        for (size_t i = 0; i < IN_FLIGHT; ++i)
+        {
+            pool.submit([&]() {
+                std::promise<bool> answer;
+                endpoint.post([&answer](bool success) { answer.set_value(success); });
+                answer.get_future().wait();
+                done.count_down();
+            });
+        }
+
+        done.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * IN_FLIGHT);
+}
+
+static dpp::job RunInteraction(WorkerPool& pool, MockRestEndpoint& endpoint, std::latch& done)
+{
+    co_await pool.schedule();
+
+    // The worker is released until the endpoint answers
+    co_await dpp::async<bool>([&endpoint](auto&& onDone) { endpoint.post(onDone); });
+
+    done.count_down();
+}
+
+// Coroutine handler: the worker is free while the REST call is in flight
+static void BM_InteractionsCoroutine(benchmark::State& state)
+{
+    WorkerPool pool(state.range(0), POOL_CAPACITY);
+    MockRestEndpoint endpoint(ENDPOINT_LATENCY);
+
+    for (auto _ : state)
+    {
+        std::latch done(IN_FLIGHT);
+
+        for (size_t i = 0; i < IN_FLIGHT; ++i)
+            RunInteraction(pool, endpoint, done);
+
+        done.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * IN_FLIGHT);
+}
+
+// Argument: number of worker threads. 256 interactions in flight, each waiting 5ms on the endpoint
+BENCHMARK(BM_InteractionsBlocking)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_InteractionsCoroutine)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "Logging/Logger.h"
+
+static const std::string TIMER_ID = "timer-benchmark";
+
+// What a fire paid before: the line was built whether or not it was written
+static void BM_LogConcatenated(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::string line = "Timer \"" + TIMER_ID + "\" triggered";
+        benchmark::DoNotOptimize(line);
+    }
+}
+
+static void BM_LogFiltered(benchmark::State& state)
+{
+    Logger::Start(dpp::ll_warning, [](std::string_view) {});
+
+    for (auto _ : state)
+        Logger::Log(dpp::ll_info, "Timer triggered", LogField("id", TIMER_ID), LogField("channel", dpp::snowflake(42)));
+
+    Logger::Stop();
+}
+
+// Capture only, the entries are written outside of the timed region
+static void BM_LogCaptured(benchmark::State& state)
+{
+    Logger::Start(dpp::ll_info, [](std::string_view) {});
+    size_t count = 0;
+
+    for (auto _ : state)
+    {
+        Logger::Log(dpp::ll_info, "Timer triggered", LogField("id", TIMER_ID), LogField("channel", dpp::snowflake(42)));
+
+        if (++count % (Logger::ENTRIES_PER_THREAD / 2) == 0)
+        {
+            state.PauseTiming();
+            Logger::Flush();
+            state.ResumeTiming();
+        }
+    }
+
+    Logger::Stop();
+}
+
+BENCHMARK(BM_LogConcatenated);
+BENCHMARK(BM_LogFiltered);
+BENCHMARK(BM_LogCaptured);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "Metrics/MetricsRegistry.h"
+
+static MetricsRegistry REGISTRY;
+
+static void BM_HistogramRecord(benchmark::State& state)
+{
+    static Histogram& histogram = REGISTRY.histogram("bench_duration_seconds", "Benchmark.");
+    uint64_t value = 1'000'000;
+
+    for (auto _ : state)
+    {
+        histogram.record(value);
+        value = value * 7 % 1'000'003;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Timing a scope costs two steady_clock reads on top of the record
+static void BM_ScopedLatency(benchmark::State& state)
+{
+    static Histogram& histogram = REGISTRY.histogram("bench_scope_seconds", "Benchmark.");
+
+    for (auto _ : state)
+        ScopedLatency timing(&histogram);
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_CounterIncrement(benchmark::State& state)
+{
+    static Counter& counter = REGISTRY.counter("bench_total", "Benchmark.");
+
+    for (auto _ : state)
+        counter.increment();
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_RenderPrometheus(benchmark::State& state)
+{
+    for (int i = 0; i < 20; ++i)
+        REGISTRY.histogram("bench_render_seconds", "Benchmark.", MetricsRegistry::Labels({ { "route", std::to_string(i) } })).record(uint64_t(i) * 1000);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(REGISTRY.renderPrometheus());
+}
+
+BENCHMARK(BM_HistogramRecord)->ThreadRange(1, 4);
+BENCHMARK(BM_ScopedLatency);
+BENCHMARK(BM_CounterIncrement)->ThreadRange(1, 4);
+BENCHMARK(BM_RenderPrometheus)->Unit(benchmark::kMicrosecond);
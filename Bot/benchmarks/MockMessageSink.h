@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Discord/MessageSink.h"
+
+/**
+ * @brief Local REST sink, only counting what would have been sent.
+ * 
+ */
+class MockMessageSink final : public IMessageSink
+{
+public:
+    void createMessage(const dpp::snowflake& channel, const std::string& body, Callback_Type onDone = nullptr) override
+    {
+        ++m_MessageCount;
+        m_ByteCount += body.size();
+
+        if (onDone)
+            onDone(true);
+    }
+
+    void createEditableMessage(const dpp::snowflake& channel, const std::string& body, CreatedCallback_Type onCreated) override
+    {
+        ++m_MessageCount;
+        m_ByteCount += body.size();
+
+        if (onCreated)
+            onCreated(dpp::snowflake(m_MessageCount));
+    }
+
+    void editMessage(const dpp::snowflake& channel, const dpp::snowflake& message, const std::string& body, Callback_Type onDone = nullptr) override
+    {
+        ++m_EditCount;
+        m_ByteCount += body.size();
+
+        if (onDone)
+            onDone(true);
+    }
+
+    inline size_t getMessageCount() const { return m_MessageCount; }
+    inline size_t getEditCount() const { return m_EditCount; }
+    inline size_t getByteCount() const { return m_ByteCount; }
+
+private:
+    size_t m_MessageCount = 0;
+    size_t m_EditCount = 0;
+    size_t m_ByteCount = 0;
+};
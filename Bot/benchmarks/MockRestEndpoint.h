@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Local REST endpoint answering every request after a fixed latency, on its own thread.
+ * 
+ */
+class MockRestEndpoint
+{
+public:
+    using Callback_Type = std::function<void(bool success)>;
+
+public:
+    MockRestEndpoint(std::chrono::microseconds latency)
+        : m_Latency(latency), m_Thread([this]() { serve(); })
+    {
+    }
+
+    ~MockRestEndpoint()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+
+        m_Condition.notify_one();
+        m_Thread.join();
+    }
+
+    void post(Callback_Type onDone)
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Requests.push_back(Request{ std::chrono::steady_clock::now() + m_Latency, std::move(onDone) });
+        }
+
+        m_Condition.notify_one();
+    }
+
+private:
+    struct Request
+    {
+        std::chrono::steady_clock::time_point deadline;
+        Callback_Type onDone;
+    };
+
+private:
+    void serve()
+    {
+        std::unique_lock lock(m_Mutex);
+
+        while (true)
+        {
+            m_Condition.wait(lock, [this]() { return m_Stopping || !m_Requests.empty(); });
+
+            if (m_Requests.empty())
+                return;
+
+            // Constant latency, requests complete in arrival order
+            Request request = std::move(m_Requests.front());
+            m_Requests.pop_front();
+
+            lock.unlock();
+            std::this_thread::sleep_until(request.deadline);
+            request.onDone(true);
+            lock.lock();
+        }
+    }
+
+private:
+    std::chrono::microseconds m_Latency;
+    std::deque<Request> m_Requests;
+    bool m_Stopping = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::thread m_Thread;
+};
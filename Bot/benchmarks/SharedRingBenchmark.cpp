@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+
+#include "Cluster/SharedRing.h"
+#include "Firing/TimerMutation.h"
+
+static TimerMutation CreateUpsert()
+{
+    auto now = std::chrono::system_clock::now();
+
+    TimerMutation mutation;
+    mutation.id = "timer-benchmark";
+    mutation.zone = "Europe/Paris";
+    mutation.timer = TimerDTO("timer-benchmark", dpp::snowflake(42), 60, "{rem:minuts} minutes left", now, now + std::chrono::hours(1), "", "", dpp::snowflake(7));
+
+    return mutation;
+}
+
+// What the command process pays per timer mutation, the engine side included
+static void BM_SharedRingUpsert(benchmark::State& state)
+{
+    auto producer = SharedRing::Create("/discord-timer-bot-benchmark");
+    auto consumer = SharedRing::Open("/discord-timer-bot-benchmark");
+    auto mutation = CreateUpsert();
+
+    std::string record, popped;
+
+    for (auto _ : state)
+    {
+        mutation.encode(record);
+        producer->tryPush(record);
+        consumer->tryPop(popped);
+        benchmark::DoNotOptimize(TimerMutation::Decode(popped));
+    }
+}
+
+BENCHMARK(BM_SharedRingUpsert);
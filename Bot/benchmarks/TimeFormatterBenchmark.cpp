@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <iomanip>
+#include <sstream>
+
+#include "Time/TimeFormatter.h"
+
+// Previous implementation of TimerController::GetFormattedTime
+static std::string FormatLocaltime(const TimeFormatter::TimePoint_Type& time)
+{
+    auto time_t = std::chrono::system_clock::to_time_t(time);
+    auto tm = std::localtime(&time_t);
+
+    std::stringstream ss;
+    ss << std::put_time(tm, "%d/%m/%Y %H:%M:%S");
+
+    return ss.str();
+}
+
+static void BM_FormatLocaltime(benchmark::State& state)
+{
+    auto time = std::chrono::system_clock::now();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FormatLocaltime(time));
+        time += std::chrono::seconds(state.range(0));
+    }
+}
+
+static void BM_FormatTimeFormatter(benchmark::State& state)
+{
+    auto time = std::chrono::system_clock::now();
+    auto zone = TimeFormatter::GetDefaultZone();
+    TimeFormatter::Buffer_Type buffer;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(TimeFormatter::Format(time, zone, buffer));
+        time += std::chrono::seconds(state.range(0));
+    }
+}
+
+// Argument: seconds between two formatted times. 0 formats the same second (cached), 1 always misses.
+BENCHMARK(BM_FormatLocaltime)->Arg(0)->Arg(1);
+BENCHMARK(BM_FormatTimeFormatter)->Arg(0)->Arg(1);
+BENCHMARK(BM_FormatTimeFormatter)->Arg(0)->Arg(1)->Threads(4);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <ctime>
+#include <map>
+#include <sstream>
+
+#include "Time/TimeParser.h"
+
+// Previous implementations of TimerController::ParseTime and ParseInteval, without error handling
+static TimeParser::TimePoint_Type StreamParseTime(const std::string& time)
+{
+    std::stringstream ss(time);
+
+    int day = -1, month = -1, year = -1, hour = -1, minute = -1, second = -1;
+    char sep1, sep2, sep4, sep5;
+
+    ss >> day >> sep1 >> month >> sep2 >> year >> hour >> sep4 >> minute >> sep5 >> second;
+
+    std::tm tm = {};
+    tm.tm_mday = day;
+    tm.tm_mon = month - 1;
+    tm.tm_year = year - 1900;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_sec = second;
+
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+}
+
+static int64_t StreamParseInterval(const std::string& interval)
+{
+    static std::map<std::string, int64_t, std::less<std::string>> multipliers = {
+        {"d", 60 * 60 * 24},
+        {"h", 60 * 60},
+        {"m", 60},
+        {"s", 1},
+    };
+
+    std::stringstream ss(interval);
+    int64_t total = 0;
+
+    while (!ss.eof())
+    {
+        int64_t value;
+        std::string unit;
+
+        ss >> value >> unit;
+        total += value * multipliers.at(unit);
+    }
+
+    return total;
+}
+
+static const std::string TIME = "14/11/2023 22:13:20";
+static const std::string INTERVAL = "1d 2h 3m 4s";
+
+static void BM_ParseTimeStream(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(StreamParseTime(TIME));
+}
+
+static void BM_ParseTime(benchmark::State& state)
+{
+    auto zone = TimeFormatter::GetDefaultZone();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(TimeParser::ParseTime(TIME, zone));
+}
+
+static void BM_ParseIntervalStream(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(StreamParseInterval(INTERVAL));
+}
+
+static void BM_ParseInterval(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(TimeParser::ParseInterval(INTERVAL));
+}
+
+BENCHMARK(BM_ParseTimeStream);
+BENCHMARK(BM_ParseTime);
+BENCHMARK(BM_ParseIntervalStream);
+BENCHMARK(BM_ParseInterval);
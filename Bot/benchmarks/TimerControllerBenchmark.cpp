@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include "Controllers/TimerController.h"
+#include "Discord/TimerPayload.h"
+#include "Time/VirtualClock.h"
+
+// Fixed time, so that delays and rendered countdowns are the same on every run
+static const VirtualClock CLOCK(std::chrono::sys_days(std::chrono::year(2024) / 1 / 1));
+
+// Inputs of N "/timer set" commands, each parsed once
+static std::vector<std::string> CreateTimes(size_t count)
+{
+    std::vector<std::string> times;
+    times.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%02zu/%02zu/%04zu %02zu:%02zu:%02zu",
+            1 + i % 28, 1 + i % 12, 2024 + i % 10, i % 24, i % 60, (i / 60) % 60);
+        times.emplace_back(buffer);
+    }
+
+    return times;
+}
+
+static std::vector<std::string> CreateIntervals(size_t count)
+{
+    std::vector<std::string> intervals;
+    intervals.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+        intervals.push_back(std::to_string(i % 7) + "d " + std::to_string(i % 24) + "h " + std::to_string(1 + i % 59) + "m " + std::to_string(i % 60) + "s");
+
+    return intervals;
+}
+
+// Shared records, as stored by the TimerDAO and handed to TimerController::Timer
+static std::vector<TimerSnapshot::Record_Type> CreateTimers(size_t count)
+{
+    std::vector<TimerSnapshot::Record_Type> timers;
+    timers.reserve(count);
+
+    auto now = CLOCK.now();
+
+    for (size_t i = 0; i < count; ++i)
+        timers.push_back(std::make_shared<const TimerDTO>("timer_" + std::to_string(i), dpp::snowflake(1234567890 + i), 60 + i % 3600,
+            "Only {rem:days} days, {rem:hours} hours left before {end}!", now - std::chrono::seconds(i % 86400),
+            now + std::chrono::hours(24 * 7), "", "Timer {name}", dpp::snowflake(987654321 + i % 1000)));
+
+    return timers;
+}
+
+static void BM_ParseTimeBatch(benchmark::State& state)
+{
+    auto times = CreateTimes(state.range(0));
+
+    for (auto _ : state)
+        for (const auto& time : times)
+            benchmark::DoNotOptimize(TimerController::ParseTime(time));
+
+    state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+static void BM_ParseIntervalBatch(benchmark::State& state)
+{
+    auto intervals = CreateIntervals(state.range(0));
+
+    for (auto _ : state)
+        for (const auto& interval : intervals)
+            benchmark::DoNotOptimize(TimerController::ParseInteval(interval));
+
+    state.SetItemsProcessed(state.iterations() * intervals.size());
+}
+
+// Full placeholder replacement, as done when a countdown message is rendered
+static void BM_ParseStringBatch(benchmark::State& state)
+{
+    auto timers = CreateTimers(state.range(0));
+
+    for (auto _ : state)
+        for (const auto& record : timers)
+            benchmark::DoNotOptimize(TimerController::Timer(record, nullptr, &CLOCK).parseString(record->getMessage()));
+
+    state.SetItemsProcessed(state.iterations() * timers.size());
+}
+
+// Per-timer work of TimerController::startTimer_NoRegister on startup: payload build and first delay, without the DPP timer
+static void BM_ScheduleBatch(benchmark::State& state)
+{
+    auto timers = CreateTimers(state.range(0));
+
+    std::vector<TimerPayload> payloads;
+    std::vector<int64_t> delays;
+
+    for (auto _ : state)
+    {
+        payloads.clear();
+        delays.clear();
+        payloads.reserve(timers.size());
+        delays.reserve(timers.size());
+
+        for (const auto& record : timers)
+        {
+            TimerController::Timer timer(record, nullptr, &CLOCK);
+            payloads.emplace_back(timer.buildMessage(), record->getEnd());
+            delays.push_back(timer.getSecondsToNextInterval());
+        }
+
+        benchmark::DoNotOptimize(delays.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * timers.size());
+}
+
+BENCHMARK(BM_ParseTimeBatch)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseIntervalBatch)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseStringBatch)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScheduleBatch)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "DAO/TimerDAO.h"
+#include "DAO/TimerSnapshot.h"
+
+/**
+ * @brief Run the DAO inside a scratch directory, the DAO writing to "data/timers" relative to the working directory.
+ *
+ */
+class ScratchDirectory
+{
+public:
+    ScratchDirectory()
+        : m_Previous(std::filesystem::current_path()),
+        m_Path(std::filesystem::temp_directory_path() / "BotBenchmarks")
+    {
+        std::filesystem::remove_all(m_Path);
+        std::filesystem::create_directories(m_Path / "data/timers");
+        std::filesystem::current_path(m_Path);
+    }
+
+    ~ScratchDirectory()
+    {
+        std::filesystem::current_path(m_Previous);
+        std::filesystem::remove_all(m_Path);
+    }
+
+private:
+    std::filesystem::path m_Previous;
+    std::filesystem::path m_Path;
+};
+
+static TimerDTO CreateTimer(size_t i)
+{
+    auto now = std::chrono::system_clock::now();
+
+    return TimerDTO("timer_" + std::to_string(i), dpp::snowflake(1234567890 + i), 60,
+        "Only {rem:days} days left before {end}!", now, now + std::chrono::hours(24 * 7),
+        "", "Timer {name}", dpp::snowflake(987654321 + i % 1000));
+}
+
+static void FillDAO(TimerDAO& dao, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        dao.add("timer_" + std::to_string(i), CreateTimer(i));
+}
+
+static void BM_DAOLoadTimers(benchmark::State& state)
+{
+    ScratchDirectory directory;
+    TimerDAO dao;
+    FillDAO(dao, state.range(0));
+
+    for (auto _ : state)
+    {
+        dao.loadTimers();
+        benchmark::DoNotOptimize(dao.getDataMap().size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// One add in a data directory already holding N timers, the delete being excluded from the timing
+static void BM_DAOAdd(benchmark::State& state)
+{
+    ScratchDirectory directory;
+    TimerDAO dao;
+    FillDAO(dao, state.range(0));
+
+    auto timer = CreateTimer(state.range(0));
+
+    for (auto _ : state)
+    {
+        dao.add(timer.getName(), timer);
+
+        state.PauseTiming();
+        dao.deleteByID(timer.getName());
+        state.ResumeTiming();
+    }
+}
+
+static void BM_DAOUpdate(benchmark::State& state)
+{
+    ScratchDirectory directory;
+    TimerDAO dao;
+    FillDAO(dao, state.range(0));
+
+    auto timer = CreateTimer(state.range(0) / 2);
+
+    for (auto _ : state)
+        dao.update(timer.getName(), timer);
+}
+
+// The snapshot published by each DAO mutation, without the file: only the nodes on the path to the timer are copied
+static void BM_DAOSnapshotSet(benchmark::State& state)
+{
+    TimerSnapshot::Builder builder;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+        builder.set("timer_" + std::to_string(i), std::make_shared<const TimerDTO>(CreateTimer(i)));
+
+    auto snapshot = builder.build(0);
+    auto timer = std::make_shared<const TimerDTO>(CreateTimer(state.range(0) / 2));
+
+    for (auto _ : state)
+    {
+        TimerSnapshot::Builder next(*snapshot);
+        next.set(timer->getName(), timer);
+        benchmark::DoNotOptimize(next.build(snapshot->getVersion() + 1));
+    }
+}
+
+static void BM_DAOSnapshotErase(benchmark::State& state)
+{
+    TimerSnapshot::Builder builder;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+        builder.set("timer_" + std::to_string(i), std::make_shared<const TimerDTO>(CreateTimer(i)));
+
+    auto snapshot = builder.build(0);
+    auto id = "timer_" + std::to_string(state.range(0) / 2);
+
+    for (auto _ : state)
+    {
+        TimerSnapshot::Builder next(*snapshot);
+        next.erase(id);
+        benchmark::DoNotOptimize(next.build(snapshot->getVersion() + 1));
+    }
+}
+
+// One file per timer: 1M timers exceed the inode budget of most scratch filesystems, so the disk-backed paths stop at 100k
+BENCHMARK(BM_DAOLoadTimers)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK(BM_DAOAdd)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DAOUpdate)->RangeMultiplier(10)->Range(1'000, 100'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DAOSnapshotSet)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DAOSnapshotErase)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "DTO/TimerDTO.h"
+
+static std::vector<TimerDTO> CreateTimers(size_t count)
+{
+    std::vector<TimerDTO> timers;
+    timers.reserve(count);
+
+    auto now = std::chrono::system_clock::now();
+
+    for (size_t i = 0; i < count; ++i)
+        timers.emplace_back("timer_" + std::to_string(i), dpp::snowflake(1234567890 + i), 60,
+            "Only {rem:days} days, {rem:hours} hours left before {end}! Don't forget to register before the deadline.",
+            now, now + std::chrono::hours(24 * 7), "https://example.com/images/countdown_banner.png",
+            "Countdown to the end of timer {name}", dpp::snowflake(987654321 + i % 1000));
+
+    return timers;
+}
+
+// Copy of every stored timer, as done by TimerDAO::findAll
+static void BM_TimerCopyBatch(benchmark::State& state)
+{
+    auto timers = CreateTimers(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::vector<TimerDTO> copies(timers.begin(), timers.end());
+        benchmark::DoNotOptimize(copies.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * timers.size());
+}
+
+// /timer update changing one field: the stored timer is copied, changed, then stored again
+static void BM_TimerUpdateBatch(benchmark::State& state)
+{
+    auto timers = CreateTimers(state.range(0));
+
+    for (auto _ : state)
+    {
+        for (auto& timer : timers)
+        {
+            TimerDTO updated = timer;
+            updated.setInterval(updated.getInterval() + 1);
+            timer = std::move(updated);
+        }
+
+        benchmark::DoNotOptimize(timers.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * timers.size());
+}
+
+BENCHMARK(BM_TimerCopyBatch)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimerUpdateBatch)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+#include "DAO/TimerNameIndex.h"
+
+static constexpr size_t TIMER_COUNT = 100'000;
+static constexpr size_t CHOICE_COUNT = 25;
+static constexpr dpp::snowflake GUILD = 1234567890;
+
+static TimerDAO::Snapshot_Type CreateTimers()
+{
+    TimerSnapshot::Builder timers;
+
+    for (size_t i = 0; i < TIMER_COUNT; ++i)
+    {
+        TimerDTO timer;
+        timer.setName("timer_" + std::to_string(i));
+        timer.setGuild(GUILD);
+        timers.set(timer.getName(), std::make_shared<const TimerDTO>(timer));
+    }
+
+    return timers.build(1);
+}
+
+// Without index: every autocomplete request walks the whole DAO map
+static void BM_AutocompleteScan(benchmark::State& state)
+{
+    auto timers = CreateTimers();
+
+    for (auto _ : state)
+    {
+        std::vector<std::string> names;
+
+        for (const auto& [name, timer] : *timers)
+        {
+            if (timer->getGuild() == GUILD && name.starts_with("timer_4242"))
+                names.push_back(name);
+        }
+
+        std::sort(names.begin(), names.end());
+        names.resize(std::min(names.size(), CHOICE_COUNT));
+        benchmark::DoNotOptimize(names);
+    }
+}
+
+static void BM_AutocompleteIndex(benchmark::State& state)
+{
+    TimerNameIndex index;
+    index.rebuild(*CreateTimers());
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(index.findByPrefix(GUILD, "timer_4242", CHOICE_COUNT));
+}
+
+// Incremental maintenance: one add and one delete in a guild of 100k timers
+static void BM_IndexAddRemove(benchmark::State& state)
+{
+    TimerNameIndex index;
+    index.rebuild(*CreateTimers());
+
+    for (auto _ : state)
+    {
+        index.add(GUILD, "timer_50000_new");
+        index.remove(GUILD, "timer_50000_new");
+    }
+}
+
+BENCHMARK(BM_AutocompleteScan)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AutocompleteIndex)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IndexAddRemove)->Unit(benchmark::kMicrosecond);
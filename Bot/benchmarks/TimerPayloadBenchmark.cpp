@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include "Controllers/TimerController.h"
+#include "Discord/TimerPayload.h"
+#include "MockMessageSink.h"
+
+static constexpr size_t TIMER_COUNT = 100'000;
+
+static std::vector<TimerDTO> CreateTimers(bool countdown)
+{
+    std::vector<TimerDTO> timers;
+    timers.reserve(TIMER_COUNT);
+
+    auto now = std::chrono::system_clock::now();
+
+    for (size_t i = 0; i < TIMER_COUNT; ++i)
+    {
+        TimerDTO timer;
+        timer.setName("timer_" + std::to_string(i));
+        timer.setChannel(dpp::snowflake(1234567890 + i));
+        timer.setInterval(60);
+        timer.setStart(now);
+        timer.setEnd(now + std::chrono::hours(24 * 7));
+        timer.setTitle("Timer {name}");
+        timer.setMessage(countdown
+            ? "Only {rem:days} days, {rem:hours} hours left before {end}!"
+            : "Don't forget to drink water, this reminder ends on {end}.");
+        timers.push_back(timer);
+    }
+
+    return timers;
+}
+
+// Previous fire path: the embed is rebuilt and serialized on every fire
+static void BM_FireRebuild(benchmark::State& state)
+{
+    auto timers = CreateTimers(state.range(0));
+    MockMessageSink sink;
+
+    for (auto _ : state)
+    {
+        for (const auto& dto : timers)
+        {
+            TimerController::Timer timer(dto);
+            dpp::embed embed;
+            embed.add_field(timer.parseString(dto.getTitle()), timer.parseString(dto.getMessage()));
+            sink.createMessage(dto.getChannel(), dpp::message(dto.getChannel(), embed).build_json());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * timers.size());
+    state.counters["bytes_sent"] = benchmark::Counter(sink.getByteCount(), benchmark::Counter::kIsRate);
+}
+
+static void BM_FirePayload(benchmark::State& state)
+{
+    auto timers = CreateTimers(state.range(0));
+    MockMessageSink sink;
+
+    std::vector<TimerPayload> payloads;
+    payloads.reserve(timers.size());
+    for (const auto& dto : timers)
+        payloads.emplace_back(TimerController::Timer(dto).buildMessage(), dto.getEnd());
+
+    std::string buffer;
+
+    for (auto _ : state)
+    {
+        auto now = std::chrono::system_clock::now();
+
+        for (size_t i = 0; i < timers.size(); ++i)
+            sink.createMessage(timers[i].getChannel(), payloads[i].render(buffer, now));
+    }
+
+    state.SetItemsProcessed(state.iterations() * timers.size());
+    state.counters["bytes_sent"] = benchmark::Counter(sink.getByteCount(), benchmark::Counter::kIsRate);
+}
+
+// Argument: 0 for static messages, 1 for countdown messages
+BENCHMARK(BM_FireRebuild)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FirePayload)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include "Tracing/Tracer.h"
+
+// Cost left in instrumented code when tracing is off
+static void BM_TraceSpanDisabled(benchmark::State& state)
+{
+    Tracer::SetEnabled(false);
+
+    for (auto _ : state)
+        TraceSpan span("benchmark");
+}
+
+static void BM_TraceSpanEnabled(benchmark::State& state)
+{
+    Tracer::SetEnabled(true);
+
+    for (auto _ : state)
+        TraceSpan span("benchmark");
+
+    Tracer::SetEnabled(false);
+    Tracer::Clear();
+}
+
+static void BM_ExportChromeTrace(benchmark::State& state)
+{
+    Tracer::Clear();
+
+    for (size_t i = 0; i < Tracer::EVENTS_PER_THREAD; ++i)
+        Tracer::Record("benchmark", int64_t(i) * 1000, 500);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Tracer::ExportChromeTrace());
+
+    Tracer::Clear();
+}
+
+BENCHMARK(BM_TraceSpanDisabled);
+BENCHMARK(BM_TraceSpanEnabled)->ThreadRange(1, 4);
+BENCHMARK(BM_ExportChromeTrace)->Unit(benchmark::kMillisecond);
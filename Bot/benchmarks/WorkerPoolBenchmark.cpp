@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "Controllers/CommandRouter.h"
+
+struct BurstParams
+{
+    std::string name;
+};
+
+static constexpr auto BURST = MakeCommandSchema<BurstParams>("burst", "Burst benchmark command",
+    CommandOption(&BurstParams::name, "name", "Timer name.")
+);
+
+static constexpr size_t BURST_SIZE = 64;
+static constexpr size_t TIMER_COUNT = 16;
+static constexpr auto HANDLER_WORK = std::chrono::microseconds(200);
+
+static dpp::slashcommand_t CreateEvent(size_t i)
+{
+    dpp::command_data_option option;
+    option.name = "name";
+    option.type = dpp::co_string;
+    option.value = "timer_" + std::to_string(i % TIMER_COUNT);
+
+    dpp::command_interaction interaction;
+    interaction.id = 1;
+    interaction.name = "burst";
+    interaction.options.push_back(option);
+
+    dpp::slashcommand_t event(nullptr, "");
+    event.command.data = interaction;
+    return event;
+}
+
+/**
+ * @brief Dispatch bursts of commands whose handler blocks for a while, like a DAO write.
+ * 
+ * Latency is the time from the start of the burst until the gateway thread is done with an event and
+ * free to process the next gateway event. Counters report its 50th and 99th percentiles.
+ */
+static void RunBurst(benchmark::State& state, WorkerPool* pool)
+{
+    CommandRouter router(pool);
+    router.addRoute(BURST, [](const CommandContext&, const BurstParams&) { std::this_thread::sleep_for(HANDLER_WORK); },
+        { .key = &BurstParams::name });
+
+    std::vector<dpp::slashcommand_t> events;
+    for (size_t i = 0; i < BURST_SIZE; ++i)
+        events.push_back(CreateEvent(i));
+
+    std::vector<double> latencies;
+
+    for (auto _ : state)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (const auto& event : events)
+        {
+            router.dispatch(event);
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        state.PauseTiming();
+        while (pool != nullptr && pool->getPendingCount() > 0)
+            std::this_thread::yield();
+        state.ResumeTiming();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_us"] = latencies[latencies.size() / 2];
+    state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+}
+
+// Previous behaviour: handlers run on the gateway thread, each event waits for all the previous ones
+static void BM_BurstInline(benchmark::State& state)
+{
+    RunBurst(state, nullptr);
+}
+
+static void BM_BurstPool(benchmark::State& state)
+{
+    WorkerPool pool(state.range(0), 1024);
+    RunBurst(state, &pool);
+}
+
+BENCHMARK(BM_BurstInline)->Iterations(20);
+// Argument: number of worker threads
+BENCHMARK(BM_BurstPool)->Arg(2)->Arg(4)->Arg(8)->Iterations(20);
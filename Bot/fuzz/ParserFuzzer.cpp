@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "Controllers/ControllerExceptions.h"
+#include "Time/TimeParser.h"
+
+// Stream based interval parser the from_chars one replaced. Both must agree on every input.
+static int64_t LegacyParseInterval(const std::string& interval)
+{
+    static std::map<std::string, int64_t, std::less<std::string>> multipliers = {
+        {"d", 60 * 60 * 24},
+        {"h", 60 * 60},
+        {"m", 60},
+        {"s", 1},
+    };
+
+    std::stringstream ss(interval);
+    int64_t total = 0;
+    auto nextPossible = multipliers.begin();
+
+    while (!ss.eof() && nextPossible != multipliers.end())
+    {
+        int64_t value;
+        std::string unit;
+
+        ss >> value >> unit;
+        
+        if (ss.fail())
+            throw ParsingException("Invalid interval format (could not parse value): " + interval);
+
+        auto it = multipliers.find(unit);
+
+        if (it == multipliers.end())
+            throw ParsingException("Invalid interval unit: " + unit);
+
+        if (it->second > nextPossible->second)
+            throw ParsingException("Invalid interval format (not in descending order): " + interval);
+
+        total += value * it->second;
+
+        nextPossible = it;
+        ++nextPossible;
+    }
+
+    if (!ss.eof())
+        throw ParsingException("Invalid interval format (too many units): " + interval);
+
+    return total;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    std::string input(reinterpret_cast<const char*>(data), size);
+
+    // Interval: same result or same error message. Overflowing values are undefined behaviour in the legacy parser.
+    std::string expected, actual;
+
+    try { actual = std::to_string(TimeParser::ParseInterval(input)); }
+    catch (const ParsingException& e) { actual = e.what(); }
+
+    if (!actual.starts_with("Invalid interval format (out of range)"))
+    {
+        try { expected = std::to_string(LegacyParseInterval(input)); }
+        catch (const ParsingException& e) { expected = e.what(); }
+
+        if (expected != actual)
+            std::abort();
+    }
+
+    // Time: any input either parses or throws ParsingException
+    try { TimeParser::ParseTime(input, TimeFormatter::LocateZone("UTC")); }
+    catch (const ParsingException&) {}
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Advisory exclusive lock on a file, shared with other processes of the machine.
+ * 
+ * The operating system releases the lock when the holding process exits, even if it crashes. The lock does not
+ * prevent reading nor writing the file, whose content is free, e.g. the id of the holding process.
+ */
+class FileLock
+{
+public:
+    /**
+     * @brief Open the lock file, creating it and its directories if needed. The lock is not acquired.
+     * 
+     * @param path The lock file.
+     * 
+     * @throw std::runtime_error if the file can not be opened.
+     */
+    explicit FileLock(const std::filesystem::path& path);
+
+    /**
+     * @brief Release the lock, if held.
+     * 
+     */
+    ~FileLock();
+
+    FileLock(const FileLock&) = delete;
+
+    FileLock& operator=(const FileLock&) = delete;
+
+    /**
+     * @brief Acquire the lock without waiting.
+     * 
+     * @return true if the lock is now held, false if another holder has it.
+     */
+    bool tryLock();
+
+    /**
+     * @brief Release the lock, if held.
+     * 
+     */
+    void unlock();
+
+    /**
+     * @brief Read the content of the file, whoever holds the lock.
+     * 
+     * @return std::string The content.
+     */
+    std::string read() const;
+
+    /**
+     * @brief Replace the content of the file.
+     * 
+     * @param content The content.
+     */
+    void write(std::string_view content);
+
+    inline bool isLocked() const { return m_Locked; }
+
+    inline const std::filesystem::path& getPath() const { return m_Path; }
+
+private:
+    std::filesystem::path m_Path;
+    intptr_t m_Handle;
+    bool m_Locked = false;
+};
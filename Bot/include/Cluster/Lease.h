@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Cluster/FileLock.h"
+#include "Time/Clock.h"
+
+/**
+ * @brief Exclusive ownership of a set of lock files, e.g. the shards of a process, kept alive by heartbeats.
+ * 
+ * The lease is acquired when every lock file is locked. The operating system releases the locks of a process
+ * that exits, so a standby acquires the lease as soon as its holder dies. A holder that is alive but stuck keeps
+ * its locks: once its heartbeat is older than the timeout, the lease can be taken over without the locks, and
+ * the stuck holder loses it at its next renewal.
+ */
+class Lease
+{
+public:
+    /**
+     * @param paths The lock files, all owned together.
+     * @param timeout How old the heartbeat of a holder must be for the lease to be taken over from it.
+     * @param clock The clock heartbeats are read from. nullptr for the system clock.
+     * 
+     * @throw std::runtime_error if a lock file can not be opened.
+     */
+    Lease(const std::vector<std::filesystem::path>& paths, std::chrono::milliseconds timeout, const IClock* clock = nullptr);
+
+    /**
+     * @brief Release the lease, if held.
+     * 
+     */
+    ~Lease();
+
+    Lease(const Lease&) = delete;
+
+    Lease& operator=(const Lease&) = delete;
+
+    /**
+     * @brief Acquire the lease without waiting, if every lock file is free or has a heartbeat older than the timeout.
+     * 
+     * @return true if the lease is now held.
+     */
+    bool tryAcquire();
+
+    /**
+     * @brief Write a new heartbeat. Must be called more often than the timeout.
+     * 
+     * @return true if the lease is still held, false if it was taken over and is now released.
+     */
+    bool renew();
+
+    /**
+     * @brief Release the lease, if held.
+     * 
+     */
+    void release();
+
+    inline bool isHeld() const { return m_Held; }
+
+    inline std::chrono::milliseconds getTimeout() const { return m_Timeout; }
+
+private:
+    struct Heartbeat
+    {
+        std::string owner;
+        IClock::TimePoint_Type time;
+    };
+
+private:
+    static Heartbeat ReadHeartbeat(const FileLock& lock);
+
+    void writeHeartbeats();
+
+private:
+    // Unique to this lease, even between leases of the same process
+    std::string m_Owner;
+    std::vector<std::unique_ptr<FileLock>> m_Locks;
+    std::chrono::milliseconds m_Timeout;
+    const IClock& m_Clock;
+    bool m_Held = false;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+/**
+ * @brief Partition of the gateway shards, the guilds and their stored data between the bot processes.
+ * 
+ * A guild belongs to the shard (guild_id >> 22) % shard count, as routed by Discord. Process clusterId of
+ * clusterCount owns the shards whose index modulo clusterCount is clusterId, as started by dpp::cluster.
+ * 
+ * A process with a single shard keeps the data of every guild in "data". With more shards, the data of each
+ * shard is stored in "data/shards/<shard>", so that each process only reads the shards it owns.
+ */
+class ShardMap
+{
+public:
+    /**
+     * @param shardCount The number of gateway shards of the whole bot.
+     * @param clusterId The index of this process, from 0.
+     * @param clusterCount The number of processes.
+     * 
+     * @throw std::invalid_argument if a count is 0, clusterId is not below clusterCount or there are fewer shards than processes.
+     */
+    ShardMap(uint32_t shardCount = 1, uint32_t clusterId = 0, uint32_t clusterCount = 1);
+
+    /**
+     * @brief Read the partition from the command line: --shards=<count> --cluster=<id> --clusters=<count>.
+     * Omitted options keep their default, a single process owning a single shard.
+     * 
+     * @param argc The argument count.
+     * @param argv The arguments.
+     * @return ShardMap The partition.
+     * 
+     * @throw std::invalid_argument if an option is unknown or invalid.
+     */
+    static ShardMap FromArguments(int argc, const char* const* argv);
+
+    /**
+     * @brief Get the shard Discord routes the events of a guild to. Direct messages, without guild, go to shard 0.
+     * 
+     * @param guild The guild.
+     * @param shardCount The number of shards.
+     * @return uint32_t The shard.
+     */
+    static inline uint32_t GetShard(const dpp::snowflake& guild, uint32_t shardCount) { return uint32_t((uint64_t(guild) >> 22) % shardCount); }
+
+    inline uint32_t getShard(const dpp::snowflake& guild) const { return GetShard(guild, m_ShardCount); }
+
+    inline bool ownsShard(uint32_t shard) const { return shard < m_ShardCount && shard % m_ClusterCount == m_ClusterId; }
+
+    inline bool ownsGuild(const dpp::snowflake& guild) const { return ownsShard(getShard(guild)); }
+
+    /**
+     * @brief Get the shards of this process, ascending.
+     */
+    std::vector<uint32_t> getOwnedShards() const;
+
+    /**
+     * @brief Whether the data is stored per shard.
+     */
+    inline bool isPartitioned() const { return m_ShardCount > 1; }
+
+    /**
+     * @brief Whether this process does the work done once for the whole bot, e.g. registering the commands.
+     */
+    inline bool isLeader() const { return m_ClusterId == 0; }
+
+    /**
+     * @brief Get the directory the data of a shard is stored in.
+     * 
+     * @param shard The shard.
+     * @return std::filesystem::path The directory.
+     */
+    std::filesystem::path getShardDirectory(uint32_t shard) const;
+
+    /**
+     * @brief Get the directory the data of a guild is stored in.
+     * 
+     * @param guild The guild.
+     * @return std::filesystem::path The directory.
+     */
+    inline std::filesystem::path getDirectory(const dpp::snowflake& guild) const { return getShardDirectory(getShard(guild)); }
+
+    /**
+     * @brief Record the shard count the data is partitioned with, or check that it matches the recorded one.
+     * Data partitioned with another shard count would be partly ignored.
+     * 
+     * @throw std::runtime_error if the data is partitioned with another shard count.
+     */
+    void checkLayout() const;
+
+    inline uint32_t getShardCount() const { return m_ShardCount; }
+
+    inline uint32_t getClusterId() const { return m_ClusterId; }
+
+    inline uint32_t getClusterCount() const { return m_ClusterCount; }
+
+    /**
+     * @brief Get the directory of the data of every guild, used with a single shard and migrated from when partitioning.
+     */
+    static std::filesystem::path GetDataDirectory();
+
+private:
+    uint32_t m_ShardCount;
+    uint32_t m_ClusterId;
+    uint32_t m_ClusterCount;
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Lock-free ring of variable size records in shared memory, with one producer process and one consumer process.
+ * 
+ * The producer creates the ring and the consumer opens it by name. Records are copied in and out, no lock is
+ * taken and neither side waits for the other: a full ring drops the record and raises the overflow flag, so that
+ * the consumer can resynchronize from elsewhere, e.g. the persisted state.
+ */
+class SharedRing
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = size_t(1) << 20;
+
+public:
+    /**
+     * @brief Create a ring, replacing any ring of the same name. The ring is closed and removed once destroyed.
+     * 
+     * @param name The name of the ring, shared with the consumer.
+     * @param capacity The capacity in bytes, a power of two. Each record uses 4 bytes more than its size, rounded up to 8.
+     * @return std::unique_ptr<SharedRing> The producer side of the ring.
+     * 
+     * @throw std::invalid_argument if the capacity is not a power of two of at least 64 bytes.
+     * @throw std::runtime_error if the shared memory can not be created.
+     */
+    static std::unique_ptr<SharedRing> Create(const std::string& name, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Open the ring created by another process.
+     * 
+     * @param name The name of the ring.
+     * @return std::unique_ptr<SharedRing> The consumer side of the ring, nullptr if the ring does not exist yet.
+     * 
+     * @throw std::runtime_error if the shared memory exists but is not a ring.
+     */
+    static std::unique_ptr<SharedRing> Open(const std::string& name);
+
+    /**
+     * @brief Unmap the ring. The creator also closes it and removes its name.
+     * 
+     */
+    ~SharedRing();
+
+    SharedRing(const SharedRing&) = delete;
+
+    SharedRing& operator=(const SharedRing&) = delete;
+
+    /**
+     * @brief Append a record. Producer only.
+     * 
+     * @param record The record.
+     * @return true if appended, false if the ring is full. The overflow flag is then raised.
+     * 
+     * @throw std::invalid_argument if the record uses more than half of the capacity.
+     */
+    bool tryPush(std::string_view record);
+
+    /**
+     * @brief Take the oldest record. Consumer only.
+     * 
+     * @param record Set to the record, its capacity is reused.
+     * @return true if a record was taken, false if the ring is empty.
+     */
+    bool tryPop(std::string& record);
+
+    /**
+     * @brief Check and clear the overflow flag. Consumer only.
+     * 
+     * @return true if records were dropped since the last call.
+     */
+    bool takeOverflow();
+
+    /**
+     * @brief Check if the creator destroyed the ring. The records left can still be taken.
+     * 
+     */
+    bool isClosed() const;
+
+    inline size_t getCapacity() const { return m_Capacity; }
+
+    inline const std::string& getName() const { return m_Name; }
+
+private:
+    SharedRing(const std::string& name, intptr_t handle, void* memory, size_t size, bool owner);
+
+    std::byte* getData() const;
+
+private:
+    std::string m_Name;
+    intptr_t m_Handle;
+    void* m_Memory;
+    size_t m_Size;
+    size_t m_Capacity;
+    bool m_Owner;
+    // Process id of the creator when this side mapped the ring
+    uint64_t m_Creator;
+};
@@ -1,18 +1,186 @@
 #pragma once
 
+#include <optional>
+#include <string>
 #include <string_view>
-#include <array>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
-struct CommandDescription
+#include <dpp/dpp.h>
+
+/*
+ * Declarative command schemas.
+ * 
+ * A schema describes a command (or a subcommand) and binds each of its options to a member of a parameter struct.
+ * The same constexpr schema builds the registration payload and fills the parameter struct in a single pass
+ * over the interaction options, so the registered options and the handler parameters cannot drift apart.
+ * 
+ * Members of type std::optional<T> are optional options, any other member is a required option.
+ */
+
+template <typename T>
+struct IsOptionalMember : std::false_type { using Value_Type = T; };
+
+template <typename T>
+struct IsOptionalMember<std::optional<T>> : std::true_type { using Value_Type = T; };
+
+template <typename T>
+constexpr dpp::command_option_type DefaultOptionType()
 {
-    constexpr CommandDescription(std::string_view name, std::string_view description)
-        : name(name), description(description) {}
+    if constexpr (std::is_same_v<T, std::string>)
+        return dpp::co_string;
+    else if constexpr (std::is_same_v<T, int64_t>)
+        return dpp::co_integer;
+    else if constexpr (std::is_same_v<T, bool>)
+        return dpp::co_boolean;
+    else if constexpr (std::is_same_v<T, double>)
+        return dpp::co_number;
+    else
+        static_assert(!std::is_same_v<T, T>, "Snowflake options need an explicit type (co_channel, co_user, co_role...)");
+}
 
+/**
+ * @brief Option of a command, bound to a member of the parameter struct.
+ * 
+ * @tparam Params The parameter struct.
+ * @tparam Member The member type, std::optional for optional options.
+ */
+template <typename Params, typename Member>
+struct CommandOption
+{
+    using Value_Type = typename IsOptionalMember<Member>::Value_Type;
+    static constexpr bool REQUIRED = !IsOptionalMember<Member>::value;
+
+    constexpr CommandOption(Member Params::* member, std::string_view name, std::string_view description, dpp::command_option_type type = DefaultOptionType<Value_Type>())
+        : member(member), name(name), description(description), type(type)
+    {}
+
+    Member Params::* member;
     std::string_view name;
     std::string_view description;
+    dpp::command_option_type type;
+    bool autocomplete = false;
+
+    /**
+     * @brief Get a copy of this option, for which Discord asks suggestions while the user types.
+     */
+    constexpr CommandOption withAutocomplete() const
+    {
+        CommandOption option = *this;
+        option.autocomplete = true;
+        return option;
+    }
+
+    dpp::command_option build() const
+    {
+        return dpp::command_option(type, std::string(name), std::string(description), REQUIRED).set_auto_complete(autocomplete);
+    }
+
+    /**
+     * @brief Store the value of an interaction option if it is this option.
+     * 
+     * @return true if the interaction option is this option, false otherwise.
+     */
+    bool bind(Params& params, const dpp::command_data_option& option) const
+    {
+        if (option.name != name)
+            return false;
+
+        if (const auto* value = std::get_if<Value_Type>(&option.value))
+            params.*member = *value;
+
+        return true;
+    }
+};
+
+/**
+ * @brief Schema of a command or subcommand taking options.
+ * 
+ * @tparam Params The parameter struct filled from the options.
+ * @tparam Options The CommandOption types.
+ */
+template <typename Params, typename... Options>
+struct CommandSchema
+{
+    using Params_Type = Params;
+
+    constexpr CommandSchema(std::string_view name, std::string_view description, Options... options)
+        : name(name), description(description), options(options...)
+    {}
+
+    std::string_view name;
+    std::string_view description;
+    std::tuple<Options...> options;
+
+    /**
+     * @brief Build the registration payload of a top level command.
+     */
+    dpp::slashcommand buildCommand(const dpp::snowflake& application) const
+    {
+        dpp::slashcommand command(std::string(name), std::string(description), application);
+        std::apply([&command](const auto&... option) { (command.add_option(option.build()), ...); }, options);
+        return command;
+    }
+
+    /**
+     * @brief Build the registration payload of a subcommand.
+     */
+    dpp::command_option buildSubcommand() const
+    {
+        dpp::command_option subcommand(dpp::co_sub_command, std::string(name), std::string(description));
+        std::apply([&subcommand](const auto&... option) { (subcommand.add_option(option.build()), ...); }, options);
+        return subcommand;
+    }
+
+    /**
+     * @brief Fill the parameter struct in one pass over the interaction options.
+     */
+    Params bind(const std::vector<dpp::command_data_option>& values) const
+    {
+        Params params{};
+
+        for (const auto& value : values)
+            std::apply([&params, &value](const auto&... option) { (option.bind(params, value) || ...); }, options);
+
+        return params;
+    }
+};
+
+/**
+ * @brief Make a command schema, the parameter struct being given explicitly.
+ */
+template <typename Params, typename... Options>
+constexpr CommandSchema<Params, Options...> MakeCommandSchema(std::string_view name, std::string_view description, Options... options)
+{
+    return CommandSchema<Params, Options...>(name, description, options...);
+}
+
+/**
+ * @brief Schema of a top level command made of subcommands.
+ * 
+ * @tparam Subcommands The CommandSchema types of the subcommands.
+ */
+template <typename... Subcommands>
+struct CommandGroupSchema
+{
+    constexpr CommandGroupSchema(std::string_view name, std::string_view description, Subcommands... subcommands)
+        : name(name), description(description), subcommands(subcommands...)
+    {}
+
+    std::string_view name;
+    std::string_view description;
+    std::tuple<Subcommands...> subcommands;
+
+    dpp::slashcommand buildCommand(const dpp::snowflake& application) const
+    {
+        dpp::slashcommand command(std::string(name), std::string(description), application);
+        std::apply([&command](const auto&... subcommand) { (command.add_option(subcommand.buildSubcommand()), ...); }, subcommands);
+        return command;
+    }
 };
 
-inline std::vector<CommandDescription> COMMANDS = {
-    CommandDescription{"ping", "Ping the bot"},
-    CommandDescription{"ping", "Ping the bot"},
-};
\ No newline at end of file
+/**
+ * @brief Parameter struct of commands without options.
+ */
+struct NoParams {};
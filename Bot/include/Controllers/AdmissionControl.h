@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+/**
+ * @brief Token-bucket admission control of slash commands, per user and per guild.
+ * 
+ * Buckets live in a fixed-size open-addressing table of 16-byte entries. A bucket idle long enough to be full
+ * again carries no information, so its slot is reused: the table only holds recently active users and guilds.
+ */
+class AdmissionControl
+{
+public:
+    using Clock_Type = std::chrono::steady_clock;
+
+    struct Limit
+    {
+        float rate;  // Tokens refilled per second
+        float burst; // Bucket capacity
+    };
+
+    struct Stats
+    {
+        uint64_t admitted;
+        uint64_t rejectedByUser;
+        uint64_t rejectedByGuild;
+    };
+
+public:
+    /**
+     * @param capacity The number of buckets in the table, rounded up to a power of two.
+     */
+    AdmissionControl(size_t capacity = 16384);
+
+    AdmissionControl(const AdmissionControl&) = delete;
+
+    AdmissionControl& operator=(const AdmissionControl&) = delete;
+
+    /**
+     * @brief Set the limits of the commands without specific limits.
+     * 
+     * @param perUser The limit of each user.
+     * @param perGuild The limit of each guild.
+     */
+    void setDefaultLimit(Limit perUser, Limit perGuild);
+
+    /**
+     * @brief Set the limits of a command.
+     * 
+     * @param command The command name.
+     * @param subcommand The subcommand name, empty for a command without subcommands.
+     * @param perUser The limit of each user.
+     * @param perGuild The limit of each guild.
+     * 
+     * @throw std::length_error if too many limits are set.
+     */
+    void setLimit(std::string_view command, std::string_view subcommand, Limit perUser, Limit perGuild);
+
+    /**
+     * @brief Take a token from the user bucket and from the guild bucket of a command.
+     * 
+     * Nothing is taken if either bucket is empty.
+     * 
+     * @param command The command name.
+     * @param subcommand The subcommand name.
+     * @param user The user id.
+     * @param guild The guild id, 0 outside guilds.
+     * @param now The current time.
+     * @return true if the command is admitted, false if it must be rejected.
+     */
+    bool admit(std::string_view command, std::string_view subcommand, const dpp::snowflake& user, const dpp::snowflake& guild,
+        Clock_Type::time_point now = Clock_Type::now());
+
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        uint64_t key = 0; // Limit index in the top byte, hashed id below. 0 for an empty slot
+        float tokens = 0;
+        uint32_t updated = 0; // Milliseconds since m_Epoch, wrapping after 49 days
+    };
+
+    struct CommandLimit
+    {
+        std::string command;
+        std::string subcommand;
+    };
+
+    // Probed slots before evicting the least recently updated one
+    static constexpr size_t PROBE_LENGTH = 8;
+
+    // Limit 0 and 1 are the default user and guild limits, command i has limits 2i + 2 and 2i + 3
+    static constexpr size_t MAX_LIMITS = 256;
+
+private:
+    size_t findLimits(std::string_view command, std::string_view subcommand) const;
+
+    /**
+     * @brief Find or create the bucket of an id, refilled up to now.
+     */
+    Entry& findBucket(size_t limit, uint64_t id, uint32_t now);
+
+    float refilled(const Entry& entry, uint32_t now) const;
+
+private:
+    std::vector<Entry> m_Entries;
+    std::vector<Limit> m_Limits;
+    std::vector<CommandLimit> m_CommandLimits;
+    Clock_Type::time_point m_Epoch;
+    std::mutex m_Mutex;
+
+    std::atomic<uint64_t> m_Admitted = 0;
+    std::atomic<uint64_t> m_RejectedByUser = 0;
+    std::atomic<uint64_t> m_RejectedByGuild = 0;
+};
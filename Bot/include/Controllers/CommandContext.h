@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+#include "Discord/InteractionResponder.h"
+
+/**
+ * @brief A slash command being handled. Owns a copy of the event, so it can outlive the gateway callback.
+ * 
+ * Once deferred, the interaction is acknowledged with a "thinking" response and replies edit that response.
+ */
+class CommandContext
+{
+public:
+    /**
+     * @param event The slash command event.
+     * @param responder The responder answering the interaction. nullptr to answer through the client the event came from.
+     */
+    CommandContext(const dpp::slashcommand_t& event, IInteractionResponder* responder = nullptr);
+
+    /**
+     * @brief Acknowledge the interaction with an ephemeral "thinking" response. Later replies edit it.
+     * 
+     */
+    void defer();
+
+    inline bool isDeferred() const { return m_Acknowledgement != nullptr; }
+
+    inline const dpp::slashcommand_t& getEvent() const { return m_Event; }
+
+    inline const dpp::interaction& getInteraction() const { return m_Event.command; }
+
+    /**
+     * @brief Reply to the interaction, or edit the "thinking" response if deferred.
+     * 
+     * @param message The reply.
+     * @param callback Called with the result of the request.
+     */
+    void reply(const dpp::message& message, dpp::command_completion_event_t callback = {}) const;
+
+    /**
+     * @brief Reply to the interaction, or edit the "thinking" response if deferred.
+     * 
+     * @param message The reply.
+     * @return dpp::async<dpp::confirmation_callback_t> Resolved with the result of the request.
+     */
+    dpp::async<dpp::confirmation_callback_t> co_reply(const dpp::message& message) const;
+
+private:
+    struct Acknowledgement
+    {
+        std::mutex mutex;
+        bool done = false;
+        std::vector<std::function<void()>> pending;
+    };
+
+private:
+    /**
+     * @brief Run an action once Discord processed the "thinking" response.
+     * 
+     * @param action The action.
+     */
+    void whenAcknowledged(std::function<void()> action) const;
+
+private:
+    dpp::slashcommand_t m_Event;
+    IInteractionResponder* m_Responder;
+    std::shared_ptr<Acknowledgement> m_Acknowledgement;
+};
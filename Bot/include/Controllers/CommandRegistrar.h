@@ -0,0 +1,67 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+#include "Controllers/CommandRouter.h"
+#include "Discord/CommandPublisher.h"
+
+/**
+ * @brief Registers the application commands only when their schema changed.
+ * 
+ * The hash of the canonical JSON of all commands is persisted with the command ids. On startup, if the hash
+ * is unchanged, the persisted ids are bound in the router and no request is made. Otherwise every command
+ * is pushed with a single bulk overwrite, so commands never disappear for users.
+ */
+class CommandRegistrar
+{
+public:
+    /**
+     * @param publisher The publisher used when the schema changed.
+     * @param statePath The file the hash and command ids are persisted to.
+     */
+    CommandRegistrar(ICommandPublisher& publisher, const std::filesystem::path& statePath = "data/commands.txt");
+
+    /**
+     * @brief Register the commands if needed and bind their ids in the router.
+     * 
+     * @param commands All the commands of the application.
+     * @param router The router to bind the command ids in. Must outlive the registration request.
+     * @param onRegistered Called once the command ids are bound, right away if the registration was up to date. Not called on failure. May be empty.
+     * @return true if the commands were pushed, false if the persisted registration was up to date.
+     */
+    bool registerCommands(const std::vector<dpp::slashcommand>& commands, CommandRouter& router, std::function<void()> onRegistered = nullptr);
+
+    /**
+     * @brief Bind the persisted command ids in the router, without registering, e.g. in processes sharing the
+     * registration of another one.
+     * 
+     * @param commands All the commands of the application.
+     * @param router The router to bind the command ids in.
+     * @return true if the persisted registration was up to date and its ids bound, false if nothing was bound.
+     */
+    bool bindRegistered(const std::vector<dpp::slashcommand>& commands, CommandRouter& router) const;
+
+    /**
+     * @brief Compute the hash of a command schema. Independent of command order, stable across builds.
+     * 
+     * @param commands The commands.
+     * @return uint64_t The hash.
+     */
+    static uint64_t HashCommands(const std::vector<dpp::slashcommand>& commands);
+
+private:
+    struct State
+    {
+        uint64_t hash = 0;
+        ICommandPublisher::CommandIds_Type ids;
+    };
+
+    State loadState() const;
+    void saveState(const State& state) const;
+
+private:
+    ICommandPublisher& m_Publisher;
+    std::filesystem::path m_StatePath;
+};
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+#include "Commands.h"
+#include "Controllers/CommandContext.h"
+#include "Discord/InteractionResponder.h"
+#include "Metrics/MetricsRegistry.h"
+#include "Threading/WorkerPool.h"
+
+/**
+ * @brief A handler of a schema route, called with the command context and the bound parameters.
+ */
+template <typename Handler, typename Params>
+concept CommandHandler = std::invocable<Handler, const CommandContext&, const Params&>;
+
+/**
+ * @brief A handler of a schema route written as a coroutine. It may co_await REST calls without holding a thread.
+ */
+template <typename Handler, typename Params>
+concept CoroutineCommandHandler = CommandHandler<Handler, Params>
+    && std::same_as<std::invoke_result_t<Handler, const CommandContext&, const Params&>, dpp::task<void>>;
+
+/**
+ * @brief How the handler of a route is executed.
+ * 
+ * @tparam Params The parameter struct of the route.
+ */
+template <typename Params>
+struct RouteOptions
+{
+    // Acknowledge with a "thinking" response before running the handler, for handlers that may run long
+    bool deferred = false;
+    // Parameter whose value serializes the handler runs, e.g. the timer name. nullptr for no ordering
+    std::string Params::* key = nullptr;
+};
+
+/**
+ * @brief Routing table from (command, subcommand) to handlers.
+ * 
+ * Controllers register their handlers once. When Discord returns the id of a registered command, routes
+ * are keyed by that id, so dispatching is a single hash lookup whatever the number of routes.
+ * 
+ * With a worker pool, handlers of schema routes run on the pool and dispatching returns as soon as the
+ * parameters are bound, leaving the gateway thread free. Coroutine handlers release their worker each time
+ * they suspend, so a few threads serve many interactions waiting on Discord.
+ * 
+ * With a metrics registry, the time from dispatch to the end of each schema route handler is recorded
+ * per route.
+ */
+class CommandRouter
+{
+public:
+    using Handler_Type = std::function<void(const dpp::slashcommand_t&)>;
+    using AutocompleteHandler_Type = std::function<std::vector<std::string>(const dpp::interaction& interaction, std::string_view prefix)>;
+    using Guard_Type = std::function<bool(const dpp::interaction& interaction, std::string_view command, std::string_view subcommand)>;
+
+    // Discord shows at most 25 suggestions
+    static constexpr size_t MAX_AUTOCOMPLETE_CHOICES = 25;
+
+public:
+    /**
+     * @param pool The pool handlers run on. nullptr to run them on the dispatching thread.
+     * @param metrics The registry handler latencies are recorded to. nullptr to record nothing.
+     * @param responder The responder answering interactions, e.g. a simulated REST API. nullptr to answer through the client each event came from.
+     */
+    CommandRouter(WorkerPool* pool = nullptr, MetricsRegistry* metrics = nullptr, IInteractionResponder* responder = nullptr);
+
+    CommandRouter(const CommandRouter&) = delete;
+
+    CommandRouter& operator=(const CommandRouter&) = delete;
+
+    /**
+     * @brief Register the handler of a subcommand.
+     * 
+     * @param command The command name.
+     * @param subcommand The subcommand name, empty for a command without subcommands.
+     * @param handler The handler.
+     * 
+     * @throw std::invalid_argument if the route is already registered.
+     */
+    void addRoute(std::string_view command, std::string_view subcommand, Handler_Type handler);
+
+    /**
+     * @brief Register the handler of a command without subcommands.
+     * 
+     * @param command The command name.
+     * @param handler The handler.
+     * 
+     * @throw std::invalid_argument if the route is already registered.
+     */
+    void addRoute(std::string_view command, Handler_Type handler);
+
+    /**
+     * @brief Register the handler of a subcommand described by a schema. The handler receives the bound parameters.
+     * 
+     * @param command The command name.
+     * @param subcommand The subcommand schema.
+     * @param handler The handler, called with the command context and the parameter struct.
+     * @param options How the handler is executed.
+     * 
+     * @throw std::invalid_argument if the route is already registered.
+     */
+    template <typename Params, typename... Options, typename Handler>
+        requires CommandHandler<Handler, Params>
+    void addRoute(std::string_view command, const CommandSchema<Params, Options...>& subcommand, Handler handler, RouteOptions<Params> options = {})
+    {
+        Histogram* latency = getLatencyHistogram(command, subcommand.name);
+
+        addRoute(command, subcommand.name, [this, subcommand, handler = std::move(handler), options, latency](const dpp::slashcommand_t& event) {
+            execute(event, subcommand.bind(GetOptions(event, true)), handler, options, latency);
+        });
+    }
+
+    /**
+     * @brief Register the handler of a command without subcommands described by a schema.
+     * 
+     * @param command The command schema.
+     * @param handler The handler, called with the command context and the parameter struct.
+     * @param options How the handler is executed.
+     * 
+     * @throw std::invalid_argument if the route is already registered.
+     */
+    template <typename Params, typename... Options, typename Handler>
+        requires CommandHandler<Handler, Params>
+    void addRoute(const CommandSchema<Params, Options...>& command, Handler handler, RouteOptions<Params> options = {})
+    {
+        Histogram* latency = getLatencyHistogram(command.name, "");
+
+        addRoute(command.name, "", [this, command, handler = std::move(handler), options, latency](const dpp::slashcommand_t& event) {
+            execute(event, command.bind(GetOptions(event, false)), handler, options, latency);
+        });
+    }
+
+    /**
+     * @brief Register the suggestion provider of an autocomplete option.
+     * 
+     * @param command The command name.
+     * @param subcommand The subcommand name, empty for a command without subcommands.
+     * @param option The option name.
+     * @param handler The provider, called with the interaction and what the user typed so far. Runs on the gateway thread.
+     * 
+     * @throw std::invalid_argument if a provider is already registered for the option.
+     */
+    void addAutocomplete(std::string_view command, std::string_view subcommand, std::string_view option, AutocompleteHandler_Type handler);
+
+    /**
+     * @brief Set the guard of the routes of a command, called before each handler.
+     * 
+     * A rejected interaction gets a short ephemeral reply, without running the handler.
+     * 
+     * @param command The command name.
+     * @param guard The guard, returning false to reject the interaction. Runs on the gateway thread.
+     */
+    void setGuard(std::string_view command, Guard_Type guard);
+
+    /**
+     * @brief Key the routes of a command by the id Discord gave it at registration.
+     * 
+     * @param command The command name.
+     * @param id The command id.
+     */
+    void bindCommandId(std::string_view command, const dpp::snowflake& id);
+
+    /**
+     * @brief Call the handler of a slash command.
+     * 
+     * @param event The slash command event.
+     * @return true if a handler was found, false otherwise.
+     */
+    bool dispatch(const dpp::slashcommand_t& event) const;
+
+    /**
+     * @brief Answer an autocomplete request with the suggestions of the focused option.
+     * 
+     * @param event The autocomplete event.
+     * @return true if a provider was found, false otherwise.
+     */
+    bool dispatchAutocomplete(const dpp::autocomplete_t& event) const;
+
+    /**
+     * @brief Get the names of the commands having at least one route.
+     * 
+     * @return std::vector<std::string> The command names.
+     */
+    std::vector<std::string> getCommandNames() const;
+
+private:
+    struct Route
+    {
+        std::string command;
+        std::string subcommand;
+        Handler_Type handler;
+        Guard_Type guard;
+    };
+
+    template <typename Key>
+    struct RouteKey
+    {
+        Key command;
+        std::string_view subcommand;
+
+        bool operator==(const RouteKey&) const = default;
+    };
+
+    template <typename Key>
+    struct RouteKeyHash
+    {
+        size_t operator()(const RouteKey<Key>& key) const
+        {
+            return std::hash<Key>{}(key.command) * 31 ^ std::hash<std::string_view>{}(key.subcommand);
+        }
+    };
+
+    using IdKey_Type = RouteKey<uint64_t>;
+    using NameKey_Type = RouteKey<std::string_view>;
+
+private:
+    const Route* findRoute(const dpp::slashcommand_t& event) const;
+
+    /**
+     * @brief Get the latency histogram of a route.
+     * 
+     * @return Histogram* The histogram, nullptr without metrics registry.
+     */
+    Histogram* getLatencyHistogram(std::string_view command, std::string_view subcommand);
+
+    template <typename Params, typename Handler>
+    void execute(const dpp::slashcommand_t& event, Params params, const Handler& handler, const RouteOptions<Params>& options, Histogram* latency) const
+    {
+        std::string key = options.key == nullptr ? std::string() : params.*options.key;
+
+        if constexpr (CoroutineCommandHandler<Handler, Params>)
+        {
+            CommandContext context(event, m_Responder);
+
+            if (options.deferred && m_Pool != nullptr)
+                context.defer();
+
+            RunCoroutine(std::move(context), std::move(params), handler, m_Pool, std::move(key), latency);
+        }
+        else
+        {
+            execute(event, options.deferred, std::move(key), latency, [handler, params = std::move(params)](const CommandContext& context) {
+                handler(context, params);
+            });
+        }
+    }
+
+    /**
+     * @brief Run a coroutine handler, hopping onto the worker pool if any. A job is detached, nothing awaits it.
+     * 
+     * The hop is requested before the first suspension, so handlers of a key start in dispatch order.
+     * The context and parameters live in this frame while the handler runs, the handler can take them by reference.
+     */
+    template <typename Params, typename Handler>
+    static dpp::job RunCoroutine(CommandContext context, Params params, Handler handler, WorkerPool* pool, std::string key, Histogram* latency)
+    {
+        using namespace std::string_literals;
+
+        ScopedLatency timing(latency);
+        std::string error;
+
+        try
+        {
+            if (pool != nullptr && key.empty())
+                co_await pool->schedule();
+            else if (pool != nullptr)
+                co_await pool->schedule(std::move(key));
+
+            co_await handler(context, params);
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+
+        if (!error.empty())
+            context.reply(dpp::message("Error: "s + error).set_flags(dpp::m_ephemeral));
+    }
+
+    /**
+     * @brief Run a bound handler, on the worker pool if any.
+     * 
+     * @param event The slash command event.
+     * @param deferred true to acknowledge the interaction before running the handler on the pool.
+     * @param key The serialization key, empty for none.
+     * @param latency The histogram the handler latency is recorded to, nullptr for none.
+     * @param handler The handler with its parameters bound.
+     */
+    void execute(const dpp::slashcommand_t& event, bool deferred, std::string key, Histogram* latency, std::function<void(const CommandContext&)> handler) const;
+
+    /**
+     * @brief Get the options of an interaction, without copying them.
+     * 
+     * @param event The slash command event.
+     * @param subcommand true to get the options of the subcommand, false for the options of the command.
+     * @return const std::vector<dpp::command_data_option>& The options.
+     */
+    static const std::vector<dpp::command_data_option>& GetOptions(const dpp::slashcommand_t& event, bool subcommand);
+
+private:
+    std::vector<std::unique_ptr<Route>> m_Routes;
+    std::unordered_map<IdKey_Type, const Route*, RouteKeyHash<uint64_t>> m_RoutesById;
+    std::unordered_map<NameKey_Type, const Route*, RouteKeyHash<std::string_view>> m_RoutesByName;
+    // Keyed by "command subcommand option"
+    std::unordered_map<std::string, AutocompleteHandler_Type> m_Autocompletes;
+    mutable std::shared_mutex m_Mutex;
+    WorkerPool* m_Pool;
+    MetricsRegistry* m_Metrics;
+    IInteractionResponder* m_Responder;
+};
@@ -2,10 +2,19 @@
 
 #include <dpp/dpp.h>
 
+#include "Controllers/AdmissionControl.h"
+#include "Controllers/CommandRouter.h"
+#include "Metrics/MetricsRegistry.h"
+#include "Metrics/StartupProfile.h"
+
 class Controller
 {
 public:
-    Controller(dpp::cluster& bot);
+    /**
+     * @param bot The cluster.
+     * @param metrics The registry the controller records to. nullptr to record nothing.
+     */
+    Controller(dpp::cluster& bot, MetricsRegistry* metrics = nullptr);
 
     virtual ~Controller();
 
@@ -17,70 +26,60 @@ public:
 
     Controller& operator=(Controller&&) = default;
 
-    void init();
+    /**
+     * @brief Initialize the controller, e.g. load its persisted state.
+     * 
+     * @param profile The profile the initialization phases are recorded to. nullptr to record nothing.
+     */
+    void init(StartupProfile* profile = nullptr);
+
+    /**
+     * @brief Initialize controllers in parallel, each on its own thread, and wait for all of them.
+     * 
+     * @param controllers The controllers. Their initializations must be independent.
+     * @param profile The profile the initialization phases are recorded to. nullptr to record nothing.
+     * 
+     * @throw The first exception thrown by an initialization, once all of them ended.
+     */
+    static void InitAll(const std::vector<std::unique_ptr<Controller>>& controllers, StartupProfile* profile = nullptr);
+
+    /**
+     * @brief Get the slash commands of the controller, to be registered.
+     * 
+     * @return std::vector<dpp::slashcommand> The commands.
+     */
+    std::vector<dpp::slashcommand> getCommands() const;
+
+    /**
+     * @brief Register the handlers of the controller commands, guarded by the controller admission control.
+     * The admission statistics are exported to the metrics registry, if any.
+     * 
+     * @param router The router to register to.
+     */
+    void registerRoutes(CommandRouter& router);
+
+    /**
+     * @brief Get the admission statistics of the controller commands.
+     * 
+     * @return AdmissionControl::Stats The statistics.
+     */
+    inline AdmissionControl::Stats getAdmissionStats() const { return m_Admission.getStats(); }
 
-    void createCommands() const;
+protected:
 
-    bool handleSlashCommand(const dpp::slashcommand_t& event);
+    /**
+     * @param profile The profile the initialization phases are recorded to. May be nullptr.
+     */
+    virtual void onInit(StartupProfile* profile) = 0;
 
-protected:
+    virtual std::vector<dpp::slashcommand> onCreateCommands() const = 0;
 
-    virtual void onInit() = 0;
-
-    virtual void onCreateCommands() const = 0;
-
-    virtual bool onSlashCommand(const dpp::slashcommand_t& event) = 0;
-
-    bool isParamDefined(const dpp::slashcommand_t& event, const std::string& name) const
-    {
-        return !std::holds_alternative<std::monostate>(event.get_parameter(name));
-    }
-
-    template <typename T>
-    T getParam(const dpp::slashcommand_t& event, const std::string& name) const
-    {
-        return std::get<T>(event.get_parameter(name));
-    }
-
-    template <typename T>
-    T getParamOr(const dpp::slashcommand_t& event, const std::string& name, const T& defaultValue) const
-    {
-        T value;
-
-        std::visit(
-            [&value, &defaultValue](auto&& arg) {
-                using Arg = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, Arg>)
-                    value = arg;
-                else
-                    value = defaultValue;
-            },
-            event.get_parameter(name)
-        );
-
-        return value;
-    }
-
-    template <typename C>
-    std::invoke_result_t<C> getParamOrCall(const dpp::slashcommand_t& event, const std::string& name, const C& function) const
-    {
-        using T = std::invoke_result_t<C>;
-        T value;
-
-        std::visit(
-            [&value, &function](auto&& arg) {
-                using Arg = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, Arg>)
-                    value = arg;
-                else
-                    value = function();
-            },
-            event.get_parameter(name)
-        );
-
-        return value;
-    }
+    virtual void onRegisterRoutes(CommandRouter& router) = 0;
 
 protected:
     dpp::cluster& m_Bot;
+    MetricsRegistry* m_Metrics;
+
+    // Token buckets per user and guild. Controllers set the limits of their commands in their constructor
+    AdmissionControl m_Admission;
 };
\ No newline at end of file
@@ -10,9 +10,9 @@ public:
     ~PingController();
 
 protected:
-    void onInit() override;
+    void onInit(StartupProfile* profile) override;
 
-    void onCreateCommands() const override;
+    std::vector<dpp::slashcommand> onCreateCommands() const override;
 
-    bool onSlashCommand(const dpp::slashcommand_t& event) override;
+    void onRegisterRoutes(CommandRouter& router) override;
 };
\ No newline at end of file
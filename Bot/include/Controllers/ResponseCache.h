@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <dpp/dpp.h>
+
+/**
+ * @brief Per-guild cache of rendered command responses, valid for one version of the data they render.
+ * 
+ * The version combines everything the response depends on, e.g. the DAO mutation version and the guild
+ * settings. A lookup with another version misses, so invalidation is exact without any explicit call.
+ */
+class ResponseCache
+{
+public:
+    // Shared with the cache, a hit does not copy the response
+    using Response_Type = std::shared_ptr<const std::string>;
+
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+public:
+    ResponseCache() = default;
+
+    ResponseCache(const ResponseCache&) = delete;
+
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /**
+     * @brief Get the cached response of a guild.
+     * 
+     * @param guild The guild.
+     * @param version The version of the data the response must render.
+     * @return Response_Type The response, nullptr if absent or rendered from another version.
+     */
+    Response_Type find(const dpp::snowflake& guild, uint64_t version) const;
+
+    /**
+     * @brief Cache the response of a guild.
+     * 
+     * @param guild The guild.
+     * @param version The version of the data the response was rendered from.
+     * @param response The response.
+     */
+    void store(const dpp::snowflake& guild, uint64_t version, Response_Type response);
+
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        uint64_t version;
+        Response_Type response;
+    };
+
+private:
+    std::unordered_map<dpp::snowflake, Entry> m_Entries;
+    mutable std::mutex m_Mutex;
+
+    mutable std::atomic<uint64_t> m_Hits = 0;
+    mutable std::atomic<uint64_t> m_Misses = 0;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Controllers/Controller.h"
+#include "Metrics/MetricsRegistry.h"
+
+/**
+ * @brief Admin commands showing the metrics of the bot and recording traces.
+ * 
+ */
+class StatsController final : public Controller
+{
+public:
+    /**
+     * @param bot The cluster.
+     * @param metrics The metrics shown.
+     */
+    StatsController(dpp::cluster& bot, MetricsRegistry& metrics);
+
+    ~StatsController();
+
+protected:
+    void onInit(StartupProfile* profile) override;
+
+    std::vector<dpp::slashcommand> onCreateCommands() const override;
+
+    void onRegisterRoutes(CommandRouter& router) override;
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "Commands.h"
+
+struct TimerSetParams
+{
+    std::string name;
+    std::string interval;
+    std::string message;
+    std::string end;
+    std::optional<std::string> title;
+    std::optional<std::string> start;
+    std::optional<dpp::snowflake> channel;
+    std::optional<std::string> image;
+    std::optional<bool> edit;
+};
+
+struct TimerStopParams
+{
+    std::string name;
+};
+
+struct TimerTriggerParams
+{
+    std::string name;
+    std::optional<dpp::snowflake> channel;
+};
+
+struct TimerUpdateParams
+{
+    std::string name;
+    std::optional<std::string> interval;
+    std::optional<std::string> message;
+    std::optional<std::string> start;
+    std::optional<std::string> end;
+    std::optional<std::string> title;
+    std::optional<dpp::snowflake> channel;
+    std::optional<std::string> image;
+    std::optional<bool> edit;
+};
+
+struct TimerTimezoneParams
+{
+    std::optional<std::string> zone;
+};
+
+// Shared by the bulk subcommands, each binding the options it takes
+struct TimerBulkParams
+{
+    // Selection, timers must match every option given
+    std::optional<dpp::snowflake> channel;
+    std::optional<std::string> prefix;
+    std::optional<std::string> ends_after;
+    std::optional<std::string> ends_before;
+    // Retarget
+    dpp::snowflake to;
+    // Shift
+    std::string by;
+    std::optional<bool> earlier;
+};
+
+namespace TimerCommands
+{
+
+inline constexpr auto SET = MakeCommandSchema<TimerSetParams>("set", "Set a timer",
+    CommandOption(&TimerSetParams::name, "name", "Timer name. Must be unique."),
+    CommandOption(&TimerSetParams::interval, "interval", "Interval between each message in format \"0d 0h 0m 0s\". Example: \"1d 2h 3m 4s\"."),
+    CommandOption(&TimerSetParams::message, "message", "Message to send."),
+    CommandOption(&TimerSetParams::end, "end", "End time of the timer in dd/mm/yy hh:mm:ss format."),
+    CommandOption(&TimerSetParams::title, "title", "Title of the timer."),
+    CommandOption(&TimerSetParams::start, "start", "Start time of the timer in dd/mm/yy hh:mm:ss format. Default: now."),
+    CommandOption(&TimerSetParams::channel, "channel", "Channel to send the message to. Default: this channel.", dpp::co_channel),
+    CommandOption(&TimerSetParams::image, "image", "Image to send with the message."),
+    CommandOption(&TimerSetParams::edit, "edit", "Edit a single message on each fire instead of posting a new one. Default: false.")
+);
+
+inline constexpr auto LIST = MakeCommandSchema<NoParams>("list", "List running timers.");
+
+inline constexpr auto STOP = MakeCommandSchema<TimerStopParams>("stop", "Stop a running timer.",
+    CommandOption(&TimerStopParams::name, "name", "Name of the timer to stop.").withAutocomplete()
+);
+
+inline constexpr auto TRIGGER = MakeCommandSchema<TimerTriggerParams>("trigger", "Trigger a timer.",
+    CommandOption(&TimerTriggerParams::name, "name", "Name of the timer to trigger.").withAutocomplete(),
+    CommandOption(&TimerTriggerParams::channel, "channel", "Channel to send the message to. Default: set timer channel.", dpp::co_channel)
+);
+
+inline constexpr auto UPDATE = MakeCommandSchema<TimerUpdateParams>("update", "Update a timer.",
+    CommandOption(&TimerUpdateParams::name, "name", "Name of the timer to update.").withAutocomplete(),
+    CommandOption(&TimerUpdateParams::interval, "interval", "Interval between each message in format \"0d 0h 0m 0s\". Example: \"1d 2h 3m 4s\"."),
+    CommandOption(&TimerUpdateParams::message, "message", "Message to send."),
+    CommandOption(&TimerUpdateParams::start, "start", "Start time of the timer in dd/mm/yy hh:mm:ss format. Default: now."),
+    CommandOption(&TimerUpdateParams::end, "end", "End time of the timer in dd/mm/yy hh:mm:ss format."),
+    CommandOption(&TimerUpdateParams::title, "title", "Title of the timer."),
+    CommandOption(&TimerUpdateParams::channel, "channel", "Channel to send the message to. Default: set timer channel.", dpp::co_channel),
+    CommandOption(&TimerUpdateParams::image, "image", "Image to send with the message."),
+    CommandOption(&TimerUpdateParams::edit, "edit", "Edit a single message on each fire instead of posting a new one.")
+);
+
+inline constexpr auto TIMEZONE = MakeCommandSchema<TimerTimezoneParams>("timezone", "Show or set the time zone of this server.",
+    CommandOption(&TimerTimezoneParams::zone, "zone", "Time zone name, e.g. \"Europe/Paris\". Default: show the current zone.")
+);
+
+inline constexpr auto TIMER = CommandGroupSchema("timer", "Timer commands", LIST, SET, UPDATE, TRIGGER, STOP, TIMEZONE);
+
+inline constexpr auto BULK_CHANNEL = CommandOption(&TimerBulkParams::channel, "channel", "Only the timers sending to this channel.", dpp::co_channel);
+inline constexpr auto BULK_PREFIX = CommandOption(&TimerBulkParams::prefix, "prefix", "Only the timers whose name starts with this prefix.");
+inline constexpr auto BULK_ENDS_AFTER = CommandOption(&TimerBulkParams::ends_after, "ends_after", "Only the timers ending after this time, in dd/mm/yy hh:mm:ss format.");
+inline constexpr auto BULK_ENDS_BEFORE = CommandOption(&TimerBulkParams::ends_before, "ends_before", "Only the timers ending before this time, in dd/mm/yy hh:mm:ss format.");
+
+inline constexpr auto BULK_STOP = MakeCommandSchema<TimerBulkParams>("stop", "Stop the selected timers.",
+    BULK_CHANNEL, BULK_PREFIX, BULK_ENDS_AFTER, BULK_ENDS_BEFORE
+);
+
+inline constexpr auto BULK_PAUSE = MakeCommandSchema<TimerBulkParams>("pause", "Pause the selected timers, keeping them stored.",
+    BULK_CHANNEL, BULK_PREFIX, BULK_ENDS_AFTER, BULK_ENDS_BEFORE
+);
+
+inline constexpr auto BULK_RESUME = MakeCommandSchema<TimerBulkParams>("resume", "Resume the selected paused timers.",
+    BULK_CHANNEL, BULK_PREFIX, BULK_ENDS_AFTER, BULK_ENDS_BEFORE
+);
+
+// Required options come first, Discord rejects them after optional ones
+inline constexpr auto BULK_RETARGET = MakeCommandSchema<TimerBulkParams>("retarget", "Send the selected timers to another channel.",
+    CommandOption(&TimerBulkParams::to, "to", "Channel to send the messages to.", dpp::co_channel),
+    BULK_CHANNEL, BULK_PREFIX, BULK_ENDS_AFTER, BULK_ENDS_BEFORE
+);
+
+inline constexpr auto BULK_SHIFT = MakeCommandSchema<TimerBulkParams>("shift", "Move the start and end of the selected timers.",
+    CommandOption(&TimerBulkParams::by, "by", "Offset in format \"0d 0h 0m 0s\". Example: \"1h 30m\"."),
+    CommandOption(&TimerBulkParams::earlier, "earlier", "Move the timers earlier instead of later. Default: false."),
+    BULK_CHANNEL, BULK_PREFIX, BULK_ENDS_AFTER, BULK_ENDS_BEFORE
+);
+
+inline constexpr auto TIMERS = CommandGroupSchema("timers", "Commands on several timers at once", BULK_STOP, BULK_PAUSE, BULK_RESUME, BULK_RETARGET, BULK_SHIFT);
+
+} // namespace TimerCommands
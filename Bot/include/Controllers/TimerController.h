@@ -1,21 +1,108 @@
 #pragma once
 
+#include <atomic>
 #include <list>
+#include <optional>
+#include <shared_mutex>
 
 #include "Controllers/Controller.h"
+#include "Controllers/TimerCommands.h"
 
 #include "DAO/TimerDAO.h"
+#include "DAO/GuildSettingsDAO.h"
+#include "DAO/TimerNameIndex.h"
+#include "DAO/TimerSnapshot.h"
 #include "DTO/TimerDTO.h"
 #include "Controllers/ControllerExceptions.h"
+#include "Controllers/ResponseCache.h"
+#include "Cluster/SharedRing.h"
+#include "Discord/CountdownEditor.h"
+#include "Discord/MessageSink.h"
+#include "Discord/TimerPayload.h"
+#include "Discord/TimerScheduler.h"
+#include "Firing/TimerMutation.h"
+#include "Time/Clock.h"
+#include "Time/TimeFormatter.h"
 
 class TimerController final : public Controller
 {
 public:
     using TimePoint_Type = std::chrono::time_point<std::chrono::system_clock>;
 public:
-    TimerController(dpp::cluster& bot);
+    /**
+     * @param bot The cluster.
+     * @param metrics The registry DAO latencies, fire lateness and timer counts are recorded to. nullptr to record nothing.
+     * @param shards The shards of this process. Only the timers of their guilds are loaded and fired.
+     */
+    TimerController(dpp::cluster& bot, MetricsRegistry* metrics = nullptr, const ShardMap& shards = ShardMap());
+
+    /**
+     * @brief Construct the controller with a custom message sink and scheduler, e.g. a simulated Discord.
+     * 
+     * @param bot The cluster.
+     * @param messageSink The sink timer messages are posted to.
+     * @param scheduler The scheduler driving the timers.
+     * @param metrics The registry DAO latencies, fire lateness and timer counts are recorded to. nullptr to record nothing.
+     * @param clock The clock deciding when timers start and end, e.g. a virtual clock advanced by the scheduler. nullptr for the system clock.
+     * @param shards The shards of this process. Only the timers of their guilds are loaded and fired.
+     */
+    TimerController(dpp::cluster& bot, std::unique_ptr<IMessageSink> messageSink, std::unique_ptr<ITimerScheduler> scheduler,
+        MetricsRegistry* metrics = nullptr, const IClock* clock = nullptr, const ShardMap& shards = ShardMap());
 
     ~TimerController();
+
+    /**
+     * @brief Load the timers as the standby of another process running the same shards, without starting them.
+     * The next init takes over: it applies the last changes of the other process and starts the timers.
+     * 
+     * @param profile The profile the loading phases are recorded to. nullptr to record nothing.
+     * 
+     * @throw DAOInputStreamException if there is an error reading from the input stream.
+     */
+    void initStandby(StartupProfile* profile = nullptr);
+
+    /**
+     * @brief Apply the timer changes persisted by the other process since the last load or follow, keeping the
+     * payloads ready. The name index is only built by the takeover. Does nothing unless standing by.
+     * 
+     * @return size_t The number of timers added, updated or deleted.
+     * 
+     * @throw DAOInputStreamException if the timers must be reloaded and there is an error reading from the input stream.
+     */
+    size_t followPrimary();
+
+    inline bool isStandby() const { return m_Standby; }
+
+    /**
+     * @brief Hand the firing of the timers to a firing engine process. Must be called before init.
+     * Timers are then only scheduled here to be deleted once over.
+     * 
+     * @param ring The producer side of the ring the engine reads the timer mutations from. Must outlive the controller.
+     */
+    inline void setFiringRing(SharedRing* ring) { m_FiringRing = ring; }
+
+    /**
+     * @brief Store the ids of the countdown messages created by the firing engine with their timers, so that they
+     * are edited again after a restart.
+     * 
+     * @param ring The consumer side of the ring the engine sends them through.
+     * @return size_t The number of message ids stored.
+     */
+    size_t applyFiringReports(SharedRing& ring);
+
+    /**
+     * @brief Journal the timer mutations, so that a standby process can follow them. Must be called before init.
+     * 
+     * @param journaled true if a standby process may follow this one.
+     */
+    inline void setJournaled(bool journaled) { m_TimerDAO.setJournaled(journaled); }
+
+    /**
+     * @brief Get the hit and miss counts of the /timer list response cache.
+     * 
+     * @return ResponseCache::Stats The statistics.
+     */
+    inline ResponseCache::Stats getListCacheStats() const { return m_ListCache.getStats(); }
     
     /**
      * @brief Check if a date is in the past.
@@ -24,24 +111,53 @@ public:
      * @return true if the date is in the past, false otherwise.
      */
     static bool IsDatePassed(const TimePoint_Type& time);
+
+    /**
+     * @brief Check if a date is before a given time.
+     * 
+     * @param time The time to check.
+     * @param now The current time.
+     * @return true if the date is before now, false otherwise.
+     */
+    static bool IsDatePassed(const TimePoint_Type& time, const TimePoint_Type& now);
     
     /**
-     * @brief Get a formatted time string in the format "dd/mm/yy hh:mm:ss".
+     * @brief Get how late a fire is, compared to the interval boundary it was scheduled for.
+     * DPP timers tick on whole seconds, the sub-second part of the start is part of the lateness.
+     * 
+     * @param timer The fired timer.
+     * @param now The time of the fire.
+     * @return std::chrono::nanoseconds The lateness, 0 if the fire is early.
+     */
+    static std::chrono::nanoseconds GetFireLateness(const TimerDTO& timer, const TimePoint_Type& now);
+
+    /**
+     * @brief Get a formatted time string in the format "dd/mm/yy hh:mm:ss", in the default zone.
      * 
      * @param time The time to format.
      * @return std::string The formatted time.
      */
     static std::string GetFormattedTime(const TimePoint_Type& time);
 
+    /**
+     * @brief Get a formatted time string in the format "dd/mm/yy hh:mm:ss", in the given zone.
+     * 
+     * @param time The time to format.
+     * @param zone The time zone. nullptr for the default zone.
+     * @return std::string The formatted time.
+     */
+    static std::string GetFormattedTime(const TimePoint_Type& time, TimeFormatter::Zone_Type zone);
+
     /**
      * @brief Parse a time string in the format "dd/mm/yy hh:mm:ss".
      * 
      * @param time The time string.
+     * @param zone The zone the time is expressed in. nullptr for the default zone.
      * @return TimePoint_Type The parsed time.
      * 
      * @throw ParsingException if the time string is invalid.
      */
-    static TimePoint_Type ParseTime(const std::string& time);
+    static TimePoint_Type ParseTime(std::string_view time, TimeFormatter::Zone_Type zone = nullptr);
 
     /**
      * @brief Parse an interval string in the format "0d 0h 0m 0s". Example: "1d 2h 3m 4s", "1d 2h", "1d", "2h 4s".
@@ -51,7 +167,7 @@ public:
      * 
      * @throw ParsingException if the interval string is invalid.
      */
-    static int64_t ParseInteval(const std::string& interval);
+    static int64_t ParseInteval(std::string_view interval);
     
 public:
 
@@ -62,31 +178,105 @@ public:
     class Timer
     {
     public:
-        Timer(const TimerDTO& timer);
+        /**
+         * @param timer The shared timer record, e.g. from a TimerDAO snapshot. Kept alive by the Timer.
+         * @param zone The zone dates are displayed in. nullptr for the default zone.
+         * @param clock The clock giving the current time. nullptr for the system clock.
+         */
+        Timer(TimerSnapshot::Record_Type timer, TimeFormatter::Zone_Type zone = nullptr, const IClock* clock = nullptr);
+
+        /**
+         * @param timer The timer data, copied.
+         * @param zone The zone dates are displayed in. nullptr for the default zone.
+         * @param clock The clock giving the current time. nullptr for the system clock.
+         */
+        Timer(const TimerDTO& timer, TimeFormatter::Zone_Type zone = nullptr, const IClock* clock = nullptr);
 
-        inline const TimerDTO& getData() const { return m_TimerDTO; }
+        inline const TimerDTO& getData() const { return *m_TimerDTO; }
+        inline TimeFormatter::Zone_Type getZone() const { return m_Zone; }
     
         bool isOver() const;
         int64_t getSecondsToNextInterval() const;
         std::string parseString(const std::string& str) const;
 
+        /**
+         * @brief Replace the placeholders that do not depend on the current time ({name}, {interval}, {start}, {end}).
+         * 
+         * @param str The string to parse.
+         * @return std::string The string with static placeholders replaced.
+         */
+        std::string parseStaticString(const std::string& str) const;
+
+        /**
+         * @brief Build the message sent on each fire, with static placeholders replaced.
+         * 
+         * @return dpp::message The message, without channel.
+         */
+        dpp::message buildMessage() const;
+
         friend std::ostream& operator<<(std::ostream& os, const Timer& timer);
 
     private:
-        const TimerDTO& m_TimerDTO;
+        TimerSnapshot::Record_Type m_TimerDTO;
+        TimeFormatter::Zone_Type m_Zone;
+        const IClock& m_Clock;
     };
 
 private:
+    /**
+     * @brief Which timers of a guild a bulk command applies to. Unset criteria match every timer.
+     * 
+     */
+    struct TimerSelector
+    {
+        dpp::snowflake guild;
+        std::optional<dpp::snowflake> channel;
+        std::string prefix;
+        std::optional<TimePoint_Type> endsAfter;
+        std::optional<TimePoint_Type> endsBefore;
+    };
 
     /**
-     * @brief Initialize the controller, loads the timers from persistent storage.
+     * @brief Outcome of a bulk command changing the selected timers.
      * 
      */
-    void onInit() override;
+    struct BulkResult
+    {
+        // Timers changed by the command
+        size_t changed = 0;
+        // Timers found ended by the command, stopped instead of changed
+        size_t deleted = 0;
+    };
+
+private:
+
+    /**
+     * @brief Initialize the controller, loads the timers from persistent storage and starts them.
+     * Guild settings and timers are read in parallel.
+     * 
+     */
+    void onInit(StartupProfile* profile) override;
+
+    /**
+     * @brief Start the timers loaded while standing by, once the changes not followed yet are applied.
+     * 
+     */
+    void takeOver(StartupProfile* profile);
+
+    std::vector<dpp::slashcommand> onCreateCommands() const override;
 
-    void onCreateCommands() const override;
+    void onRegisterRoutes(CommandRouter& router) override;
 
-    bool onSlashCommand(const dpp::slashcommand_t& event) override;
+    dpp::task<void> onSetCommand(const CommandContext& context, const TimerSetParams& params);
+    dpp::task<void> onListCommand(const CommandContext& context);
+    dpp::task<void> onStopCommand(const CommandContext& context, const TimerStopParams& params);
+    dpp::task<void> onTriggerCommand(const CommandContext& context, const TimerTriggerParams& params);
+    dpp::task<void> onUpdateCommand(const CommandContext& context, const TimerUpdateParams& params);
+    dpp::task<void> onTimezoneCommand(const CommandContext& context, const TimerTimezoneParams& params);
+    dpp::task<void> onBulkStopCommand(const CommandContext& context, const TimerBulkParams& params);
+    dpp::task<void> onBulkPauseCommand(const CommandContext& context, const TimerBulkParams& params, bool paused);
+    dpp::task<void> onBulkRetargetCommand(const CommandContext& context, const TimerBulkParams& params);
+    dpp::task<void> onBulkShiftCommand(const CommandContext& context, const TimerBulkParams& params);
 
     /**
      * @brief 
@@ -111,6 +301,17 @@ private:
      */
     void stopTimer(const std::string& id);
 
+    /**
+     * @brief Stop a timer, m_Mutex being held exclusively by the caller.
+     * 
+     * @param id The id of the timer to stop.
+     * 
+     * @throw DAOBadID if the timer name is invalid.
+     * @throw DAOIDNotFound if there is no timer with the given name.
+     * @throw filesystem_error if there is an error deleting the file.
+     */
+    void stopTimer_NoLock(const std::string& id);
+
     /**
      * @brief Update a timer.
      * 
@@ -125,20 +326,250 @@ private:
     void updateTimer(const std::string& id, const TimerDTO& timer);
 
     /**
-     * @brief Get all timers.
+     * @brief Build the selection of a bulk command, replying with the error if the options are invalid.
+     * 
+     * @param context The command context.
+     * @param params The command options.
+     * @return std::optional<TimerSelector> The selection, empty if an error was replied.
+     */
+    std::optional<TimerSelector> getSelector(const CommandContext& context, const TimerBulkParams& params) const;
+
+    /**
+     * @brief Get the timers matching a selection. m_Mutex must be held by the caller.
+     * 
+     * @param selector The selection.
+     * @return std::vector<std::string> The ids of the matching timers, in lexicographic order.
+     */
+    std::vector<std::string> selectTimers_NoLock(const TimerSelector& selector) const;
+
+    /**
+     * @brief Stop the selected timers, with one DAO mutation and one scheduler update.
+     * 
+     * @param selector The selection.
+     * @return size_t The number of timers stopped.
+     * 
+     * @throw filesystem_error if there is an error deleting a file.
+     */
+    size_t stopSelectedTimers(const TimerSelector& selector);
+
+    /**
+     * @brief Pause or resume the selected timers, with one DAO mutation and one scheduler update.
+     * Paused timers that ended meanwhile are stopped instead of resumed, in the same DAO mutation.
+     * 
+     * @param selector The selection.
+     * @param paused true to pause, false to resume.
+     * @return BulkResult The number of timers paused or resumed, and of ended timers stopped.
+     * 
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     * @throw filesystem_error if there is an error replacing or deleting a file.
+     */
+    BulkResult pauseSelectedTimers(const TimerSelector& selector, bool paused);
+
+    /**
+     * @brief Send the selected timers to another channel, with one DAO mutation. They keep their schedule.
+     * 
+     * @param selector The selection.
+     * @param channel The new channel.
+     * @return size_t The number of timers retargeted.
+     * 
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     */
+    size_t retargetSelectedTimers(const TimerSelector& selector, const dpp::snowflake& channel);
+
+    /**
+     * @brief Move the start and end of the selected timers, with one DAO mutation and one scheduler update.
+     * Timers moved past their end are stopped, in the same DAO mutation.
+     * 
+     * @param selector The selection.
+     * @param offset How far the timers move, negative to move them earlier.
+     * @return BulkResult The number of timers shifted, and of timers moved past their end and stopped.
+     * 
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     * @throw filesystem_error if there is an error replacing or deleting a file.
+     */
+    BulkResult shiftSelectedTimers(const TimerSelector& selector, std::chrono::seconds offset);
+
+    /**
+     * @brief Delete timers with one DAO mutation and unschedule them. m_Mutex must be held exclusively by the caller.
+     * 
+     * @param ids The ids of existing timers.
+     * 
+     * @throw filesystem_error if there is an error deleting a file.
+     */
+    void deleteTimers_NoLock(const std::vector<std::string>& ids);
+
+    /**
+     * @brief Drop what is kept of deleted timers: their names, their scheduled fires, their payloads and their
+     * countdown messages. m_Mutex must be held exclusively by the caller.
+     * 
+     * @param ids The ids of the deleted timers.
+     * @param guilds The guilds of the deleted timers, in the same order.
+     */
+    void forgetTimers_NoLock(const std::vector<std::string>& ids, const std::vector<dpp::snowflake>& guilds);
+
+    /**
+     * @brief Format the reply of a bulk command.
+     * 
+     * @param verb What was done to the changed timers, e.g. "Paused".
+     * @param result The outcome of the command.
+     * @return std::string The reply.
+     */
+    static std::string FormatBulkReply(const std::string& verb, const BulkResult& result);
+
+    /**
+     * @brief Stop the scheduled fires of timers with one scheduler update, keeping the timers stored.
+     * m_Mutex must be held exclusively by the caller.
+     * 
+     * @param ids The timer ids. Timers not running are skipped.
+     */
+    void unscheduleTimers_NoLock(const std::vector<std::string>& ids);
+
+    /**
+     * @brief Get the names of the timers of a guild starting with a prefix, for autocompletion.
      * 
-     * @return const TimerDAO::Map_Type& The timers.
+     * @param guild The guild id.
+     * @param prefix What the user typed so far.
+     * @return std::vector<std::string> At most 25 names, in lexicographic order.
      */
-    inline const auto& getTimers() const { return m_TimerDAO.getDataMap(); }
+    std::vector<std::string> completeTimerName(const dpp::snowflake& guild, std::string_view prefix) const;
 
+    /**
+     * @brief Get the time zone of a guild.
+     * 
+     * @param guild The guild id.
+     * @return TimeFormatter::Zone_Type The zone set for the guild, or the default zone.
+     */
+    TimeFormatter::Zone_Type getGuildZone(const dpp::snowflake& guild) const;
+
+    /**
+     * @brief Set the time zone of a guild and rebuild the payloads of its timers.
+     * 
+     * @param guild The guild id.
+     * @param zone The zone.
+     * 
+     * @throw DAOBadID if the guild id is invalid.
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     */
+    void setGuildZone(const dpp::snowflake& guild, TimeFormatter::Zone_Type zone);
+
+    void loadGuildSettings();
+
+    /**
+     * @brief Load the timers from persistent storage, dropping the ones that ended. They are not started.
+     * 
+     */
     void loadTimers();
+
+    /**
+     * @brief Delete the stored timers that ended, with their payloads. m_Mutex must be held exclusively by the caller.
+     * 
+     */
+    void deleteEndedTimers_NoLock();
+
+    /**
+     * @brief Start every loaded timer. The guild settings must be loaded, for the payloads to use the guild zones.
+     * 
+     */
+    void startTimers();
+
+    // Called with m_Mutex held exclusively
+    void buildPayload(const std::string& timerId);
     void startTimer_NoRegister(const std::string& timerId);
-    void sendMessage(const std::string& timerId, const dpp::snowflake& channel) const;
-    void sendMessage(const std::string& timerId) const;
+
+    /**
+     * @brief Check that a DPP timer is still the one driving a timer. m_Mutex must be held by the caller.
+     * 
+     * @param timerId The timer id.
+     * @param dppTimer The DPP timer handle.
+     * @return true if the timer is running on this handle, false if it was stopped or restarted since.
+     */
+    bool isRunning(const std::string& timerId, const dpp::timer& dppTimer) const;
+
+    /**
+     * @brief Record the delay between the takeover and the first fire, on the first fire following a takeover.
+     * 
+     */
+    void recordTakeoverFire();
+
+    /**
+     * @brief Send a timer mutation to the firing engine. m_Mutex must be held by the caller.
+     * 
+     * @param timerId The timer id.
+     * @param type The mutation type.
+     */
+    void publishMutation(const std::string& timerId, TimerMutation::Type type) const;
+
+    /**
+     * @brief Post the message of a timer.
+     * 
+     * @param timerId The timer id.
+     * @param channel The channel, the timer channel if not given.
+     * @param onSent Called with the outcome of the request. May be empty.
+     * 
+     * @throw DAOIDNotFound if there is no timer with the given name.
+     */
+    void sendMessage(const std::string& timerId, const dpp::snowflake& channel, IMessageSink::Callback_Type onSent = nullptr) const;
+    void sendMessage(const std::string& timerId, IMessageSink::Callback_Type onSent = nullptr) const;
+    void sendMessage_NoLock(const std::string& timerId, const dpp::snowflake& channel, IMessageSink::Callback_Type onSent = nullptr) const;
+
+    /**
+     * @brief Show the latest render of an edit in place timer in its message, posting the message on the first fire.
+     * The message created by a previous fire is set on the timer, its file is written by saveCountdownMessages.
+     * m_Mutex must be held exclusively by the caller.
+     * 
+     * @param timerId The timer id.
+     * 
+     * @throw DAOIDNotFound if there is no timer with the given name.
+     */
+    void updateCountdown_NoLock(const std::string& timerId);
+
+    /**
+     * @brief Write the countdown message ids set since the last save. Called without m_Mutex, after a fire, so that
+     * the files are not written under the lock.
+     * 
+     */
+    void saveCountdownMessages();
+
+private:
+    /**
+     * @brief Instruments of the metrics registry, all nullptr without registry.
+     * 
+     */
+    struct Instruments
+    {
+        Histogram* daoAdd = nullptr;
+        Histogram* daoUpdate = nullptr;
+        Histogram* daoDelete = nullptr;
+        Histogram* daoLoad = nullptr;
+        Histogram* fireLateness = nullptr;
+        Gauge* activeTimers = nullptr;
+        Gauge* outboundQueueDepth = nullptr;
+        Histogram* takeoverFirstFire = nullptr;
+    };
 
 private:
+    // Handlers run on the worker pool and timers fire on the DPP timer thread
+    mutable std::shared_mutex m_Mutex;
+    mutable std::shared_mutex m_GuildZonesMutex;
     TimerDAO m_TimerDAO;
+    TimerNameIndex m_TimerNames;
+    GuildSettingsDAO m_GuildSettingsDAO;
+    std::unordered_map<dpp::snowflake, TimeFormatter::Zone_Type> m_GuildZones;
     std::unordered_map<std::string, dpp::timer> m_RunningDppTimers;
+    std::unordered_map<std::string, TimerPayload> m_Payloads;
+    ResponseCache m_ListCache;
+    std::unique_ptr<IMessageSink> m_MessageSink;
+    // Messages of the edit in place timers, posting through m_MessageSink
+    CountdownEditor m_CountdownEditor;
+    std::unique_ptr<ITimerScheduler> m_Scheduler;
+    const IClock& m_Clock;
+    Instruments m_Metrics;
+    // Set by initStandby, cleared by the takeover
+    bool m_Standby = false;
+    std::atomic<bool> m_AwaitingTakeoverFire = false;
+    TimePoint_Type m_TakeoverStart;
+    // nullptr when the timers fire in this process
+    SharedRing* m_FiringRing = nullptr;
 };
 
 namespace std
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 
 #include "DAO/DAO.h"
@@ -19,6 +20,14 @@ public:
      */
     inline const Map_Type& getDataMap() const { return m_Elements; }
 
+    /**
+     * @brief Get the mutation version, incremented on each add, update, delete and load.
+     * 
+     * @return uint64_t The version. Equal versions mean equal content.
+     */
+    inline uint64_t getVersion() const { return m_Version; }
+
 protected:
     Map_Type m_Elements;
+    uint64_t m_Version = 0;
 };
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+
+#include "Cluster/ShardMap.h"
+#include "DAO/AbstractMapDAO.h"
+#include "DTO/GuildSettingsDTO.h"
+
+class GuildSettingsDAO : public AbstractMapDAO<dpp::snowflake, GuildSettingsDTO>
+{
+public:
+    /**
+     * @param shards The partition of the guilds. Only the settings of the owned shards are loaded.
+     */
+    explicit GuildSettingsDAO(const ShardMap& shards = ShardMap());
+    
+    /**
+     * @brief Add a new element.
+     * @param id The id of the element.
+     * @param element The data of the element.
+     * 
+     * @throw DAOBadID if the id is invalid.
+     * @throw DAOIDAlreadyExists if there is already an element with the given id.
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     */
+    void add(const ID_Type& id, const DTO_Type& element) override;
+
+    /**
+     * @brief Update an existing element.
+     * @param id The id of the element to update.
+     * @param element The new data of the element.
+     * 
+     * @throw DAOBadID if the id is invalid.
+     * @throw DAOIDNotFound if there is no element with the given id.
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     * @throw filesystem_error if there is an error deleting the file.
+     */
+    void update(const ID_Type& id, const DTO_Type& element) override;
+
+    /**
+     * @brief Delete an existing element.
+     * @param id The id of the element to delete.
+     * 
+     * @throw DAOBadID if the id is invalid.
+     * @throw DAOIDNotFound if there is no element with the given id.
+     * @throw filesystem_error if there is an error deleting the file.
+     */
+    void deleteByID(const ID_Type& id) override;
+
+    /**
+     * @brief Get an element by id.
+     * @return const DTO_Type& The element with the given id.
+     * 
+     * @throw DAOBadID if the id is invalid.
+     * @throw DAOIDNotFound if there is no element with the given id.
+     */
+    const DTO_Type& findOne(const ID_Type& id) const override;
+
+    /**
+     * @brief Get all elements.
+     * @return std::vector<DTO_Type> A vector with all elements.
+     */
+    std::vector<DTO_Type> findAll() const override;
+
+    /**
+     * @brief Check if an element with the given id exists.
+     * @return True if the element exists, false otherwise.
+     * 
+     * @throw DAOBadID if the id is invalid.
+     */
+    bool idExists(const ID_Type& id) const override;
+
+    /**
+     * @brief Check if the given id is valid.
+     * @return True if the id is valid, false otherwise.
+     */
+    bool isIDValid(const ID_Type& id) const override;
+
+    /**
+     * @brief Load the guild settings of the owned shards from the data directory. When the data is partitioned, the
+     * owned settings still stored in the unpartitioned directory are moved to the directory of their shard.
+     * 
+     * @throw DAOInputStreamException if there is an error reading from the input stream.
+     */
+    void loadGuildSettings();
+
+private:
+
+    /**
+     * @brief Get the file of a guild.
+     * @param id The guild id.
+     * @return std::filesystem::path The path of the file.
+     */
+    std::filesystem::path getFilePath(const ID_Type& id) const;
+
+    /**
+     * @brief Load the guild settings of a directory.
+     * @param directory The directory.
+     * @param migrate true to only load the owned guilds, moving them to the directory of their shard.
+     * 
+     * @throw DAOInputStreamException if there is an error reading from the input stream.
+     */
+    void loadDirectory(const std::filesystem::path& directory, bool migrate);
+
+private:
+    ShardMap m_Shards;
+};
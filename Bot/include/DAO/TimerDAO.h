@@ -1,14 +1,37 @@
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
-#include "DAO/AbstractMapDAO.h"
+#include "Cluster/ShardMap.h"
+#include "DAO/DAO.h"
+#include "DAO/TimerSnapshot.h"
 #include "DTO/TimerDTO.h"
 
-class TimerDAO : public AbstractMapDAO<std::string, TimerDTO>
+/**
+ * @brief Timers stored one file per timer. Each mutation publishes a new immutable TimerSnapshot, sharing the
+ * unchanged timers with the previous one.
+ * 
+ */
+class TimerDAO : public IDAO<std::string, TimerDTO>
 {
 public:
-    TimerDAO() = default;
+    using Map_Type = TimerSnapshot;
+    using Record_Type = TimerSnapshot::Record_Type;
+    using Snapshot_Type = std::shared_ptr<const TimerSnapshot>;
+
+    // A longer journal is reset: following it would cost more than reloading the timers
+    static constexpr uint64_t DEFAULT_MAX_JOURNAL_SIZE = 1 << 20;
+
+public:
+    /**
+     * @param shards The partition of the timers, by guild. Only the timers of the owned shards are loaded.
+     */
+    explicit TimerDAO(const ShardMap& shards = ShardMap());
     
     /**
      * @brief Add a new element.
@@ -43,6 +66,64 @@ public:
      */
     void deleteByID(const ID_Type& id) override;
 
+    /**
+     * @brief Update several existing elements as one mutation: their files are rewritten in place, the version
+     * changes once and each journal is appended once.
+     * @param elements The ids and new data of the elements.
+     * 
+     * @throw DAOBadID if an id is invalid.
+     * @throw DAOIDNotFound if there is no element with one of the ids. Nothing is written then.
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     * @throw filesystem_error if there is an error deleting the file of an element moved to another shard.
+     */
+    void updateMany(const std::vector<std::pair<ID_Type, DTO_Type>>& elements);
+
+    /**
+     * @brief Update and delete several existing elements as one mutation: the version changes once and each journal
+     * is appended once. The updates are written aside first, a failed write leaves every element untouched.
+     * @param elements The ids and new data of the elements to update.
+     * @param deleted The ids of the elements to delete, none of them updated.
+     * 
+     * @throw DAOBadID if an id is invalid.
+     * @throw DAOIDNotFound if there is no element with one of the ids. Nothing is written then.
+     * @throw DAOOutputStreamException if there is an error writing to the output stream.
+     * @throw filesystem_error if there is an error replacing or deleting a file.
+     */
+    void updateMany(const std::vector<std::pair<ID_Type, DTO_Type>>& elements, const std::vector<ID_Type>& deleted);
+
+    /**
+     * @brief Delete several existing elements as one mutation: the version changes once and each journal is
+     * appended once.
+     * @param ids The ids of the elements to delete.
+     * 
+     * @throw DAOBadID if an id is invalid.
+     * @throw DAOIDNotFound if there is no element with one of the ids. Nothing is deleted then.
+     * @throw filesystem_error if there is an error deleting a file.
+     */
+    void deleteMany(const std::vector<ID_Type>& ids);
+
+    /**
+     * @brief Set the message id of an element, without writing its file nor changing the version: the message id
+     * is not listed. The file is written by the next saveMessageIDs.
+     * @param id The id of the element.
+     * @param message The message id.
+     * 
+     * @throw DAOBadID if the id is invalid.
+     * @throw DAOIDNotFound if there is no element with the given id.
+     */
+    void setMessageID(const ID_Type& id, const dpp::snowflake& message);
+
+    /**
+     * @brief Write the files of the elements whose message id was set since the last save. Can be called without
+     * lock, from any thread: it only writes files, serialized with the writes of the mutations, and never publishes
+     * a snapshot. The elements deleted meanwhile are skipped.
+     * 
+     * @throw DAOOutputStreamException if there is an error writing to the output stream. The elements not written
+     * are written by the next save.
+     * @throw filesystem_error if there is an error replacing a file.
+     */
+    void saveMessageIDs();
+
     /**
      * @brief Get an element by id.
      * @return const DTO_Type& The element with the given id.
@@ -52,6 +133,39 @@ public:
      */
     const DTO_Type& findOne(const ID_Type& id) const override;
 
+    /**
+     * @brief Get the shared, immutable record of an element, kept valid by its holder after the element is updated
+     * or deleted.
+     * @return Record_Type The element with the given id.
+     * 
+     * @throw DAOBadID if the id is invalid.
+     * @throw DAOIDNotFound if there is no element with the given id.
+     */
+    Record_Type findRecord(const ID_Type& id) const;
+
+    /**
+     * @brief Get an immutable snapshot of every element at the current version. Can be called without lock, from
+     * any thread: the current snapshot is shared, nothing is copied, and later mutations publish new snapshots
+     * without changing it.
+     * @return Snapshot_Type The snapshot.
+     */
+    Snapshot_Type snapshot() const;
+
+    /**
+     * @brief Get the elements of the current version, valid until the next mutation. Must not race with a mutation,
+     * as any other read. snapshot() gives elements that stay valid.
+     * 
+     * @return const Map_Type& The elements, by id.
+     */
+    inline const Map_Type& getDataMap() const { return *m_Snapshot.current; }
+
+    /**
+     * @brief Get the mutation version, incremented on each add, update, delete and load.
+     * 
+     * @return uint64_t The version. Equal versions mean equal content, but for the message ids.
+     */
+    inline uint64_t getVersion() const { return m_Version; }
+
     /**
      * @brief Get all elements.
      * @return std::vector<const DTO_Type&> A vector with all elements.
@@ -73,13 +187,159 @@ public:
     bool isIDValid(const ID_Type& id) const override;
 
     /**
-     * @brief Load all timers from the data directory.
+     * @brief Load the timers of the owned shards from the data directory. When the data is partitioned, the owned
+     * timers still stored in the unpartitioned directory are moved to the directory of their shard.
      * 
      * @throw DAOInputStreamException if there is an error reading from the input stream.
      */
     void loadTimers();
 
+    /**
+     * @brief Start a new journal in each owned shard, the stored timers being the snapshot it follows. Adds and
+     * deletes are appended to the journal of their shard, so that a standby process can follow them.
+     * 
+     * @throw DAOOutputStreamException if a journal can not be written.
+     */
+    void resetJournals();
+
+    /**
+     * @brief Enable or disable the journals. Disabled by default: without a standby process following them, they
+     * would only grow.
+     * 
+     * @param journaled true to append the adds and deletes to the journals.
+     * @param maxSize The size in bytes past which a journal is reset.
+     */
+    inline void setJournaled(bool journaled, uint64_t maxSize = DEFAULT_MAX_JOURNAL_SIZE)
+    {
+        m_Journaled = journaled;
+        m_MaxJournalSize = maxSize;
+    }
+
+    /**
+     * @brief Apply the adds and deletes journaled by another process since the last load or follow. When a journal
+     * was reset since, every timer of the owned shards is reloaded.
+     * 
+     * @return std::vector<ID_Type> The ids of the timers added, updated or deleted.
+     * 
+     * @throw DAOInputStreamException if there is an error reading from the input stream.
+     */
+    std::vector<ID_Type> followJournals();
+
 private:
+    // A line of a journal
+    struct JournalEntry
+    {
+        ID_Type id;
+        dpp::snowflake guild;
+        // '+' for an add or update, '-' for a delete
+        char operation;
+    };
+
+    // Position of this DAO in the journal of a shard
+    struct JournalPosition
+    {
+        // Written in the first line of the journal, changed by each reset
+        std::string generation;
+        uint64_t offset = 0;
+    };
+
+    // The snapshot published last. Snapshots are immutable, a copied DAO shares it
+    struct PublishedSnapshot
+    {
+        PublishedSnapshot() = default;
+
+        PublishedSnapshot(const PublishedSnapshot& other)
+            : current(other.load())
+        {}
+
+        PublishedSnapshot& operator=(const PublishedSnapshot& other)
+        {
+            auto snapshot = other.load();
+
+            std::lock_guard lock(mutex);
+            current = std::move(snapshot);
+            return *this;
+        }
+
+        inline Snapshot_Type load() const
+        {
+            std::lock_guard lock(mutex);
+            return current;
+        }
+
+        // Only held to copy or replace the pointer
+        mutable std::mutex mutex;
+        Snapshot_Type current = std::make_shared<const TimerSnapshot>();
+    };
+
+private:
+
+    /**
+     * @brief Get the journal of a shard.
+     * @param shard The shard.
+     * @return std::filesystem::path The path of the journal.
+     */
+    std::filesystem::path getJournalPath(uint32_t shard) const;
+
+    /**
+     * @brief Start a new journal in a shard, replacing the previous one at once.
+     * @param shard The shard.
+     * 
+     * @throw DAOOutputStreamException if the journal can not be written.
+     */
+    void resetJournal(uint32_t shard);
+
+    /**
+     * @brief Append an add or a delete to the journal of a timer shard, creating the journal if needed.
+     * Nothing is appended when the journals are disabled.
+     * @param id The timer id.
+     * @param guild The guild of the timer.
+     * @param operation '+' for an add, '-' for a delete.
+     */
+    void appendJournal(const ID_Type& id, const dpp::snowflake& guild, char operation);
+
+    /**
+     * @brief Append adds and deletes to the journals of their shards, with one write per journal. A journal grown
+     * past its maximum size is reset, its followers reloading the timers once instead of reading it further.
+     * Nothing is appended when the journals are disabled.
+     * @param entries The changes, in order.
+     */
+    void appendJournal(const std::vector<JournalEntry>& entries);
+
+    /**
+     * @brief Get the current end of the journal of a shard.
+     * @param shard The shard.
+     * @return JournalPosition The position, with an empty generation if there is no journal.
+     */
+    JournalPosition getJournalEnd(uint32_t shard) const;
+
+    /**
+     * @brief Read a timer file, if it exists.
+     * @param path The file.
+     * @param timer Set to the read timer.
+     * @return true if the file exists and was read.
+     * 
+     * @throw DAOInputStreamException if there is an error reading from the input stream.
+     */
+    bool readTimerFile(const std::filesystem::path& path, TimerDTO& timer) const;
+
+    /**
+     * @brief Get the file of a timer.
+     * @param id The timer id.
+     * @param guild The guild of the timer.
+     * @return std::filesystem::path The path of the file.
+     */
+    std::filesystem::path getFilePath(const ID_Type& id, const dpp::snowflake& guild) const;
+
+    /**
+     * @brief Load the timers of a directory.
+     * @param directory The directory.
+     * @param migrate true to only load the owned timers, moving them to the directory of their shard.
+     * @param timers The builder the timers are added to.
+     * 
+     * @throw DAOInputStreamException if there is an error reading from the input stream.
+     */
+    void loadDirectory(const std::filesystem::path& directory, bool migrate, TimerSnapshot::Builder& timers);
 
     /**
      * @brief Write a timer to an output stream.
@@ -99,4 +359,36 @@ private:
      * @throw DAOParseException if there is an error parsing the input.
      */
     TimerDTO readTimer(std::istream& is) const;
+
+    /**
+     * @brief Publish the next version of the elements.
+     * @param timers The builder of the elements, started from the current version.
+     */
+    void publish(TimerSnapshot::Builder& timers);
+
+    // Held while writing files, a copied DAO has its own
+    struct FileWrites
+    {
+        FileWrites() = default;
+
+        FileWrites(const FileWrites&) {}
+
+        FileWrites& operator=(const FileWrites&)
+        {
+            return *this;
+        }
+
+        std::mutex mutex;
+        // Set by setMessageID, written by saveMessageIDs
+        std::unordered_set<ID_Type> unsavedMessageIDs;
+    };
+
+private:
+    ShardMap m_Shards;
+    bool m_Journaled = false;
+    uint64_t m_MaxJournalSize = DEFAULT_MAX_JOURNAL_SIZE;
+    std::map<uint32_t, JournalPosition> m_JournalPositions;
+    PublishedSnapshot m_Snapshot;
+    uint64_t m_Version = 0;
+    FileWrites m_FileWrites;
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "DAO/TimerDAO.h"
+
+/**
+ * @brief Sorted index of timer names per guild, answering prefix queries in O(log n).
+ * 
+ * Kept in sync with TimerDAO by its owner: rebuilt on load, then updated on each add and delete. Guarded by its own
+ * lock, held only in memory, so that the queries never wait for the timers being written.
+ */
+class TimerNameIndex
+{
+public:
+    TimerNameIndex() = default;
+
+    /**
+     * @brief Replace the index content with the names of the given timers.
+     * 
+     * @param timers The timers.
+     */
+    void rebuild(const TimerDAO::Map_Type& timers);
+
+    /**
+     * @brief Add a name. Does nothing if the name is already indexed in this guild.
+     * 
+     * @param guild The guild of the timer.
+     * @param name The timer name.
+     */
+    void add(const dpp::snowflake& guild, const std::string& name);
+
+    /**
+     * @brief Remove a name. Does nothing if the name is not indexed in this guild.
+     * 
+     * @param guild The guild of the timer.
+     * @param name The timer name.
+     */
+    void remove(const dpp::snowflake& guild, const std::string& name);
+
+    /**
+     * @brief Get the names of a guild starting with a prefix, in lexicographic order.
+     * 
+     * @param guild The guild.
+     * @param prefix The prefix. Empty matches every name.
+     * @param limit The maximum number of names returned.
+     * @return std::vector<std::string> The names.
+     */
+    std::vector<std::string> findByPrefix(const dpp::snowflake& guild, std::string_view prefix, size_t limit) const;
+
+    /**
+     * @brief Get the number of names indexed in a guild.
+     * 
+     * @param guild The guild.
+     * @return size_t The number of names.
+     */
+    size_t size(const dpp::snowflake& guild) const;
+
+private:
+    mutable std::shared_mutex m_Mutex;
+    std::unordered_map<dpp::snowflake, std::vector<std::string>> m_Names;
+};
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "DTO/TimerDTO.h"
+
+/**
+ * @brief Immutable view of every stored timer at one version of a TimerDAO.
+ *
+ * The timers are stored in a hash trie: each internal node splits the timers by BRANCH_BITS bits of the hash of
+ * their id, and each leaf holds at most LEAF_CAPACITY timers. A new version is built from the previous one by
+ * copying only the nodes on the path to each changed timer, i.e. O(log n) nodes of at most BRANCH_COUNT pointers
+ * or LEAF_CAPACITY timers, every other node and every unchanged timer being shared between versions.
+ * A snapshot can therefore be read from any thread without lock, for as long as it is held, whatever the versions
+ * published meanwhile.
+ */
+class TimerSnapshot
+{
+public:
+    using Record_Type = std::shared_ptr<const TimerDTO>;
+    using Entry_Type = std::pair<std::string, Record_Type>;
+
+    static constexpr size_t BRANCH_BITS = 5;
+    static constexpr size_t BRANCH_COUNT = size_t(1) << BRANCH_BITS;
+    static constexpr size_t LEAF_CAPACITY = 8;
+    // Past this depth, the hash bits are all used: the leaves only hold timers whose hashes collide and grow as needed
+    static constexpr size_t MAX_DEPTH = sizeof(size_t) * 8 / BRANCH_BITS;
+
+private:
+    struct Node
+    {
+        // Empty for a leaf, BRANCH_COUNT children for an internal node, nullptr where no timer was stored
+        std::vector<std::shared_ptr<const Node>> children;
+        // Only for a leaf
+        std::vector<Entry_Type> entries;
+    };
+
+    using Node_Type = std::shared_ptr<const Node>;
+
+public:
+    /**
+     * @brief Iterator over the (id, record) pairs of a snapshot, in no particular order.
+     *
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry_Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+    public:
+        Iterator() = default;
+
+        inline reference operator*() const { return m_Leaf->entries[m_Entry]; }
+        inline pointer operator->() const { return &m_Leaf->entries[m_Entry]; }
+
+        Iterator& operator++();
+
+        Iterator operator++(int);
+
+        inline bool operator==(const Iterator& other) const
+        {
+            return m_Leaf == other.m_Leaf && m_Entry == other.m_Entry;
+        }
+
+    private:
+        friend class TimerSnapshot;
+
+        // An internal node on the path to the current leaf
+        struct Frame
+        {
+            const Node* node;
+            // The next child to visit
+            size_t next;
+        };
+
+        /**
+         * @param root The root of the trie iterated, nullptr for the end.
+         */
+        explicit Iterator(const Node* root);
+
+        /**
+         * @brief Move to the first timer at or after the current position, or to the end.
+         */
+        void settle();
+
+    private:
+        std::array<Frame, MAX_DEPTH> m_Frames{};
+        size_t m_Depth = 0;
+        // nullptr at the end
+        const Node* m_Leaf = nullptr;
+        size_t m_Entry = 0;
+    };
+
+    /**
+     * @brief Build the next version of a snapshot, copying each node on its first change.
+     *
+     */
+    class Builder
+    {
+    public:
+        /**
+         * @brief Start an empty snapshot.
+         */
+        Builder();
+
+        /**
+         * @brief Start from the timers of a snapshot.
+         *
+         * @param snapshot The previous version.
+         */
+        explicit Builder(const TimerSnapshot& snapshot);
+
+        /**
+         * @brief Add or replace a timer.
+         *
+         * @param id The timer id.
+         * @param timer The timer.
+         */
+        void set(const std::string& id, Record_Type timer);
+
+        /**
+         * @brief Remove a timer, if present.
+         *
+         * @param id The timer id.
+         */
+        void erase(const std::string& id);
+
+        /**
+         * @brief Publish the built timers. The builder must not be used afterwards.
+         *
+         * @param version The version of the snapshot.
+         * @return std::shared_ptr<const TimerSnapshot> The snapshot.
+         */
+        std::shared_ptr<const TimerSnapshot> build(uint64_t version);
+
+    private:
+        /**
+         * @brief Get the leaf of an id, copying the nodes on its path that are shared with the previous version.
+         * Internal nodes are created down to the leaf where missing.
+         *
+         * @param id The timer id.
+         * @param depth Set to the depth of the leaf.
+         * @return Node& The leaf, only referenced by this builder.
+         */
+        Node& getLeaf(const std::string& id, size_t& depth);
+
+        /**
+         * @brief Get a node to modify, copied first if shared with the previous version.
+         *
+         * @param node The node, replaced by its copy.
+         * @return Node& The node, only referenced by this builder.
+         */
+        Node& own(Node_Type& node);
+
+        /**
+         * @brief Split a leaf past its capacity into an internal node, then the new leaves past their capacity.
+         *
+         * @param leaf The leaf, only referenced by this builder.
+         * @param depth The depth of the leaf.
+         */
+        void split(Node& leaf, size_t depth);
+
+    private:
+        Node_Type m_Root;
+        // Nodes created by this builder, not published yet: modified in place
+        std::unordered_set<const Node*> m_Owned;
+        size_t m_Size = 0;
+    };
+
+public:
+    /**
+     * @brief Make an empty snapshot.
+     *
+     * @param version The version of the snapshot.
+     */
+    explicit TimerSnapshot(uint64_t version = 0);
+
+    /**
+     * @brief Get a timer by id.
+     *
+     * @param id The timer id.
+     * @return Record_Type The timer, nullptr if there was no timer with this id at this version.
+     */
+    Record_Type find(const std::string& id) const;
+
+    inline bool contains(const std::string& id) const { return find(id) != nullptr; }
+
+    inline size_t size() const { return m_Size; }
+
+    inline uint64_t getVersion() const { return m_Version; }
+
+    inline Iterator begin() const { return Iterator(m_Root.get()); }
+
+    inline Iterator end() const { return Iterator(nullptr); }
+
+private:
+    TimerSnapshot(uint64_t version, Node_Type root, size_t size);
+
+    /**
+     * @brief Get a timer by id in a trie.
+     */
+    static Record_Type Find(const Node& root, const std::string& id);
+
+    /**
+     * @brief Get the child of an internal node an id is stored under.
+     */
+    static size_t GetChildIndex(size_t hash, size_t depth);
+
+    /**
+     * @brief Get the leaf shared by the empty snapshots, so that they cost no allocation.
+     */
+    static const Node_Type& GetEmptyLeaf();
+
+private:
+    uint64_t m_Version;
+    size_t m_Size = 0;
+    Node_Type m_Root;
+};
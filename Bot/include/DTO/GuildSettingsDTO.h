@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+#include <dpp/dpp.h>
+
+class GuildSettingsDTO
+{
+public:
+    GuildSettingsDTO() = default;
+
+    GuildSettingsDTO(dpp::snowflake guild, const std::string& timeZone)
+        : m_Guild(guild), m_TimeZone(timeZone)
+    {}
+
+    GuildSettingsDTO(const GuildSettingsDTO&) = default;
+
+    inline const dpp::snowflake& getGuild() const { return m_Guild; }
+    inline const std::string& getTimeZone() const { return m_TimeZone; }
+
+    inline void setGuild(const dpp::snowflake& guild) { m_Guild = guild; }
+    inline void setTimeZone(const std::string& timeZone) { m_TimeZone = timeZone; }
+
+private:
+    dpp::snowflake m_Guild = 0;
+    std::string m_TimeZone;
+};
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include <dpp/dpp.h>
 
+/**
+ * @brief Timer data. The strings are immutable and shared between copies: copying a timer costs a few reference
+ * counts, and a setter replaces only its own field, the copies keeping the previous value.
+ * 
+ */
 class TimerDTO
 {
 public:
@@ -13,36 +20,71 @@ public:
 public:
     TimerDTO() = default;
 
-    TimerDTO(const std::string& name, dpp::snowflake channel, int64_t intervalSeconds, const std::string& message, const TimePoint_Type& start, const TimePoint_Type& end, const std::string& imageURL, const std::string& title)
-        : m_Name(name), m_Channel(channel), m_IntervalSeconds(intervalSeconds), m_Message(message), m_Start(start), m_End(end), m_ImageURL(imageURL), m_Title(title)
+    TimerDTO(const std::string& name, dpp::snowflake channel, int64_t intervalSeconds, const std::string& message, const TimePoint_Type& start, const TimePoint_Type& end, const std::string& imageURL, const std::string& title, dpp::snowflake guild = 0)
+        : m_Name(Share(name)), m_Channel(channel), m_IntervalSeconds(intervalSeconds), m_Message(Share(message)), m_Start(start), m_End(end), m_ImageURL(Share(imageURL)), m_Title(Share(title)), m_Guild(guild)
     {}
 
     TimerDTO(const TimerDTO&) = default;
 
-    inline const std::string& getName() const { return m_Name; }
+    TimerDTO(TimerDTO&&) noexcept = default;
+
+    TimerDTO& operator=(const TimerDTO&) = default;
+
+    TimerDTO& operator=(TimerDTO&&) noexcept = default;
+
+    inline const std::string& getName() const { return Get(m_Name); }
     inline const dpp::snowflake& getChannel() const { return m_Channel; }
     inline int64_t getInterval() const { return m_IntervalSeconds; }
-    inline const std::string& getMessage() const { return m_Message; }
+    inline const std::string& getMessage() const { return Get(m_Message); }
     inline const TimePoint_Type& getStart() const { return m_Start; }
     inline const TimePoint_Type& getEnd() const { return m_End; }
-    inline const std::string& getImageURL() const { return m_ImageURL; }
-    inline const std::string& getTitle() const { return m_Title; }
+    inline const std::string& getImageURL() const { return Get(m_ImageURL); }
+    inline const std::string& getTitle() const { return Get(m_Title); }
+    inline const dpp::snowflake& getGuild() const { return m_Guild; }
+    inline bool isPaused() const { return m_Paused; }
+    inline bool isEditInPlace() const { return m_EditInPlace; }
+    inline const dpp::snowflake& getMessageID() const { return m_MessageID; }
 
-    inline void setName(const std::string& name) { m_Name = name; }
+    inline void setName(std::string name) { m_Name = Share(std::move(name)); }
     inline void setChannel(const dpp::snowflake& channel) { m_Channel = channel; }
     inline void setInterval(int64_t intervalSeconds) { m_IntervalSeconds = intervalSeconds; }
-    inline void setMessage(const std::string& message) { m_Message = message; }
+    inline void setMessage(std::string message) { m_Message = Share(std::move(message)); }
     inline void setStart(const TimePoint_Type& start) { m_Start = start; }
     inline void setEnd(const TimePoint_Type& end) { m_End = end; }
-    inline void setImageURL(const std::string& url) { m_ImageURL = url; }
-    inline void setTitle(const std::string& description) { m_Title = description; }
+    inline void setImageURL(std::string url) { m_ImageURL = Share(std::move(url)); }
+    inline void setTitle(std::string description) { m_Title = Share(std::move(description)); }
+    inline void setGuild(const dpp::snowflake& guild) { m_Guild = guild; }
+    inline void setPaused(bool paused) { m_Paused = paused; }
+    inline void setEditInPlace(bool editInPlace) { m_EditInPlace = editInPlace; }
+    inline void setMessageID(const dpp::snowflake& message) { m_MessageID = message; }
+
+private:
+    // nullptr for an empty string, so that timers without image or title do not allocate them
+    using String_Type = std::shared_ptr<const std::string>;
 
 private:
-    std::string m_Name;
+    static inline const std::string& Get(const String_Type& field) { return field != nullptr ? *field : EMPTY; }
+
+    static inline String_Type Share(std::string value)
+    {
+        return value.empty() ? nullptr : std::make_shared<const std::string>(std::move(value));
+    }
+
+private:
+    static inline const std::string EMPTY;
+
+    String_Type m_Name;
     dpp::snowflake m_Channel = 0;
     int64_t m_IntervalSeconds = -1;
-    std::string m_Message;
+    String_Type m_Message;
     TimePoint_Type m_Start, m_End;
-    std::string m_ImageURL;
-    std::string m_Title;
+    String_Type m_ImageURL;
+    String_Type m_Title;
+    dpp::snowflake m_Guild = 0;
+    // Kept stored but not fired
+    bool m_Paused = false;
+    // Fires edit one message instead of posting a new one each time
+    bool m_EditInPlace = false;
+    // The message edited by the fires, 0 until posted
+    dpp::snowflake m_MessageID = 0;
 };
\ No newline at end of file
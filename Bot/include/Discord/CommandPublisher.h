@@ -0,0 +1,26 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+class ICommandPublisher
+{
+public:
+    using CommandIds_Type = std::unordered_map<std::string, dpp::snowflake>;
+    using Callback_Type = std::function<void(const CommandIds_Type&)>;
+
+public:
+    virtual ~ICommandPublisher() = default;
+
+    /**
+     * @brief Replace all the global commands of the application with a single request.
+     * 
+     * @param commands The commands.
+     * @param onSuccess Called with the id of each command, by name, once the commands are registered. Not called on failure.
+     */
+    virtual void bulkOverwrite(const std::vector<dpp::slashcommand>& commands, Callback_Type onSuccess) = 0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "Discord/MessageSink.h"
+
+/**
+ * @brief Keeps one message per countdown up to date: the first update posts it, the next ones edit it.
+ * 
+ * At most one request per countdown is in flight. The updates made meanwhile are coalesced: only the latest one
+ * is sent once the request completes, so a slow or rate limited channel never queues stale edits.
+ */
+class CountdownEditor
+{
+public:
+    struct Stats
+    {
+        uint64_t creates = 0;
+        uint64_t edits = 0;
+        // Updates replaced by a later one before being sent
+        uint64_t coalesced = 0;
+    };
+
+public:
+    /**
+     * @param sink The sink the messages are posted to and edited through. Must outlive the editor.
+     */
+    explicit CountdownEditor(IMessageSink& sink);
+
+    CountdownEditor(const CountdownEditor&) = delete;
+
+    CountdownEditor& operator=(const CountdownEditor&) = delete;
+
+    /**
+     * @brief Show the latest render of a countdown.
+     * 
+     * @param key The countdown, e.g. the timer id.
+     * @param channel The channel of the countdown. A countdown moved to another channel gets a new message there.
+     * @param message The message already showing the countdown, e.g. persisted before a restart. 0 to post a new one.
+     * Only used until the editor knows the message of the countdown.
+     * @param body The JSON body of the message.
+     */
+    void update(const std::string& key, const dpp::snowflake& channel, const dpp::snowflake& message, std::string body);
+
+    /**
+     * @brief Get the message showing a countdown.
+     * 
+     * @param key The countdown.
+     * @return dpp::snowflake The message id, 0 if the countdown is unknown or its message not created yet.
+     */
+    dpp::snowflake getMessage(const std::string& key) const;
+
+    /**
+     * @brief Forget a countdown, e.g. once its timer stopped. Its request in flight completes but is not followed.
+     * 
+     * @param key The countdown.
+     */
+    void forget(const std::string& key);
+
+    Stats getStats() const;
+
+private:
+    struct Countdown
+    {
+        dpp::snowflake channel;
+        dpp::snowflake message;
+        // Unique to each countdown, a forgotten countdown ignores the completion of its last request
+        uint64_t generation = 0;
+        bool inFlight = false;
+        std::optional<std::string> pending;
+    };
+
+private:
+    /**
+     * @brief Post or edit the message of a countdown. m_Mutex must not be held, the sink may complete the request
+     * on the calling thread.
+     * 
+     * @param key The countdown.
+     * @param generation The generation of the countdown.
+     * @param channel The channel of the countdown.
+     * @param message The message to edit, 0 to post a new one.
+     * @param body The JSON body of the message.
+     */
+    void send(const std::string& key, uint64_t generation, const dpp::snowflake& channel, const dpp::snowflake& message, const std::string& body);
+
+    /**
+     * @brief Complete the request in flight of a countdown, then send its pending update if any.
+     * 
+     * @param key The countdown.
+     * @param generation The generation of the countdown the request was sent for.
+     * @param channel The channel the request was sent to.
+     * @param created The id of the created message, 0 for an edit.
+     * @param success true if the request succeeded.
+     */
+    void onSent(const std::string& key, uint64_t generation, const dpp::snowflake& channel, const dpp::snowflake& created, bool success);
+
+private:
+    IMessageSink& m_Sink;
+    mutable std::mutex m_Mutex;
+    std::unordered_map<std::string, Countdown> m_Countdowns;
+    uint64_t m_NextGeneration = 1;
+    std::atomic<uint64_t> m_Creates = 0;
+    std::atomic<uint64_t> m_Edits = 0;
+    std::atomic<uint64_t> m_Coalesced = 0;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Discord/CommandPublisher.h"
+
+/**
+ * @brief Command publisher using the global bulk overwrite endpoint of the cluster.
+ * 
+ */
+class DppCommandPublisher final : public ICommandPublisher
+{
+public:
+    DppCommandPublisher(dpp::cluster& bot);
+
+    void bulkOverwrite(const std::vector<dpp::slashcommand>& commands, Callback_Type onSuccess) override;
+
+private:
+    dpp::cluster& m_Bot;
+};
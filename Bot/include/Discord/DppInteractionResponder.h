@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Discord/InteractionResponder.h"
+
+/**
+ * @brief Interaction responder using the interaction endpoints of the cluster.
+ * 
+ */
+class DppInteractionResponder final : public IInteractionResponder
+{
+public:
+    DppInteractionResponder(dpp::cluster& bot);
+
+    void reply(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback = {}) override;
+
+    void defer(const dpp::interaction& interaction, bool ephemeral, Callback_Type callback = {}) override;
+
+    void editResponse(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback = {}) override;
+
+    void suggest(const dpp::interaction& interaction, const std::vector<std::string>& suggestions) override;
+
+private:
+    dpp::cluster& m_Bot;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Discord/MessageSink.h"
+
+/**
+ * @brief Message sink posting through the cluster REST queue, bypassing dpp::message serialization.
+ * 
+ */
+class DppMessageSink final : public IMessageSink
+{
+public:
+    DppMessageSink(dpp::cluster& bot);
+
+    void createMessage(const dpp::snowflake& channel, const std::string& body, Callback_Type onDone = nullptr) override;
+
+    void createEditableMessage(const dpp::snowflake& channel, const std::string& body, CreatedCallback_Type onCreated) override;
+
+    void editMessage(const dpp::snowflake& channel, const dpp::snowflake& message, const std::string& body, Callback_Type onDone = nullptr) override;
+
+private:
+    dpp::cluster& m_Bot;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Discord/TimerScheduler.h"
+
+/**
+ * @brief Timer scheduler using the timers of the cluster, ticking on whole seconds.
+ * 
+ */
+class DppTimerScheduler final : public ITimerScheduler
+{
+public:
+    DppTimerScheduler(dpp::cluster& bot);
+
+    dpp::timer startTimer(Callback_Type callback, uint64_t seconds) override;
+
+    void stopTimer(const dpp::timer& timer) override;
+
+private:
+    dpp::cluster& m_Bot;
+};
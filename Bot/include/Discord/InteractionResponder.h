@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+class IInteractionResponder
+{
+public:
+    using Callback_Type = dpp::command_completion_event_t;
+
+public:
+    virtual ~IInteractionResponder() = default;
+
+    /**
+     * @brief Answer an interaction with a message.
+     * 
+     * @param interaction The interaction.
+     * @param message The message.
+     * @param callback Called with the result of the request. May be empty.
+     */
+    virtual void reply(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback = {}) = 0;
+
+    /**
+     * @brief Acknowledge an interaction with a "thinking" response, to be edited later.
+     * 
+     * @param interaction The interaction.
+     * @param ephemeral true to only show the response to the user.
+     * @param callback Called with the result of the request. May be empty.
+     */
+    virtual void defer(const dpp::interaction& interaction, bool ephemeral, Callback_Type callback = {}) = 0;
+
+    /**
+     * @brief Replace the response of an interaction.
+     * 
+     * @param interaction The interaction.
+     * @param message The new response.
+     * @param callback Called with the result of the request. May be empty.
+     */
+    virtual void editResponse(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback = {}) = 0;
+
+    /**
+     * @brief Answer an autocomplete interaction.
+     * 
+     * @param interaction The interaction.
+     * @param suggestions The suggestions, used as both name and value.
+     */
+    virtual void suggest(const dpp::interaction& interaction, const std::vector<std::string>& suggestions) = 0;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include <dpp/dpp.h>
+
+class IMessageSink
+{
+public:
+    using Callback_Type = std::function<void(bool success)>;
+    using CreatedCallback_Type = std::function<void(const dpp::snowflake& message)>;
+
+public:
+    virtual ~IMessageSink() = default;
+
+    /**
+     * @brief Post an already serialized message to a channel.
+     * 
+     * @param channel The channel to post the message to.
+     * @param body The JSON body of the message create request.
+     * @param onDone Called once the request completed, with true if the message was created. May be empty.
+     */
+    virtual void createMessage(const dpp::snowflake& channel, const std::string& body, Callback_Type onDone = nullptr) = 0;
+
+    /**
+     * @brief Post an already serialized message to a channel, keeping its id to edit it later.
+     * 
+     * @param channel The channel to post the message to.
+     * @param body The JSON body of the message create request.
+     * @param onCreated Called once the request completed, with the id of the created message, 0 if it was not created.
+     */
+    virtual void createEditableMessage(const dpp::snowflake& channel, const std::string& body, CreatedCallback_Type onCreated) = 0;
+
+    /**
+     * @brief Replace the content of a message with an already serialized one.
+     * 
+     * @param channel The channel of the message.
+     * @param message The message to edit.
+     * @param body The JSON body of the message edit request.
+     * @param onDone Called once the request completed, with true if the message was edited. May be empty.
+     */
+    virtual void editMessage(const dpp::snowflake& channel, const dpp::snowflake& message, const std::string& body, Callback_Type onDone = nullptr) = 0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+#include "DTO/TimerDTO.h"
+
+/**
+ * @brief Pre-serialized message create body of a timer.
+ * 
+ * The message is serialized once, when the timer is set or updated. Only the spans of the
+ * placeholders depending on the current time ({rem:*}) are written on each fire.
+ */
+class TimerPayload
+{
+public:
+    using TimePoint_Type = TimerDTO::TimePoint_Type;
+
+    enum class Placeholder : uint8_t
+    {
+        RemainingDays,
+        RemainingHours,
+        RemainingMinutes,
+        RemainingSeconds,
+    };
+
+public:
+    TimerPayload() = default;
+
+    /**
+     * @brief Serialize a message and record the dynamic placeholders of its body.
+     * 
+     * @param message The message to serialize. Static placeholders must already be replaced.
+     * @param end The end time of the timer, used for the remaining time placeholders.
+     */
+    TimerPayload(const dpp::message& message, const TimePoint_Type& end);
+
+    /**
+     * @brief Get the request body for the given time.
+     * 
+     * @param buffer Buffer reused between calls, written only if the payload has dynamic placeholders.
+     * @param now The current time.
+     * @return const std::string& The body, either the cached one or the buffer.
+     */
+    const std::string& render(std::string& buffer, const TimePoint_Type& now) const;
+
+    /**
+     * @brief Check if the body is the same on every fire.
+     * 
+     * @return true if there is no dynamic placeholder, false otherwise.
+     */
+    inline bool isStatic() const { return m_Slots.empty(); }
+
+    /**
+     * @brief Get the placeholder token written in timer messages.
+     * 
+     * @param placeholder The placeholder.
+     * @return std::string_view The token, e.g. "{rem:days}".
+     */
+    static std::string_view GetToken(Placeholder placeholder);
+
+private:
+    struct Slot
+    {
+        size_t offset;
+        Placeholder placeholder;
+    };
+
+    std::string m_Body;
+    std::vector<Slot> m_Slots;
+    TimePoint_Type m_End;
+};
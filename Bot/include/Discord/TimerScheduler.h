@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <dpp/dpp.h>
+
+class ITimerScheduler
+{
+public:
+    using Callback_Type = std::function<void(const dpp::timer& timer)>;
+
+public:
+    virtual ~ITimerScheduler() = default;
+
+    /**
+     * @brief Start a repeating timer.
+     * 
+     * @param callback Called on each tick with the timer handle, until the timer is stopped.
+     * @param seconds The period, in seconds.
+     * @return dpp::timer The timer handle.
+     */
+    virtual dpp::timer startTimer(Callback_Type callback, uint64_t seconds) = 0;
+
+    /**
+     * @brief Stop a timer. Its callback is not called anymore once this returns, unless it is already running.
+     * 
+     * @param timer The timer handle.
+     */
+    virtual void stopTimer(const dpp::timer& timer) = 0;
+
+    /**
+     * @brief Stop several timers as one update. Stops them one by one unless the scheduler can do better.
+     * 
+     * @param timers The timer handles.
+     */
+    virtual void stopTimers(const std::vector<dpp::timer>& timers)
+    {
+        for (const auto& timer : timers)
+            stopTimer(timer);
+    }
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Cluster/ShardMap.h"
+#include "Cluster/SharedRing.h"
+#include "Discord/CountdownEditor.h"
+#include "Discord/MessageSink.h"
+#include "Discord/TimerPayload.h"
+#include "Discord/TimerScheduler.h"
+#include "Firing/TimerMutation.h"
+#include "Metrics/MetricsRegistry.h"
+#include "Time/Clock.h"
+#include "Time/TimeFormatter.h"
+
+/**
+ * @brief Fires timers in a process of its own, so that fires and interactions do not delay each other.
+ * 
+ * The command process persists the timers and sends their mutations through a shared ring. The engine starts
+ * from the persisted timers and applies the mutations as they come. Mutations are idempotent: one applied
+ * again after a reload changes nothing.
+ */
+class FiringEngine
+{
+public:
+    /**
+     * @param messageSink The sink timer messages are posted to.
+     * @param scheduler The scheduler driving the timers.
+     * @param metrics The registry fire lateness, fires and timer counts are recorded to. nullptr to record nothing.
+     * @param clock The clock deciding when timers end. nullptr for the system clock.
+     * @param shards The shards of the command process. Only the timers of their guilds are loaded.
+     */
+    FiringEngine(std::unique_ptr<IMessageSink> messageSink, std::unique_ptr<ITimerScheduler> scheduler, MetricsRegistry* metrics = nullptr,
+        const IClock* clock = nullptr, const ShardMap& shards = ShardMap());
+
+    FiringEngine(const FiringEngine&) = delete;
+
+    FiringEngine& operator=(const FiringEngine&) = delete;
+
+    /**
+     * @brief Get the name of the ring a command process sends its mutations through.
+     * 
+     * @param shards The shards of the command process.
+     * @return std::string The ring name, one per cluster.
+     */
+    static std::string GetRingName(const ShardMap& shards);
+
+    /**
+     * @brief Get the name of the ring the engine sends the countdown messages it creates through, to the command
+     * process storing them with their timers.
+     * 
+     * @param shards The shards of the command process.
+     * @return std::string The ring name, one per cluster.
+     */
+    static std::string GetReportRingName(const ShardMap& shards);
+
+    /**
+     * @brief Send the ids of the countdown messages created from now on through a ring. Each id is sent again by the
+     * next fire while the ring is full.
+     * 
+     * @param ring The producer side of the ring, nullptr to stop sending. Must outlive its use by the engine.
+     */
+    void setReportRing(SharedRing* ring);
+
+    /**
+     * @brief Replace the running timers by the persisted ones.
+     * 
+     * @throw DAOInputStreamException if there is an error reading from the input stream.
+     */
+    void reload();
+
+    /**
+     * @brief Start, restart or stop a timer.
+     * 
+     * @param mutation The mutation.
+     */
+    void apply(const TimerMutation& mutation);
+
+    /**
+     * @brief Apply the mutations waiting in a ring, after reloading the persisted timers if mutations were dropped.
+     * 
+     * @param ring The consumer side of the ring.
+     * @return size_t The number of mutations applied.
+     * 
+     * @throw DAOInputStreamException if a reload fails.
+     */
+    size_t poll(SharedRing& ring);
+
+    /**
+     * @brief Get the number of running timers.
+     */
+    size_t getTimerCount() const;
+
+private:
+    struct Entry
+    {
+        TimerDTO timer;
+        TimerPayload payload;
+        dpp::timer handle = 0;
+        // Whether the timer fires every interval yet, rather than on the next interval boundary
+        bool aligned = false;
+    };
+
+    /**
+     * @brief Instruments of the metrics registry, all nullptr without registry.
+     * 
+     */
+    struct Instruments
+    {
+        Histogram* fireLateness = nullptr;
+        Counter* fires = nullptr;
+        Counter* mutations = nullptr;
+        Gauge* activeTimers = nullptr;
+    };
+
+private:
+    // Called with m_Mutex held
+    void start_NoLock(const std::string& id, const TimerDTO& timer, TimeFormatter::Zone_Type zone);
+    void stop_NoLock(const std::string& id);
+
+    void fire(const std::string& id, const dpp::timer& handle);
+
+private:
+    ShardMap m_Shards;
+    const IClock& m_Clock;
+    Instruments m_Metrics;
+    // Mutations are applied on the polling thread and timers fire on the scheduler thread
+    mutable std::mutex m_Mutex;
+    std::unordered_map<std::string, Entry> m_Timers;
+    std::unique_ptr<IMessageSink> m_MessageSink;
+    // Messages of the edit in place timers, kept across reloads. Their ids are sent to the command process, which owns the timers
+    CountdownEditor m_CountdownEditor;
+    // nullptr when no command process is attached
+    SharedRing* m_ReportRing = nullptr;
+    // Destroyed first, no fire runs once the other members are destroyed
+    std::unique_ptr<ITimerScheduler> m_Scheduler;
+};
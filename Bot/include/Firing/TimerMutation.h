@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "DTO/TimerDTO.h"
+
+/**
+ * @brief Change of a running timer, sent by the command process to the firing engine. The engine sends back the
+ * countdown messages it creates, for the command process to store them.
+ * 
+ */
+struct TimerMutation
+{
+    enum class Type : uint8_t
+    {
+        // Start the timer, or restart it with new data
+        Upsert,
+        Remove,
+        // Sent by the engine: the message of a countdown was created
+        MessageCreated,
+    };
+
+    Type type = Type::Upsert;
+    std::string id;
+    // Name of the zone the dates of the message are displayed in. Empty for the default zone
+    std::string zone;
+    // Only for upserts
+    TimerDTO timer;
+    // Only for created messages
+    dpp::snowflake message;
+
+    /**
+     * @brief Serialize the mutation, to be decoded by another process of the same machine.
+     * 
+     * @param out Replaced by the serialized mutation, its capacity is reused.
+     */
+    void encode(std::string& out) const;
+
+    /**
+     * @brief Deserialize a mutation.
+     * 
+     * @param data The serialized mutation.
+     * @return TimerMutation The mutation.
+     * 
+     * @throw std::invalid_argument if the data is not a serialized mutation.
+     */
+    static TimerMutation Decode(std::string_view data);
+};
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <dpp/dpp.h>
+
+/**
+ * @brief A key and value of a structured log entry. Only views its value, it is copied when the entry is logged.
+ * 
+ */
+class LogField
+{
+public:
+    enum class Type : uint8_t
+    {
+        Literal,
+        Text,
+        Signed,
+        Unsigned,
+        Double,
+        Boolean
+    };
+
+public:
+    /**
+     * @param key The key. Must outlive the logger, e.g. a string literal.
+     * @param value The value.
+     */
+    LogField(const char* key, std::string_view value)
+        : m_Key(key), m_Type(Type::Text), m_Text{ value.data(), value.size() }
+    {}
+
+    LogField(const char* key, const std::string& value)
+        : LogField(key, std::string_view(value))
+    {}
+
+    LogField(const char* key, const char* value)
+        : LogField(key, std::string_view(value))
+    {}
+
+    LogField(const char* key, bool value)
+        : m_Key(key), m_Type(Type::Boolean), m_Boolean(value)
+    {}
+
+    LogField(const char* key, double value)
+        : m_Key(key), m_Type(Type::Double), m_Double(value)
+    {}
+
+    LogField(const char* key, const dpp::snowflake& value)
+        : m_Key(key), m_Type(Type::Unsigned), m_Unsigned(uint64_t(value))
+    {}
+
+    template <typename T>
+        requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+    LogField(const char* key, T value)
+    {
+        m_Key = key;
+
+        if constexpr (std::is_signed_v<T>)
+        {
+            m_Type = Type::Signed;
+            m_Signed = int64_t(value);
+        }
+        else
+        {
+            m_Type = Type::Unsigned;
+            m_Unsigned = uint64_t(value);
+        }
+    }
+
+    /**
+     * @brief Make the message of an entry, stored by pointer.
+     * 
+     * @param message The message. Must outlive the logger, e.g. a string literal.
+     */
+    static inline LogField Message(const char* message)
+    {
+        LogField field(nullptr, false);
+        field.m_Type = Type::Literal;
+        field.m_Literal = message;
+        return field;
+    }
+
+    inline const char* getKey() const { return m_Key; }
+
+    inline Type getType() const { return m_Type; }
+
+    inline const char* getLiteral() const { return m_Literal; }
+
+    inline std::string_view getText() const { return std::string_view(m_Text.data, m_Text.size); }
+
+    inline int64_t getSigned() const { return m_Signed; }
+
+    inline uint64_t getUnsigned() const { return m_Unsigned; }
+
+    inline double getDouble() const { return m_Double; }
+
+    inline bool getBoolean() const { return m_Boolean; }
+
+private:
+    // Kept trivial, so that the union needs no constructor
+    struct TextView
+    {
+        const char* data;
+        size_t size;
+    };
+
+private:
+    const char* m_Key;
+    Type m_Type;
+
+    union
+    {
+        const char* m_Literal;
+        TextView m_Text;
+        int64_t m_Signed;
+        uint64_t m_Unsigned;
+        double m_Double;
+        bool m_Boolean;
+    };
+};
+
+/**
+ * @brief Process-wide asynchronous structured logger.
+ * 
+ * The level is checked before anything is captured, so filtered entries cost one relaxed atomic load. Logged
+ * entries are captured into a ring buffer of the calling thread, without lock nor allocation unless a text is
+ * longer than TEXT_CAPACITY. A background thread formats them as "key=value" lines and writes them in batches,
+ * so the logging thread never pays for formatting nor I/O. When the ring of a thread is full, its entries are
+ * dropped and counted instead of blocking.
+ * 
+ * Nothing is logged until the logger is started.
+ */
+class Logger
+{
+public:
+    using Writer_Type = std::function<void(std::string_view lines)>;
+
+    static constexpr size_t ENTRIES_PER_THREAD = 1024;
+    // Fields of an entry, including its message
+    static constexpr size_t MAX_FIELDS = 6;
+    // Longer texts are copied to the heap
+    static constexpr size_t TEXT_CAPACITY = 40;
+
+public:
+    /**
+     * @brief Start the background thread, logging entries at or above the given level.
+     * 
+     * @param level The minimum level.
+     * @param writer Called on the background thread with batches of formatted lines. nullptr to write to the standard output.
+     */
+    static void Start(dpp::loglevel level, Writer_Type writer = nullptr);
+
+    /**
+     * @brief Stop logging, write the pending entries and join the background thread.
+     * 
+     */
+    static void Stop();
+
+    /**
+     * @brief Write the pending entries on the calling thread.
+     * 
+     */
+    static void Flush();
+
+    static inline bool IsEnabled(dpp::loglevel level) { return int(level) >= s_Level.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of entries dropped because the ring of their thread was full.
+     */
+    static uint64_t GetDroppedCount();
+
+    /**
+     * @brief Log an entry, if its level is enabled.
+     * 
+     * @param level The level.
+     * @param message The message. Must outlive the logger, e.g. a string literal.
+     * @param fields The fields, e.g. LogField("id", id).
+     */
+    template <typename... Fields>
+    static inline void Log(dpp::loglevel level, const char* message, const Fields&... fields)
+    {
+        static_assert(sizeof...(Fields) < MAX_FIELDS, "Too many log fields");
+
+        if (!IsEnabled(level))
+            return;
+
+        const LogField entry[] = { LogField::Message(message), fields... };
+        Append(level, entry, 1 + sizeof...(Fields));
+    }
+
+    /**
+     * @brief Log a preformatted message, if its level is enabled. The message is copied.
+     * 
+     * @param level The level.
+     * @param message The message.
+     */
+    static inline void Write(dpp::loglevel level, std::string_view message)
+    {
+        if (!IsEnabled(level))
+            return;
+
+        const LogField entry[] = { LogField(nullptr, message) };
+        Append(level, entry, 1);
+    }
+
+private:
+    static void Append(dpp::loglevel level, const LogField* fields, size_t count);
+
+private:
+    static std::atomic<int> s_Level;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free monotonic counter.
+ * 
+ */
+class Counter
+{
+public:
+    Counter() = default;
+
+    Counter(const Counter&) = delete;
+
+    Counter& operator=(const Counter&) = delete;
+
+    inline void increment(uint64_t value = 1) { m_Value.fetch_add(value, std::memory_order_relaxed); }
+
+    inline uint64_t get() const { return m_Value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_Value = 0;
+};
+
+/**
+ * @brief Lock-free value going up and down, e.g. a queue depth.
+ * 
+ */
+class Gauge
+{
+public:
+    Gauge() = default;
+
+    Gauge(const Gauge&) = delete;
+
+    Gauge& operator=(const Gauge&) = delete;
+
+    inline void set(int64_t value) { m_Value.store(value, std::memory_order_relaxed); }
+
+    inline void add(int64_t value) { m_Value.fetch_add(value, std::memory_order_relaxed); }
+
+    inline int64_t get() const { return m_Value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_Value = 0;
+};
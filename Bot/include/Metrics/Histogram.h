@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Lock-free log-linear histogram of unsigned values, in the manner of HdrHistogram.
+ * 
+ * Each power of two is split into SUB_BUCKET_COUNT linear buckets, so a recorded value is known within
+ * about 3% whatever its magnitude. Recording is a few relaxed atomic increments and never allocates.
+ * Values above MAX_VALUE are recorded as MAX_VALUE.
+ */
+class Histogram
+{
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+    // 2^40 ns is about 18 minutes
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_VALUE_BITS) - 1;
+    static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    /**
+     * @brief Point-in-time copy of a histogram.
+     * 
+     */
+    class Snapshot
+    {
+    public:
+        Snapshot() = default;
+
+        inline uint64_t getCount() const { return m_Count; }
+        inline uint64_t getSum() const { return m_Sum; }
+        inline uint64_t getMax() const { return m_Max; }
+
+        /**
+         * @brief Get the value below which the given fraction of the values fall.
+         * 
+         * @param quantile The fraction, between 0 and 1.
+         * @return uint64_t The upper bound of the bucket holding the quantile, 0 if the histogram is empty.
+         */
+        uint64_t getQuantile(double quantile) const;
+
+    private:
+        friend class Histogram;
+
+        std::vector<uint64_t> m_Buckets;
+        uint64_t m_Count = 0;
+        uint64_t m_Sum = 0;
+        uint64_t m_Max = 0;
+    };
+
+public:
+    Histogram() = default;
+
+    Histogram(const Histogram&) = delete;
+
+    Histogram& operator=(const Histogram&) = delete;
+
+    inline void record(uint64_t value)
+    {
+        if (value > MAX_VALUE)
+            value = MAX_VALUE;
+
+        m_Buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        m_Sum.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t max = m_Max.load(std::memory_order_relaxed);
+        while (value > max && !m_Max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Record a duration, in nanoseconds. Negative durations are recorded as 0.
+     */
+    template <typename Rep, typename Period>
+    inline void record(std::chrono::duration<Rep, Period> duration)
+    {
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        record(nanoseconds < 0 ? uint64_t(0) : uint64_t(nanoseconds));
+    }
+
+    /**
+     * @brief Copy the histogram. Values recorded during the copy may be partially included.
+     * 
+     * @return Snapshot The copy.
+     */
+    Snapshot snapshot() const;
+
+    static constexpr size_t GetBucketIndex(uint64_t value)
+    {
+        // Values below 2 * SUB_BUCKET_COUNT have a bucket each
+        unsigned shift = std::bit_width(value | (2 * SUB_BUCKET_COUNT - 1)) - SUB_BUCKET_BITS - 1;
+        return shift * SUB_BUCKET_COUNT + (value >> shift);
+    }
+
+    /**
+     * @brief Get the highest value recorded in a bucket.
+     */
+    static constexpr uint64_t GetBucketUpperBound(size_t index)
+    {
+        if (index < 2 * SUB_BUCKET_COUNT)
+            return index;
+
+        unsigned shift = unsigned(index / SUB_BUCKET_COUNT) - 1;
+        uint64_t mantissa = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_Buckets{};
+    std::atomic<uint64_t> m_Sum = 0;
+    std::atomic<uint64_t> m_Max = 0;
+};
+
+/**
+ * @brief Record the time spent in a scope into a histogram, if any.
+ * 
+ */
+class ScopedLatency
+{
+public:
+    explicit ScopedLatency(Histogram* histogram)
+        : m_Histogram(histogram), m_Start(histogram == nullptr ? std::chrono::steady_clock::time_point() : std::chrono::steady_clock::now())
+    {}
+
+    ~ScopedLatency()
+    {
+        if (m_Histogram != nullptr)
+            m_Histogram->record(std::chrono::steady_clock::now() - m_Start);
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    Histogram* m_Histogram;
+    std::chrono::steady_clock::time_point m_Start;
+};
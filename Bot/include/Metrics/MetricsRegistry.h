@@ -0,0 +1,134 @@
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Metrics/Counter.h"
+#include "Metrics/Histogram.h"
+
+/**
+ * @brief Named metrics of the bot, rendered for Prometheus and for the /stats command.
+ * 
+ * Registration takes a lock and allocates, it is done once when a component starts. The returned
+ * instruments are then recorded into directly, without lock nor allocation. Instruments live as long
+ * as the registry.
+ * 
+ * Histograms hold durations in nanoseconds and are exported in seconds.
+ */
+class MetricsRegistry
+{
+public:
+    enum class Type
+    {
+        Counter,
+        Gauge,
+        Histogram,
+    };
+
+    /**
+     * @brief Value of a metric computed when rendering.
+     */
+    struct Sample
+    {
+        std::string labels;
+        double value;
+    };
+
+    using Collector_Type = std::function<std::vector<Sample>()>;
+
+    // Quantiles exported for each histogram
+    static constexpr double QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+
+public:
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Get a counter, registering it on first use.
+     * 
+     * @param name The metric name.
+     * @param help The description of the metric.
+     * @param labels The labels of this instrument, as made by Labels(). Empty for none.
+     * @return Counter& The counter.
+     * 
+     * @throw std::invalid_argument if the name is registered with another type.
+     */
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    /**
+     * @brief Get a gauge, registering it on first use.
+     * 
+     * @throw std::invalid_argument if the name is registered with another type.
+     */
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    /**
+     * @brief Get a duration histogram, registering it on first use.
+     * 
+     * @throw std::invalid_argument if the name is registered with another type.
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    /**
+     * @brief Register values computed when rendering, e.g. statistics a component already keeps.
+     * 
+     * @param name The metric name.
+     * @param help The description of the metric.
+     * @param type Type::Counter or Type::Gauge.
+     * @param collector The function computing the samples. Called under the registry lock.
+     * 
+     * @throw std::invalid_argument if the type is Type::Histogram, or if the name is registered with another type.
+     */
+    void addCollector(const std::string& name, const std::string& help, Type type, Collector_Type collector);
+
+    /**
+     * @brief Render all metrics in the Prometheus text exposition format.
+     * 
+     * @return std::string The metrics.
+     */
+    std::string renderPrometheus() const;
+
+    /**
+     * @brief Render all metrics in a compact human readable form, one line per instrument.
+     * 
+     * @return std::string The metrics.
+     */
+    std::string renderSummary() const;
+
+    /**
+     * @brief Format labels for registration, escaping the values.
+     * 
+     * @param labels The label names and values.
+     * @return std::string The labels, e.g. command="timer",subcommand="set".
+     */
+    static std::string Labels(std::initializer_list<std::pair<std::string_view, std::string_view>> labels);
+
+private:
+    struct Family
+    {
+        std::string help;
+        Type type;
+        // Keyed by labels
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+        std::vector<Collector_Type> collectors;
+    };
+
+private:
+    Family& getFamily_NoLock(const std::string& name, const std::string& help, Type type);
+
+private:
+    std::map<std::string, Family> m_Families;
+    mutable std::mutex m_Mutex;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "Metrics/MetricsRegistry.h"
+
+/**
+ * @brief Minimal HTTP endpoint serving the metrics in the Prometheus text format on localhost.
+ * 
+ * Answers GET /metrics, one connection at a time, on its own thread. Scrapes are rare and small, the
+ * endpoint is only meant for a local Prometheus agent.
+ */
+class PrometheusExporter
+{
+public:
+    /**
+     * @param registry The metrics to serve.
+     * @param port The port to listen on, bound to 127.0.0.1 only. 0 for any free port.
+     * 
+     * @throw std::runtime_error if the port can not be bound.
+     */
+    PrometheusExporter(const MetricsRegistry& registry, uint16_t port);
+
+    /**
+     * @brief Stop listening and join the serving thread.
+     * 
+     */
+    ~PrometheusExporter();
+
+    PrometheusExporter(const PrometheusExporter&) = delete;
+
+    PrometheusExporter& operator=(const PrometheusExporter&) = delete;
+
+    /**
+     * @brief Get the port the endpoint listens on.
+     */
+    inline uint16_t getPort() const { return m_Port; }
+
+private:
+    void run();
+
+    void serve(intptr_t client) const;
+
+private:
+    const MetricsRegistry& m_Registry;
+    intptr_t m_Socket;
+    uint16_t m_Port;
+    std::atomic<bool> m_Running = true;
+    std::thread m_Thread;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Metrics/MetricsRegistry.h"
+
+/**
+ * @brief Timeline of the startup phases of the bot, from process start to fully serving.
+ * 
+ * Phases are recorded from any thread and may overlap, e.g. controllers initializing in parallel.
+ */
+class StartupProfile
+{
+public:
+    using Clock_Type = std::chrono::steady_clock;
+
+    struct Phase
+    {
+        std::string name;
+        // Offset from the origin of the profile
+        Clock_Type::duration start;
+        Clock_Type::duration duration;
+    };
+
+public:
+    /**
+     * @brief Start the profile, its origin being now.
+     * 
+     */
+    StartupProfile();
+
+    StartupProfile(const StartupProfile&) = delete;
+
+    StartupProfile& operator=(const StartupProfile&) = delete;
+
+    /**
+     * @brief Record a completed phase.
+     * 
+     * @param name The phase name.
+     * @param start When the phase started.
+     * @param end When the phase ended.
+     */
+    void record(const std::string& name, Clock_Type::time_point start, Clock_Type::time_point end);
+
+    /**
+     * @brief Record a milestone, a phase without duration ending now.
+     * 
+     * @param name The milestone name.
+     */
+    void mark(const std::string& name);
+
+    /**
+     * @brief Get the recorded phases, by start.
+     * 
+     * @return std::vector<Phase> The phases.
+     */
+    std::vector<Phase> getPhases() const;
+
+    /**
+     * @brief Get the time elapsed since the origin.
+     */
+    Clock_Type::duration getElapsed() const;
+
+    /**
+     * @brief Render the phases as a table, one line per phase with its start offset and duration.
+     * 
+     * @return std::string The report.
+     */
+    std::string render() const;
+
+    /**
+     * @brief Export the duration and end of each phase, as the bot_startup_phase_seconds and bot_startup_phase_end_seconds
+     * gauges. The profile must outlive the registry.
+     * 
+     * @param registry The registry.
+     */
+    void exportTo(MetricsRegistry& registry) const;
+
+private:
+    Clock_Type::time_point m_Origin;
+    mutable std::mutex m_Mutex;
+    std::vector<Phase> m_Phases;
+};
+
+/**
+ * @brief Record the time spent in a scope as a startup phase, if there is a profile.
+ * 
+ */
+class StartupPhase
+{
+public:
+    /**
+     * @param profile The profile. nullptr to record nothing.
+     * @param name The phase name.
+     */
+    StartupPhase(StartupProfile* profile, std::string name);
+
+    ~StartupPhase();
+
+    StartupPhase(const StartupPhase&) = delete;
+
+    StartupPhase& operator=(const StartupPhase&) = delete;
+
+private:
+    StartupProfile* m_Profile;
+    std::string m_Name;
+    StartupProfile::Clock_Type::time_point m_Start;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Controllers/CommandRouter.h"
+#include "Simulation/SimulatedRestApi.h"
+
+/**
+ * @brief Local stand-in for the Discord gateway, dispatching synthetic interactions to a router.
+ * 
+ * The router must answer through the simulated REST API for the answers to be measured.
+ */
+class SimulatedGateway
+{
+public:
+    using Option_Type = std::pair<std::string, dpp::command_value>;
+
+    /**
+     * @brief Where an interaction comes from.
+     * 
+     */
+    struct Invoker
+    {
+        dpp::snowflake user;
+        dpp::snowflake guild;
+        dpp::snowflake channel;
+    };
+
+public:
+    /**
+     * @param router The router interactions are dispatched to.
+     * @param api The API the router answers through.
+     */
+    SimulatedGateway(CommandRouter& router, SimulatedRestApi& api);
+
+    /**
+     * @brief Dispatch a slash command. Unknown commands are answered like the bot does.
+     * 
+     * @param invoker Where the command comes from.
+     * @param command The command name.
+     * @param subcommand The subcommand name, empty for none.
+     * @param options The options of the (sub)command.
+     * @return dpp::snowflake The interaction id.
+     */
+    dpp::snowflake sendCommand(const Invoker& invoker, const std::string& command, const std::string& subcommand, const std::vector<Option_Type>& options = {});
+
+    /**
+     * @brief Dispatch an autocomplete interaction.
+     * 
+     * @param invoker Where the interaction comes from.
+     * @param command The command name.
+     * @param subcommand The subcommand name, empty for none.
+     * @param option The name of the option being typed.
+     * @param typed What was typed so far.
+     * @return true if a route handled it, false otherwise.
+     */
+    bool sendAutocomplete(const Invoker& invoker, const std::string& command, const std::string& subcommand, const std::string& option, const std::string& typed);
+
+    inline uint64_t getDispatchedCount() const { return m_NextId.load(std::memory_order_relaxed) - 1; }
+
+private:
+    dpp::interaction createInteraction(const Invoker& invoker);
+
+    static dpp::command_data_option CreateOption(const std::string& name, const dpp::command_value& value);
+
+private:
+    CommandRouter& m_Router;
+    SimulatedRestApi& m_Api;
+    std::atomic<uint64_t> m_NextId = 1;
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "Discord/InteractionResponder.h"
+#include "Discord/MessageSink.h"
+#include "Metrics/Histogram.h"
+
+/**
+ * @brief Local stand-in for the Discord REST API, counting the requests instead of sending them.
+ * 
+ * Answers interactions, creates and edits messages, every request succeeding. Without latency, requests complete
+ * on the calling thread. With a latency, they complete in order on a delivery thread.
+ * 
+ * The time to answer of an interaction is measured from the moment the gateway dispatched it to its
+ * first reply or response edit.
+ */
+class SimulatedRestApi final : public IInteractionResponder
+{
+public:
+    struct Stats
+    {
+        uint64_t replies = 0;
+        uint64_t deferrals = 0;
+        uint64_t edits = 0;
+        uint64_t suggestions = 0;
+        uint64_t messages = 0;
+        uint64_t messageBytes = 0;
+        uint64_t messageEdits = 0;
+    };
+
+public:
+    /**
+     * @param latency Delay before each request completes. 0 to complete requests on the calling thread.
+     * @param keepResponses true to keep the last response of each interaction, for getResponse.
+     */
+    SimulatedRestApi(std::chrono::microseconds latency = std::chrono::microseconds(0), bool keepResponses = true);
+
+    /**
+     * @brief Complete the pending requests and stop the delivery thread.
+     * 
+     */
+    ~SimulatedRestApi();
+
+    SimulatedRestApi(const SimulatedRestApi&) = delete;
+
+    SimulatedRestApi& operator=(const SimulatedRestApi&) = delete;
+
+    void reply(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback = {}) override;
+
+    void defer(const dpp::interaction& interaction, bool ephemeral, Callback_Type callback = {}) override;
+
+    void editResponse(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback = {}) override;
+
+    void suggest(const dpp::interaction& interaction, const std::vector<std::string>& suggestions) override;
+
+    /**
+     * @brief Create a message sink posting to this API. The sink must not outlive the API.
+     * 
+     * @return std::unique_ptr<IMessageSink> The sink.
+     */
+    std::unique_ptr<IMessageSink> createMessageSink();
+
+    /**
+     * @brief Start measuring the time to answer of an interaction. Called by the gateway.
+     * 
+     * @param interaction The interaction id.
+     */
+    void onDispatched(const dpp::snowflake& interaction);
+
+    /**
+     * @brief Wait until every request made so far completed.
+     * 
+     */
+    void drain();
+
+    Stats getStats() const;
+
+    /**
+     * @brief Get the last response to an interaction, reply or edit.
+     * 
+     * @param interaction The interaction id.
+     * @return std::string The content of the response, empty if there is none or responses are not kept.
+     */
+    std::string getResponse(const dpp::snowflake& interaction) const;
+
+    /**
+     * @brief Get the number of dispatched interactions not answered yet, deferred ones included.
+     */
+    size_t getUnansweredCount() const;
+
+    /**
+     * @brief Get the time to answer of the interactions, in nanoseconds.
+     */
+    inline Histogram::Snapshot getResponseLatency() const { return m_ResponseLatency.snapshot(); }
+
+private:
+    class MessageSink;
+
+    struct Request
+    {
+        std::chrono::steady_clock::time_point deadline;
+        std::function<void()> action;
+    };
+
+private:
+    void onAnswered(const dpp::interaction& interaction, const dpp::message& message);
+
+    /**
+     * @brief Complete a request, now or after the latency.
+     * 
+     * @param action Called once the request completed.
+     */
+    void deliver(std::function<void()> action);
+
+    /**
+     * @brief Complete an interaction request successfully.
+     * 
+     * @param callback The callback of the request. May be empty.
+     */
+    void respond(Callback_Type callback);
+
+    void serve();
+
+private:
+    std::chrono::microseconds m_Latency;
+    bool m_KeepResponses;
+
+    std::atomic<uint64_t> m_Replies = 0;
+    std::atomic<uint64_t> m_Deferrals = 0;
+    std::atomic<uint64_t> m_Edits = 0;
+    std::atomic<uint64_t> m_Suggestions = 0;
+    std::atomic<uint64_t> m_Messages = 0;
+    std::atomic<uint64_t> m_MessageBytes = 0;
+    std::atomic<uint64_t> m_MessageEdits = 0;
+    // Ids of the created messages
+    std::atomic<uint64_t> m_NextMessage = 1;
+
+    mutable std::mutex m_InteractionsMutex;
+    std::unordered_map<dpp::snowflake, std::chrono::steady_clock::time_point> m_Dispatched;
+    std::unordered_map<dpp::snowflake, std::string> m_Responses;
+    Histogram m_ResponseLatency;
+
+    std::mutex m_RequestsMutex;
+    std::condition_variable m_RequestsCondition;
+    std::condition_variable m_DrainedCondition;
+    std::deque<Request> m_Requests;
+    size_t m_InFlight = 0;
+    bool m_Stopping = false;
+    std::thread m_Thread;
+};
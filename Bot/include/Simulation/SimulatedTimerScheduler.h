@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Discord/TimerScheduler.h"
+#include "Time/VirtualClock.h"
+
+/**
+ * @brief Timer scheduler running on a virtual clock, for tests and load generation.
+ * 
+ * Nothing fires on its own: advance() moves the virtual clock and runs the callbacks of the timers due
+ * meanwhile, in due order, on the calling thread. Callbacks may start and stop timers.
+ * 
+ * Time does not pass between fires, a simulated month runs as fast as its callbacks.
+ */
+class SimulatedTimerScheduler final : public ITimerScheduler
+{
+public:
+    /**
+     * @param clock The clock moved along with the scheduler, set to the due time of each fire before its callback runs. May be nullptr.
+     */
+    SimulatedTimerScheduler(VirtualClock* clock = nullptr);
+
+    dpp::timer startTimer(Callback_Type callback, uint64_t seconds) override;
+
+    void stopTimer(const dpp::timer& timer) override;
+
+    /**
+     * @brief Stop several timers under a single lock.
+     * 
+     */
+    void stopTimers(const std::vector<dpp::timer>& timers) override;
+
+    /**
+     * @brief Move the virtual clock forward, firing the timers due until then.
+     * 
+     * @param seconds How far to move the clock.
+     * @return size_t The number of callbacks run.
+     */
+    size_t advance(uint64_t seconds);
+
+    /**
+     * @brief Get the virtual time, in seconds since the scheduler was created.
+     */
+    uint64_t getNow() const;
+
+    /**
+     * @brief Get the number of running timers.
+     */
+    size_t getTimerCount() const;
+
+private:
+    /**
+     * @brief Move the virtual time forward, along with the clock. m_Mutex must be held by the caller.
+     * 
+     * @param time The new time, in seconds since the scheduler was created.
+     */
+    void moveTo_NoLock(uint64_t time);
+
+private:
+    struct Entry
+    {
+        // Shared, so that firing does not copy the callback and its captures
+        std::shared_ptr<const Callback_Type> callback;
+        uint64_t period;
+    };
+
+    // Due time and timer, ties fire in start order
+    using Fire_Type = std::pair<uint64_t, dpp::timer>;
+
+private:
+    VirtualClock* m_Clock;
+    mutable std::mutex m_Mutex;
+    uint64_t m_Now = 0;
+    dpp::timer m_NextTimer = 1;
+    std::unordered_map<dpp::timer, Entry> m_Timers;
+    // Pending fires, earliest first. Fires of stopped timers are dropped when reached
+    std::priority_queue<Fire_Type, std::vector<Fire_Type>, std::greater<Fire_Type>> m_Queue;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Discord/TimerScheduler.h"
+
+/**
+ * @brief Timer scheduler running the callbacks on its own thread, with no cluster.
+ * 
+ * Unlike the cluster timers, fires are not rounded to whole seconds: each one is due exactly one period after the
+ * previous due time, so a late fire does not delay the next ones.
+ */
+class ThreadTimerScheduler final : public ITimerScheduler
+{
+public:
+    ThreadTimerScheduler();
+
+    /**
+     * @brief Stop the thread. Callbacks are not called anymore once this returns.
+     * 
+     */
+    ~ThreadTimerScheduler();
+
+    ThreadTimerScheduler(const ThreadTimerScheduler&) = delete;
+
+    ThreadTimerScheduler& operator=(const ThreadTimerScheduler&) = delete;
+
+    dpp::timer startTimer(Callback_Type callback, uint64_t seconds) override;
+
+    void stopTimer(const dpp::timer& timer) override;
+
+    /**
+     * @brief Stop several timers under a single lock.
+     * 
+     */
+    void stopTimers(const std::vector<dpp::timer>& timers) override;
+
+    /**
+     * @brief Get the number of running timers.
+     */
+    size_t getTimerCount() const;
+
+private:
+    using Clock_Type = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        // Shared, so that firing does not copy the callback and its captures
+        std::shared_ptr<const Callback_Type> callback;
+        Clock_Type::duration period;
+    };
+
+    // Due time and timer, ties fire in start order
+    using Fire_Type = std::pair<Clock_Type::time_point, dpp::timer>;
+
+private:
+    void run();
+
+private:
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    bool m_Stopping = false;
+    dpp::timer m_NextTimer = 1;
+    std::unordered_map<dpp::timer, Entry> m_Timers;
+    // Pending fires, earliest first. Fires of stopped timers are dropped when reached
+    std::priority_queue<Fire_Type, std::vector<Fire_Type>, std::greater<Fire_Type>> m_Queue;
+    // Started last, once the members it uses exist
+    std::thread m_Thread;
+};
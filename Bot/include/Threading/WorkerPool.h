@@ -0,0 +1,125 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Bounded pool of worker threads.
+ * 
+ * Tasks submitted with the same key run one at a time, in submission order. Tasks with different keys,
+ * or without key, run concurrently.
+ */
+class WorkerPool
+{
+public:
+    using Task_Type = std::function<void()>;
+
+    /**
+     * @brief Awaitable resuming the awaiting coroutine on the pool.
+     * 
+     * The coroutine holds its key until its next suspension point, so the code it runs before suspending
+     * is ordered with the other tasks of the key.
+     */
+    class ScheduleAwaitable
+    {
+    public:
+        ScheduleAwaitable(WorkerPool& pool, std::string key);
+
+        inline bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        /**
+         * @throw std::runtime_error if the pool was full.
+         */
+        void await_resume() const;
+
+    private:
+        WorkerPool& m_Pool;
+        std::string m_Key;
+        bool m_Accepted = true;
+    };
+
+public:
+    /**
+     * @param threadCount The number of worker threads.
+     * @param capacity The maximum number of tasks waiting or running. Submissions beyond are rejected.
+     */
+    WorkerPool(size_t threadCount, size_t capacity);
+
+    /**
+     * @brief Run the remaining tasks, then join the workers.
+     * 
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Submit a task without ordering constraint.
+     * 
+     * @param task The task.
+     * @return true if the task was queued, false if the pool is full.
+     */
+    bool submit(Task_Type task);
+
+    /**
+     * @brief Submit a task running after every task previously submitted with the same key.
+     * 
+     * @param key The serialization key.
+     * @param task The task.
+     * @return true if the task was queued, false if the pool is full.
+     */
+    bool submit(const std::string& key, Task_Type task);
+
+    /**
+     * @brief Resume the awaiting coroutine on a worker, without ordering constraint.
+     * 
+     * @return ScheduleAwaitable The awaitable. Throws std::runtime_error on resumption if the pool is full.
+     */
+    ScheduleAwaitable schedule();
+
+    /**
+     * @brief Resume the awaiting coroutine on a worker, after every task previously submitted with the same key.
+     * 
+     * @param key The serialization key.
+     * @return ScheduleAwaitable The awaitable. Throws std::runtime_error on resumption if the pool is full.
+     */
+    ScheduleAwaitable schedule(std::string key);
+
+    /**
+     * @brief Get the number of tasks waiting or running.
+     * 
+     * @return size_t The number of tasks.
+     */
+    size_t getPendingCount() const;
+
+private:
+    struct Job
+    {
+        Task_Type task; // Empty for keyed jobs, whose task is the front of their strand
+        std::string key;
+    };
+
+private:
+    void work();
+
+private:
+    std::vector<std::thread> m_Threads;
+    std::deque<Job> m_Ready;
+    std::unordered_map<std::string, std::deque<Task_Type>> m_Strands;
+    size_t m_Capacity;
+    size_t m_Pending = 0;
+    bool m_Stopping = false;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+};
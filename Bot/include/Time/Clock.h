@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+
+class IClock
+{
+public:
+    using TimePoint_Type = std::chrono::time_point<std::chrono::system_clock>;
+
+public:
+    virtual ~IClock() = default;
+
+    /**
+     * @brief Get the current time.
+     * 
+     * @return TimePoint_Type The current time.
+     */
+    virtual TimePoint_Type now() const = 0;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Time/Clock.h"
+
+/**
+ * @brief Clock reading the wall clock of the system.
+ * 
+ */
+class SystemClock final : public IClock
+{
+public:
+    TimePoint_Type now() const override;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Thread-safe formatting of time points in the format "dd/mm/YYYY hh:mm:ss".
+ * 
+ * Each thread caches the formatted strings per (zone, second) and the last offset of each zone,
+ * so formatting a recently seen second only costs a table lookup and a copy.
+ */
+class TimeFormatter
+{
+public:
+    using TimePoint_Type = std::chrono::time_point<std::chrono::system_clock>;
+    using Zone_Type = const std::chrono::time_zone*;
+
+    static constexpr size_t FORMATTED_SIZE = 19;
+    using Buffer_Type = std::array<char, FORMATTED_SIZE>;
+
+public:
+
+    /**
+     * @brief Format a time in the given zone into a caller-provided buffer. Years are written on four digits.
+     * 
+     * @param time The time to format.
+     * @param zone The time zone. nullptr for the default zone.
+     * @param buffer The buffer to write to.
+     * @return std::string_view A view on the buffer.
+     */
+    static std::string_view Format(const TimePoint_Type& time, Zone_Type zone, Buffer_Type& buffer);
+
+    /**
+     * @brief Format a time in the given zone.
+     * 
+     * @param time The time to format.
+     * @param zone The time zone. nullptr for the default zone.
+     * @return std::string The formatted time.
+     */
+    static std::string Format(const TimePoint_Type& time, Zone_Type zone);
+
+    /**
+     * @brief Get the zone used when no zone is configured: the host zone, or UTC if it cannot be determined.
+     * 
+     * @return Zone_Type The default zone.
+     */
+    static Zone_Type GetDefaultZone();
+
+    /**
+     * @brief Find a zone of the time zone database by name, e.g. "Europe/Paris".
+     * 
+     * @param name The zone name.
+     * @return Zone_Type The zone, or nullptr if there is no zone with this name.
+     */
+    static Zone_Type LocateZone(std::string_view name);
+};
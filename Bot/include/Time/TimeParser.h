@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+
+#include "Time/TimeFormatter.h"
+
+/**
+ * @brief Allocation-free parsing of user provided times and intervals.
+ * 
+ * Parsing failures are reported with ParsingException, the only case allocating memory.
+ */
+class TimeParser
+{
+public:
+    using TimePoint_Type = std::chrono::time_point<std::chrono::system_clock>;
+
+public:
+
+    /**
+     * @brief Parse a time string in the format "dd/mm/yyyy hh:mm:ss".
+     * 
+     * Out of range fields are normalized (e.g. 32/01 is 01/02), and trailing characters are ignored.
+     * 
+     * @param time The time string.
+     * @param zone The zone the time is expressed in. nullptr for the default zone.
+     * @return TimePoint_Type The parsed time.
+     * 
+     * @throw ParsingException if the time string is invalid.
+     */
+    static TimePoint_Type ParseTime(std::string_view time, TimeFormatter::Zone_Type zone = nullptr);
+
+    /**
+     * @brief Parse an interval string in the format "0d 0h 0m 0s". Units must be in descending order.
+     * 
+     * @param interval The interval string.
+     * @return int64_t The parsed interval in seconds.
+     * 
+     * @throw ParsingException if the interval string is invalid.
+     */
+    static int64_t ParseInterval(std::string_view interval);
+};
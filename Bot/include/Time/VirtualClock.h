@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+
+#include "Time/Clock.h"
+
+/**
+ * @brief Clock only moving when told to, for simulations and reproducible benchmarks.
+ * 
+ * Thread-safe: the time can be read while another thread advances it.
+ */
+class VirtualClock final : public IClock
+{
+public:
+    /**
+     * @param start The initial time.
+     */
+    VirtualClock(const TimePoint_Type& start);
+
+    TimePoint_Type now() const override;
+
+    /**
+     * @brief Move the clock forward.
+     * 
+     * @param duration How far to move the clock. Negative durations are ignored.
+     */
+    void advance(std::chrono::nanoseconds duration);
+
+private:
+    std::atomic<TimePoint_Type::rep> m_Now;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Process-wide recorder of trace spans, exported in the Chrome trace event format.
+ * 
+ * Each thread records into its own ring buffer, keeping its most recent EVENTS_PER_THREAD spans. Recording
+ * takes no lock and never allocates once the buffer of the thread exists. Exporting can run while threads
+ * record, spans overwritten during the export are skipped.
+ * 
+ * Tracing is off by default. While off, a span costs one relaxed atomic load.
+ */
+class Tracer
+{
+public:
+    static constexpr size_t EVENTS_PER_THREAD = 8192;
+
+public:
+    /**
+     * @brief Start or stop recording. Stopping keeps the recorded spans for export.
+     * 
+     * @param enabled true to record spans.
+     */
+    static void SetEnabled(bool enabled);
+
+    static inline bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Drop every recorded span.
+     * 
+     */
+    static void Clear();
+
+    /**
+     * @brief Export the recorded spans as Chrome trace JSON, readable by chrome://tracing and Perfetto.
+     * 
+     * @return std::string The trace.
+     */
+    static std::string ExportChromeTrace();
+
+    /**
+     * @brief Record a completed span on the calling thread.
+     * 
+     * @param name The span name. Must outlive the tracer, e.g. a string literal.
+     * @param start The start, in nanoseconds since the tracer epoch.
+     * @param duration The duration, in nanoseconds.
+     */
+    static void Record(const char* name, int64_t start, int64_t duration);
+
+    /**
+     * @brief Get the current time, in nanoseconds since the tracer epoch.
+     */
+    static int64_t Now();
+
+private:
+    static std::atomic<bool> s_Enabled;
+};
+
+/**
+ * @brief Record the time spent in a scope as a trace span, when tracing is enabled.
+ * 
+ */
+class TraceSpan
+{
+public:
+    /**
+     * @param name The span name. Must outlive the tracer, e.g. a string literal.
+     */
+    explicit TraceSpan(const char* name)
+        : m_Name(name), m_Start(Tracer::IsEnabled() ? Tracer::Now() : -1)
+    {}
+
+    ~TraceSpan()
+    {
+        if (m_Start >= 0)
+            Tracer::Record(m_Name, m_Start, Tracer::Now() - m_Start);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* m_Name;
+    int64_t m_Start;
+};
@@ -0,0 +1,322 @@
+/**
+ * Load generator replaying synthetic traffic against the controllers, on a simulated Discord.
+ * 
+ * Usage: BotLoadTest [--timers=N] [--commands=N] [--rate=N] [--users=N] [--guilds=N] [--threads=N] [--latency-us=N] [--simulate=N]
+ *   --timers      Timers stored before the controllers initialize.
+ *   --commands    Slash commands sent.
+ *   --rate        Commands per second, 0 to send as fast as possible.
+ *   --users       Distinct users sending the commands.
+ *   --guilds      Distinct guilds the timers and commands belong to.
+ *   --threads     Worker pool threads.
+ *   --latency-us  Latency of every simulated REST request.
+ *   --simulate    Virtual seconds of timer fires simulated after the commands, e.g. 2592000 for a month.
+ * 
+ * Runs in a scratch directory, the stored timers never touch the data directory of the bot. Timers run on a
+ * virtual clock starting at a fixed date, so two runs with the same options fire the same messages.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "Controllers/PingController.h"
+#include "Controllers/TimerController.h"
+#include "Metrics/MetricsRegistry.h"
+#include "Metrics/StartupProfile.h"
+#include "Simulation/SimulatedGateway.h"
+#include "Simulation/SimulatedRestApi.h"
+#include "Simulation/SimulatedTimerScheduler.h"
+#include "Threading/WorkerPool.h"
+#include "Time/VirtualClock.h"
+
+using Clock_Type = std::chrono::steady_clock;
+
+// How long the commands may take to be answered once all are sent
+static constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(60);
+
+// Start of the virtual clock
+static constexpr auto SIMULATION_START = std::chrono::sys_days(std::chrono::year(2024) / 1 / 1);
+
+// Lifetime of the stored timers, long enough for a simulated month
+static constexpr auto TIMER_LIFETIME = std::chrono::days(31);
+
+struct Options
+{
+    uint64_t timers = 100000;
+    uint64_t commands = 20000;
+    uint64_t rate = 2000;
+    uint64_t users = 5000;
+    uint64_t guilds = 500;
+    uint64_t threads = std::max(2u, std::thread::hardware_concurrency());
+    uint64_t latencyUs = 0;
+    uint64_t simulate = 3600;
+};
+
+/**
+ * @brief Parse the command line options.
+ * 
+ * @throw std::invalid_argument if an option is unknown or its value is not a number.
+ */
+static Options ParseOptions(int argc, char** argv)
+{
+    Options options;
+
+    std::map<std::string, uint64_t*> fields = {
+        { "--timers", &options.timers },
+        { "--commands", &options.commands },
+        { "--rate", &options.rate },
+        { "--users", &options.users },
+        { "--guilds", &options.guilds },
+        { "--threads", &options.threads },
+        { "--latency-us", &options.latencyUs },
+        { "--simulate", &options.simulate },
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        auto separator = argument.find('=');
+        auto field = fields.find(argument.substr(0, separator));
+
+        if (separator == std::string::npos || field == fields.end())
+            throw std::invalid_argument("Unknown option: " + argument);
+
+        *field->second = std::stoull(argument.substr(separator + 1));
+    }
+
+    options.users = std::max<uint64_t>(options.users, 1);
+    options.guilds = std::max<uint64_t>(options.guilds, 1);
+    options.threads = std::max<uint64_t>(options.threads, 1);
+
+    return options;
+}
+
+/**
+ * @brief Run inside a scratch directory, the DAOs writing to "data" relative to the working directory.
+ * 
+ */
+class ScratchDirectory
+{
+public:
+    ScratchDirectory()
+        : m_Previous(std::filesystem::current_path()),
+        m_Path(std::filesystem::temp_directory_path() / "BotLoadTest")
+    {
+        std::filesystem::remove_all(m_Path);
+        std::filesystem::create_directories(m_Path / "data/timers");
+        std::filesystem::current_path(m_Path);
+    }
+
+    ~ScratchDirectory()
+    {
+        std::filesystem::current_path(m_Previous);
+        std::filesystem::remove_all(m_Path);
+    }
+
+private:
+    std::filesystem::path m_Previous;
+    std::filesystem::path m_Path;
+};
+
+static dpp::snowflake GetGuild(uint64_t i, const Options& options)
+{
+    return dpp::snowflake(100000 + i % options.guilds);
+}
+
+static void StoreTimers(const Options& options, const IClock& clock)
+{
+    auto now = clock.now();
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int64_t> interval(60, 3600);
+
+    TimerDAO dao;
+
+    for (uint64_t i = 0; i < options.timers; ++i)
+    {
+        TimerDTO timer("stored_" + std::to_string(i), dpp::snowflake(200000 + i), interval(random),
+            "{name}: {rem:days}d {rem:hours}h left", now, now + TIMER_LIFETIME, "", "", GetGuild(i, options));
+
+        dao.add(timer.getName(), timer);
+    }
+}
+
+static double GetSeconds(Clock_Type::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+static void PrintLatency(const char* name, const Histogram::Snapshot& latency)
+{
+    std::printf("  %-22s count %llu, p50 %.3f ms, p99 %.3f ms, p99.9 %.3f ms, max %.3f ms\n", name,
+        (unsigned long long)latency.getCount(),
+        latency.getQuantile(0.5) / 1e6, latency.getQuantile(0.99) / 1e6, latency.getQuantile(0.999) / 1e6, latency.getMax() / 1e6);
+}
+
+/**
+ * @brief Send a random command, in the mix of a busy bot: mostly reads, some writes, rare errors.
+ * 
+ */
+static void SendCommand(SimulatedGateway& gateway, const IClock& clock, std::mt19937_64& random, uint64_t i, const Options& options)
+{
+    uint64_t user = random() % options.users;
+    SimulatedGateway::Invoker invoker{ dpp::snowflake(300000 + user), GetGuild(user, options), dpp::snowflake(400000 + user) };
+
+    std::string stored = "stored_" + std::to_string(options.timers == 0 ? 0 : user % options.timers);
+    std::string created = "load_" + std::to_string(i);
+
+    switch (random() % 20)
+    {
+    case 0: case 1: case 2: case 3: case 4: case 5:
+        gateway.sendCommand(invoker, "timer", "list");
+        break;
+    case 6: case 7: case 8:
+        gateway.sendAutocomplete(invoker, "timer", "trigger", "name", "stored_1");
+        break;
+    case 9: case 10: case 11:
+        gateway.sendCommand(invoker, "timer", "set", {
+            { "name", created },
+            { "interval", std::string("1h") },
+            { "message", std::string("Load {name}") },
+            { "end", TimerController::GetFormattedTime(clock.now() + std::chrono::hours(24)) },
+        });
+        break;
+    case 12: case 13:
+        gateway.sendCommand(invoker, "timer", "trigger", { { "name", stored } });
+        break;
+    case 14:
+        gateway.sendCommand(invoker, "timer", "update", { { "name", stored }, { "message", std::string("Updated {name}") } });
+        break;
+    case 15:
+        gateway.sendCommand(invoker, "timer", "stop", { { "name", "load_" + std::to_string(i / 2) } });
+        break;
+    case 16:
+        gateway.sendCommand(invoker, "timer", "set", { { "name", created }, { "interval", std::string("bogus") } });
+        break;
+    default:
+        gateway.sendCommand(invoker, "ping", "");
+        break;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    try
+    {
+        options = ParseOptions(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    ScratchDirectory directory;
+
+    std::printf("Storing %llu timers in %llu guilds\n", (unsigned long long)options.timers, (unsigned long long)options.guilds);
+    VirtualClock clock(SIMULATION_START);
+    StoreTimers(options, clock);
+
+    dpp::cluster bot("simulated");
+    MetricsRegistry metrics;
+    SimulatedRestApi api(std::chrono::microseconds(options.latencyUs), false);
+
+    auto timerScheduler = std::make_unique<SimulatedTimerScheduler>(&clock);
+    auto& scheduler = *timerScheduler;
+
+    std::vector<std::unique_ptr<Controller>> controllers;
+    controllers.push_back(std::make_unique<PingController>(bot));
+    controllers.push_back(std::make_unique<TimerController>(bot, api.createMessageSink(), std::move(timerScheduler), &metrics, &clock));
+
+    WorkerPool workerPool(options.threads, 1024);
+    CommandRouter router(&workerPool, &metrics, &api);
+    SimulatedGateway gateway(router, api);
+
+    auto initStart = Clock_Type::now();
+    StartupProfile startup;
+
+    Controller::InitAll(controllers, &startup);
+
+    for (const auto& controller : controllers)
+        controller->registerRoutes(router);
+
+    auto initDuration = Clock_Type::now() - initStart;
+    size_t initTimers = scheduler.getTimerCount();
+
+    // ----- Commands -----
+
+    std::mt19937_64 random(7);
+    auto commandsStart = Clock_Type::now();
+
+    for (uint64_t i = 0; i < options.commands; ++i)
+    {
+        if (options.rate > 0)
+            std::this_thread::sleep_until(commandsStart + std::chrono::nanoseconds(i * 1000000000 / options.rate));
+
+        SendCommand(gateway, clock, random, i, options);
+    }
+
+    auto sendDuration = Clock_Type::now() - commandsStart;
+    auto drainDeadline = Clock_Type::now() + DRAIN_TIMEOUT;
+
+    while ((api.getUnansweredCount() > 0 || workerPool.getPendingCount() > 0) && Clock_Type::now() < drainDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    api.drain();
+
+    auto commandsDuration = Clock_Type::now() - commandsStart;
+    auto commandStats = api.getStats();
+
+    // ----- Timer fires -----
+
+    auto firesStart = Clock_Type::now();
+    size_t fires = scheduler.advance(options.simulate);
+
+    api.drain();
+
+    auto firesDuration = Clock_Type::now() - firesStart;
+    auto stats = api.getStats();
+
+    // ----- Report -----
+
+    AdmissionControl::Stats admission{};
+
+    for (const auto& controller : controllers)
+    {
+        auto controllerAdmission = controller->getAdmissionStats();
+        admission.admitted += controllerAdmission.admitted;
+        admission.rejectedByUser += controllerAdmission.rejectedByUser;
+        admission.rejectedByGuild += controllerAdmission.rejectedByGuild;
+    }
+
+    std::printf("\nStartup\n");
+    std::printf("  init                   %.3f s, %zu timers scheduled\n", GetSeconds(initDuration), initTimers);
+    std::printf("%s", startup.render().c_str());
+
+    std::printf("\nCommands\n");
+    std::printf("  sent                   %llu in %.3f s (%.0f/s), answered in %.3f s (%.0f/s)\n",
+        (unsigned long long)gateway.getDispatchedCount(), GetSeconds(sendDuration), gateway.getDispatchedCount() / GetSeconds(sendDuration),
+        GetSeconds(commandsDuration), gateway.getDispatchedCount() / GetSeconds(commandsDuration));
+    std::printf("  admission              %llu admitted, %llu rejected by user, %llu rejected by guild\n",
+        (unsigned long long)admission.admitted, (unsigned long long)admission.rejectedByUser, (unsigned long long)admission.rejectedByGuild);
+    std::printf("  responses              %llu replies, %llu deferrals, %llu edits, %llu suggestions, %zu unanswered\n",
+        (unsigned long long)commandStats.replies, (unsigned long long)commandStats.deferrals, (unsigned long long)commandStats.edits,
+        (unsigned long long)commandStats.suggestions, api.getUnansweredCount());
+    PrintLatency("time to answer", api.getResponseLatency());
+
+    std::printf("\nTimer fires (%llu virtual seconds)\n", (unsigned long long)options.simulate);
+    std::printf("  fires                  %zu in %.3f s (%.0f/s)\n", fires, GetSeconds(firesDuration), fires / GetSeconds(firesDuration));
+    std::printf("  messages               %llu sent, %llu bytes\n",
+        (unsigned long long)(stats.messages - commandStats.messages), (unsigned long long)(stats.messageBytes - commandStats.messageBytes));
+
+    std::printf("\n%s", metrics.renderSummary().c_str());
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "Cluster/FileLock.h"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <process.h>
+
+    static intptr_t OpenLockFile(const std::filesystem::path& path)
+    {
+        HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        return handle == INVALID_HANDLE_VALUE ? -1 : intptr_t(handle);
+    }
+
+    static void CloseLockFile(intptr_t handle) { CloseHandle(HANDLE(handle)); }
+
+    static bool TryLockFile(intptr_t handle)
+    {
+        OVERLAPPED overlapped{};
+        return LockFileEx(HANDLE(handle), LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &overlapped);
+    }
+
+    static void UnlockFile(intptr_t handle)
+    {
+        OVERLAPPED overlapped{};
+        UnlockFileEx(HANDLE(handle), 0, 1, 0, &overlapped);
+    }
+
+    static std::string ReadContent(intptr_t handle)
+    {
+        char buffer[256];
+        DWORD count = 0;
+        OVERLAPPED overlapped{};
+
+        if (!ReadFile(HANDLE(handle), buffer, sizeof(buffer), &count, &overlapped))
+            return "";
+
+        return std::string(buffer, count);
+    }
+
+    static void WriteContent(intptr_t handle, std::string_view content)
+    {
+        DWORD written = 0;
+        OVERLAPPED overlapped{};
+
+        WriteFile(HANDLE(handle), content.data(), DWORD(content.size()), &written, &overlapped);
+        SetFilePointer(HANDLE(handle), LONG(content.size()), nullptr, FILE_BEGIN);
+        SetEndOfFile(HANDLE(handle));
+    }
+
+    static std::string GetProcessId() { return std::to_string(_getpid()); }
+#else
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <unistd.h>
+
+    static intptr_t OpenLockFile(const std::filesystem::path& path) { return open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644); }
+
+    static void CloseLockFile(intptr_t handle) { close(int(handle)); }
+
+    // flock locks belong to the open file, so two FileLock on the same path exclude each other even in one process
+    static bool TryLockFile(intptr_t handle) { return flock(int(handle), LOCK_EX | LOCK_NB) == 0; }
+
+    static void UnlockFile(intptr_t handle) { flock(int(handle), LOCK_UN); }
+
+    static std::string ReadContent(intptr_t handle)
+    {
+        char buffer[256];
+        auto count = pread(int(handle), buffer, sizeof(buffer), 0);
+
+        return count > 0 ? std::string(buffer, size_t(count)) : "";
+    }
+
+    // Written over the previous content before truncating, a reader never sees an empty file
+    static void WriteContent(intptr_t handle, std::string_view content)
+    {
+        if (pwrite(int(handle), content.data(), content.size(), 0) != ssize_t(content.size()))
+            return;
+
+        [[maybe_unused]] int result = ftruncate(int(handle), off_t(content.size()));
+    }
+
+    static std::string GetProcessId() { return std::to_string(getpid()); }
+#endif
+
+FileLock::FileLock(const std::filesystem::path& path)
+    : m_Path(path)
+{
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path());
+
+    m_Handle = OpenLockFile(path);
+
+    if (m_Handle < 0)
+        throw std::runtime_error("Could not open the lock file " + path.string());
+}
+
+FileLock::~FileLock()
+{
+    unlock();
+    CloseLockFile(m_Handle);
+}
+
+bool FileLock::tryLock()
+{
+    if (m_Locked)
+        return true;
+
+    if (!TryLockFile(m_Handle))
+        return false;
+
+    m_Locked = true;
+    write(GetProcessId() + "\n");
+
+    return true;
+}
+
+void FileLock::unlock()
+{
+    if (!m_Locked)
+        return;
+
+    UnlockFile(m_Handle);
+    m_Locked = false;
+}
+
+std::string FileLock::read() const
+{
+    return ReadContent(m_Handle);
+}
+
+void FileLock::write(std::string_view content)
+{
+    WriteContent(m_Handle, content);
+}
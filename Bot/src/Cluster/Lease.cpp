@@ -0,0 +1,103 @@
+#include "Cluster/Lease.h"
+
+#include <random>
+#include <sstream>
+
+#include "Time/SystemClock.h"
+
+static const SystemClock SYSTEM_CLOCK;
+
+Lease::Lease(const std::vector<std::filesystem::path>& paths, std::chrono::milliseconds timeout, const IClock* clock)
+    : m_Timeout(timeout), m_Clock(clock != nullptr ? *clock : SYSTEM_CLOCK)
+{
+    m_Owner = std::to_string(std::random_device()()) + "-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+    for (const auto& path : paths)
+        m_Locks.push_back(std::make_unique<FileLock>(path));
+}
+
+Lease::~Lease()
+{
+    release();
+}
+
+bool Lease::tryAcquire()
+{
+    if (m_Held)
+        return true;
+
+    auto now = m_Clock.now();
+
+    for (const auto& lock : m_Locks)
+    {
+        if (lock->tryLock())
+            continue;
+
+        // Held by a live process: only a stale heartbeat lets the lease be taken over
+        auto heartbeat = ReadHeartbeat(*lock);
+
+        if (heartbeat.owner.empty() || now - heartbeat.time < m_Timeout)
+        {
+            release();
+            return false;
+        }
+    }
+
+    m_Held = true;
+    writeHeartbeats();
+
+    return true;
+}
+
+bool Lease::renew()
+{
+    if (!m_Held)
+        return false;
+
+    for (const auto& lock : m_Locks)
+    {
+        if (ReadHeartbeat(*lock).owner != m_Owner)
+        {
+            release();
+            return false;
+        }
+
+        // Taken over from a stuck holder: its locks are acquired once it exits
+        if (!lock->isLocked())
+            lock->tryLock();
+    }
+
+    writeHeartbeats();
+    return true;
+}
+
+void Lease::release()
+{
+    for (const auto& lock : m_Locks)
+        lock->unlock();
+
+    m_Held = false;
+}
+
+Lease::Heartbeat Lease::ReadHeartbeat(const FileLock& lock)
+{
+    Heartbeat heartbeat;
+    int64_t milliseconds = 0;
+
+    std::istringstream content(lock.read());
+
+    if (!(content >> heartbeat.owner >> milliseconds))
+        return Heartbeat();
+
+    heartbeat.time = IClock::TimePoint_Type(std::chrono::milliseconds(milliseconds));
+    return heartbeat;
+}
+
+void Lease::writeHeartbeats()
+{
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(m_Clock.now().time_since_epoch()).count();
+    auto content = m_Owner + " " + std::to_string(milliseconds) + "\n";
+
+    for (const auto& lock : m_Locks)
+        lock->write(content);
+}
@@ -0,0 +1,110 @@
+#include "Cluster/ShardMap.h"
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+static constexpr const char* DATA_DIRECTORY = "data";
+// Shard count the partitioned data was written with
+static constexpr const char* LAYOUT_PATH = "data/shards/layout.txt";
+
+static uint32_t ParseCount(std::string_view option, std::string_view value)
+{
+    try
+    {
+        size_t end = 0;
+        unsigned long count = std::stoul(std::string(value), &end);
+
+        if (end == value.size() && count <= UINT32_MAX)
+            return uint32_t(count);
+    }
+    catch (const std::logic_error&)
+    {
+    }
+
+    throw std::invalid_argument("Invalid value for " + std::string(option) + ": " + std::string(value));
+}
+
+ShardMap::ShardMap(uint32_t shardCount, uint32_t clusterId, uint32_t clusterCount)
+    : m_ShardCount(shardCount), m_ClusterId(clusterId), m_ClusterCount(clusterCount)
+{
+    if (shardCount == 0 || clusterCount == 0)
+        throw std::invalid_argument("The shard and cluster counts must be positive");
+
+    if (clusterId >= clusterCount)
+        throw std::invalid_argument("The cluster id must be below the cluster count");
+
+    if (shardCount < clusterCount)
+        throw std::invalid_argument("Every cluster must own at least one shard");
+}
+
+ShardMap ShardMap::FromArguments(int argc, const char* const* argv)
+{
+    uint32_t shardCount = 1;
+    uint32_t clusterId = 0;
+    uint32_t clusterCount = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view argument = argv[i];
+        auto separator = argument.find('=');
+        auto option = argument.substr(0, separator);
+        auto value = separator == std::string_view::npos ? std::string_view() : argument.substr(separator + 1);
+
+        if (option == "--shards")
+            shardCount = ParseCount(option, value);
+        else if (option == "--cluster")
+            clusterId = ParseCount(option, value);
+        else if (option == "--clusters")
+            clusterCount = ParseCount(option, value);
+        else
+            throw std::invalid_argument("Unknown option: " + std::string(argument));
+    }
+
+    return ShardMap(shardCount, clusterId, clusterCount);
+}
+
+std::vector<uint32_t> ShardMap::getOwnedShards() const
+{
+    std::vector<uint32_t> shards;
+
+    for (uint32_t shard = m_ClusterId; shard < m_ShardCount; shard += m_ClusterCount)
+        shards.push_back(shard);
+
+    return shards;
+}
+
+std::filesystem::path ShardMap::getShardDirectory(uint32_t shard) const
+{
+    if (!isPartitioned())
+        return DATA_DIRECTORY;
+
+    return std::filesystem::path(DATA_DIRECTORY) / "shards" / std::to_string(shard);
+}
+
+std::filesystem::path ShardMap::GetDataDirectory()
+{
+    return DATA_DIRECTORY;
+}
+
+void ShardMap::checkLayout() const
+{
+    if (!isPartitioned())
+        return;
+
+    std::ifstream layout(LAYOUT_PATH);
+    uint32_t recorded = 0;
+
+    if (layout >> recorded)
+    {
+        if (recorded != m_ShardCount)
+            throw std::runtime_error("The data is partitioned in " + std::to_string(recorded) + " shards, not " + std::to_string(m_ShardCount));
+
+        return;
+    }
+
+    std::filesystem::create_directories(std::filesystem::path(LAYOUT_PATH).parent_path());
+    std::ofstream(LAYOUT_PATH) << m_ShardCount << std::endl;
+}
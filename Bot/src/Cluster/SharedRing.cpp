@@ -0,0 +1,315 @@
+#include "Cluster/SharedRing.h"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <process.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+static constexpr uint64_t MAGIC = 0x474e495254425344; // "DSBTRING"
+static constexpr uint32_t WRAP_MARKER = UINT32_MAX;
+static constexpr size_t ALIGNMENT = 8;
+
+struct RingHeader
+{
+    uint64_t magic;
+    uint64_t capacity;
+    uint64_t creator;
+    std::atomic<uint32_t> closed;
+    std::atomic<uint32_t> overflow;
+    // On their own cache lines, so that the producer and the consumer do not invalidate each other
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The ring indexes are shared between processes, they must be lock-free");
+
+// Data starts on its own cache line
+static constexpr size_t DATA_OFFSET = (sizeof(RingHeader) + 63) / 64 * 64;
+
+/**
+ * @brief Get the bytes used by a record: its length, then its content, padded so that the next length is aligned.
+ */
+static size_t GetRecordSize(size_t size)
+{
+    return (sizeof(uint32_t) + size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+static RingHeader& GetHeader(void* memory)
+{
+    return *static_cast<RingHeader*>(memory);
+}
+
+#ifdef _WIN32
+    static uint64_t GetProcessId() { return uint64_t(_getpid()); }
+
+    static bool IsProcessAlive(uint64_t process)
+    {
+        HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, DWORD(process));
+
+        if (handle == nullptr)
+            return false;
+
+        bool alive = WaitForSingleObject(handle, 0) == WAIT_TIMEOUT;
+        CloseHandle(handle);
+
+        return alive;
+    }
+
+    // The size is given on creation, and set on opening
+    static void* MapMemory(const std::string& name, size_t& size, bool create, intptr_t& handle, bool& existed)
+    {
+        HANDLE mapping = create
+            ? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(size), name.c_str())
+            : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+
+        if (mapping == nullptr)
+            return nullptr;
+
+        existed = GetLastError() == ERROR_ALREADY_EXISTS;
+
+        void* memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+        if (memory == nullptr)
+        {
+            CloseHandle(mapping);
+            return nullptr;
+        }
+
+        if (!create)
+        {
+            MEMORY_BASIC_INFORMATION info{};
+            VirtualQuery(memory, &info, sizeof(info));
+            size = info.RegionSize;
+        }
+
+        handle = intptr_t(mapping);
+        return memory;
+    }
+
+    static void UnmapMemory(const std::string&, intptr_t handle, void* memory, size_t, bool)
+    {
+        UnmapViewOfFile(memory);
+        CloseHandle(HANDLE(handle));
+    }
+#else
+    static uint64_t GetProcessId() { return uint64_t(getpid()); }
+
+    static bool IsProcessAlive(uint64_t process) { return kill(pid_t(process), 0) == 0 || errno != ESRCH; }
+
+    // The size is given on creation, and set on opening
+    static void* MapMemory(const std::string& name, size_t& size, bool create, intptr_t& handle, bool& existed)
+    {
+        existed = false;
+
+        // The previous ring stays mapped by its consumer until it sees it closed
+        if (create)
+            shm_unlink(name.c_str());
+
+        int file = create ? shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600) : shm_open(name.c_str(), O_RDWR, 0);
+
+        if (file < 0)
+            return nullptr;
+
+        struct stat status{};
+
+        if (create ? ftruncate(file, off_t(size)) != 0 : fstat(file, &status) != 0)
+        {
+            close(file);
+            return nullptr;
+        }
+
+        if (!create)
+            size = size_t(status.st_size);
+
+        void* memory = size < DATA_OFFSET ? MAP_FAILED : mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+        // The mapping keeps the memory alive
+        close(file);
+
+        handle = -1;
+        return memory == MAP_FAILED ? nullptr : memory;
+    }
+
+    static void UnmapMemory(const std::string& name, intptr_t, void* memory, size_t size, bool owner)
+    {
+        if (owner)
+            shm_unlink(name.c_str());
+
+        munmap(memory, size);
+    }
+#endif
+
+std::unique_ptr<SharedRing> SharedRing::Create(const std::string& name, size_t capacity)
+{
+    if (capacity < 64 || (capacity & (capacity - 1)) != 0)
+        throw std::invalid_argument("The capacity of a shared ring must be a power of two of at least 64 bytes");
+
+    intptr_t handle = 0;
+    bool existed = false;
+    size_t size = DATA_OFFSET + capacity;
+    void* memory = MapMemory(name, size, true, handle, existed);
+
+    if (memory == nullptr)
+        throw std::runtime_error("Could not create the shared ring " + name);
+
+    auto* header = &GetHeader(memory);
+
+    // Left by a creator that crashed, Windows keeps the memory while the consumer maps it: the consumer sees the
+    // creator change and reopens the ring
+    if (existed)
+        std::atomic_ref<uint64_t>(header->magic).store(0, std::memory_order_release);
+
+    header->capacity = capacity;
+    header->creator = GetProcessId();
+    new (&header->closed) std::atomic<uint32_t>(0);
+    new (&header->overflow) std::atomic<uint32_t>(0);
+    new (&header->head) std::atomic<uint64_t>(0);
+    new (&header->tail) std::atomic<uint64_t>(0);
+
+    // Written last, a consumer opening the ring meanwhile waits for it
+    std::atomic_ref<uint64_t>(header->magic).store(MAGIC, std::memory_order_release);
+
+    return std::unique_ptr<SharedRing>(new SharedRing(name, handle, memory, size, true));
+}
+
+std::unique_ptr<SharedRing> SharedRing::Open(const std::string& name)
+{
+    intptr_t handle = 0;
+    bool existed = false;
+    size_t size = 0;
+    void* memory = MapMemory(name, size, false, handle, existed);
+
+    if (memory == nullptr)
+        return nullptr;
+
+    auto* header = &GetHeader(memory);
+    uint64_t magic = std::atomic_ref<uint64_t>(header->magic).load(std::memory_order_acquire);
+
+    // Being initialized by its creator
+    if (magic == 0)
+    {
+        UnmapMemory(name, handle, memory, size, false);
+        return nullptr;
+    }
+
+    if (magic != MAGIC || DATA_OFFSET + header->capacity > size)
+    {
+        UnmapMemory(name, handle, memory, size, false);
+        throw std::runtime_error("The shared memory " + name + " is not a shared ring");
+    }
+
+    return std::unique_ptr<SharedRing>(new SharedRing(name, handle, memory, size, false));
+}
+
+SharedRing::SharedRing(const std::string& name, intptr_t handle, void* memory, size_t size, bool owner)
+    : m_Name(name), m_Handle(handle), m_Memory(memory), m_Size(size), m_Owner(owner)
+{
+    m_Capacity = size_t(GetHeader(memory).capacity);
+    m_Creator = GetHeader(memory).creator;
+}
+
+SharedRing::~SharedRing()
+{
+    if (m_Owner)
+        GetHeader(m_Memory).closed.store(1, std::memory_order_release);
+
+    UnmapMemory(m_Name, m_Handle, m_Memory, m_Size, m_Owner);
+}
+
+bool SharedRing::tryPush(std::string_view record)
+{
+    // A record never wraps: at most half of the ring, it always fits once the ring drains
+    if (GetRecordSize(record.size()) > m_Capacity / 2)
+        throw std::invalid_argument("Record of " + std::to_string(record.size()) + " bytes too large for the shared ring " + m_Name);
+
+    uint64_t head = GetHeader(m_Memory).head.load(std::memory_order_relaxed);
+    uint64_t tail = GetHeader(m_Memory).tail.load(std::memory_order_acquire);
+
+    size_t size = GetRecordSize(record.size());
+    size_t offset = size_t(head & (m_Capacity - 1));
+    size_t contiguous = m_Capacity - offset;
+
+    // Not enough room before the end: the rest of the ring is skipped
+    size_t padding = contiguous < size ? contiguous : 0;
+
+    if (head + padding + size - tail > m_Capacity)
+    {
+        GetHeader(m_Memory).overflow.store(1, std::memory_order_release);
+        return false;
+    }
+
+    auto* data = getData();
+
+    if (padding != 0)
+    {
+        std::memcpy(data + offset, &WRAP_MARKER, sizeof(WRAP_MARKER));
+        offset = 0;
+    }
+
+    auto length = uint32_t(record.size());
+    std::memcpy(data + offset, &length, sizeof(length));
+    std::memcpy(data + offset + sizeof(length), record.data(), record.size());
+
+    // Published at once, with the wrap marker if any
+    GetHeader(m_Memory).head.store(head + padding + size, std::memory_order_release);
+
+    return true;
+}
+
+bool SharedRing::tryPop(std::string& record)
+{
+    uint64_t tail = GetHeader(m_Memory).tail.load(std::memory_order_relaxed);
+    uint64_t head = GetHeader(m_Memory).head.load(std::memory_order_acquire);
+
+    if (tail == head)
+        return false;
+
+    auto* data = getData();
+    size_t offset = size_t(tail & (m_Capacity - 1));
+    uint32_t length;
+
+    std::memcpy(&length, data + offset, sizeof(length));
+
+    // A wrap marker is always followed by a record, at the start of the ring
+    if (length == WRAP_MARKER)
+    {
+        tail += m_Capacity - offset;
+        offset = 0;
+        std::memcpy(&length, data, sizeof(length));
+    }
+
+    record.assign(reinterpret_cast<const char*>(data + offset + sizeof(length)), length);
+    GetHeader(m_Memory).tail.store(tail + GetRecordSize(length), std::memory_order_release);
+
+    return true;
+}
+
+bool SharedRing::takeOverflow()
+{
+    return GetHeader(m_Memory).overflow.exchange(0, std::memory_order_acq_rel) != 0;
+}
+
+bool SharedRing::isClosed() const
+{
+    if (GetHeader(m_Memory).closed.load(std::memory_order_acquire) != 0)
+        return true;
+
+    // Replaced by a new creator, or its creator crashed before closing it
+    return GetHeader(m_Memory).creator != m_Creator || !IsProcessAlive(m_Creator);
+}
+
+std::byte* SharedRing::getData() const
+{
+    return static_cast<std::byte*>(m_Memory) + DATA_OFFSET;
+}
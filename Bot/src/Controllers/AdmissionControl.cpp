@@ -0,0 +1,150 @@
+#include "Controllers/AdmissionControl.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+static uint64_t Mix(uint64_t value)
+{
+    // splitmix64 finalizer
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111eb;
+    return value ^ (value >> 31);
+}
+
+AdmissionControl::AdmissionControl(size_t capacity)
+    : m_Entries(std::bit_ceil(std::max<size_t>(capacity, PROBE_LENGTH))),
+      m_Limits{ Limit{ 1.0f, 10.0f }, Limit{ 5.0f, 50.0f } },
+      m_Epoch(Clock_Type::now())
+{
+}
+
+void AdmissionControl::setDefaultLimit(Limit perUser, Limit perGuild)
+{
+    std::lock_guard lock(m_Mutex);
+
+    m_Limits[0] = perUser;
+    m_Limits[1] = perGuild;
+}
+
+void AdmissionControl::setLimit(std::string_view command, std::string_view subcommand, Limit perUser, Limit perGuild)
+{
+    std::lock_guard lock(m_Mutex);
+
+    size_t limits = findLimits(command, subcommand);
+
+    if (limits != 0)
+    {
+        m_Limits[limits] = perUser;
+        m_Limits[limits + 1] = perGuild;
+        return;
+    }
+
+    if (m_Limits.size() + 2 > MAX_LIMITS)
+        throw std::length_error("Too many admission limits");
+
+    m_CommandLimits.push_back(CommandLimit{ std::string(command), std::string(subcommand) });
+    m_Limits.push_back(perUser);
+    m_Limits.push_back(perGuild);
+}
+
+bool AdmissionControl::admit(std::string_view command, std::string_view subcommand, const dpp::snowflake& user, const dpp::snowflake& guild,
+    Clock_Type::time_point now)
+{
+    uint32_t time = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - m_Epoch).count());
+
+    std::lock_guard lock(m_Mutex);
+
+    size_t limits = findLimits(command, subcommand);
+
+    Entry& userBucket = findBucket(limits, user, time);
+
+    if (userBucket.tokens < 1.0f)
+    {
+        ++m_RejectedByUser;
+        return false;
+    }
+
+    // Commands outside guilds are only limited per user
+    if (guild != 0)
+    {
+        Entry& guildBucket = findBucket(limits + 1, guild, time);
+
+        if (guildBucket.tokens < 1.0f)
+        {
+            ++m_RejectedByGuild;
+            return false;
+        }
+
+        guildBucket.tokens -= 1.0f;
+    }
+
+    // Looked up again, the guild bucket may have taken the slot of the user bucket
+    findBucket(limits, user, time).tokens -= 1.0f;
+
+    ++m_Admitted;
+    return true;
+}
+
+AdmissionControl::Stats AdmissionControl::getStats() const
+{
+    return Stats{ m_Admitted.load(), m_RejectedByUser.load(), m_RejectedByGuild.load() };
+}
+
+size_t AdmissionControl::findLimits(std::string_view command, std::string_view subcommand) const
+{
+    for (size_t i = 0; i < m_CommandLimits.size(); ++i)
+    {
+        if (m_CommandLimits[i].command == command && m_CommandLimits[i].subcommand == subcommand)
+            return 2 * i + 2;
+    }
+
+    return 0;
+}
+
+AdmissionControl::Entry& AdmissionControl::findBucket(size_t limit, uint64_t id, uint32_t now)
+{
+    // Never 0, which marks empty slots
+    uint64_t key = (static_cast<uint64_t>(limit) << 56) | (Mix(id) >> 8) | 1;
+    size_t mask = m_Entries.size() - 1;
+    size_t start = Mix(key) & mask;
+
+    // Slot taken if the bucket is not found: an empty slot, else a full bucket, else the least recently updated one
+    Entry* reusable = nullptr;
+    int reusableRank = 3;
+
+    for (size_t i = 0; i < PROBE_LENGTH; ++i)
+    {
+        Entry& entry = m_Entries[(start + i) & mask];
+
+        if (entry.key == key)
+        {
+            entry.tokens = refilled(entry, now);
+            entry.updated = now;
+            return entry;
+        }
+
+        int rank = entry.key == 0 ? 0 : refilled(entry, now) >= m_Limits[entry.key >> 56].burst ? 1 : 2;
+
+        if (rank < reusableRank || (rank == 2 && reusableRank == 2 && now - entry.updated > now - reusable->updated))
+        {
+            reusable = &entry;
+            reusableRank = rank;
+        }
+    }
+
+    reusable->key = key;
+    reusable->tokens = m_Limits[limit].burst;
+    reusable->updated = now;
+    return *reusable;
+}
+
+float AdmissionControl::refilled(const Entry& entry, uint32_t now) const
+{
+    const Limit& limit = m_Limits[entry.key >> 56];
+    float elapsed = static_cast<float>(now - entry.updated) / 1000.0f;
+
+    return std::min(limit.burst, entry.tokens + elapsed * limit.rate);
+}
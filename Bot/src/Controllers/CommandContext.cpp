@@ -0,0 +1,75 @@
+#include "Controllers/CommandContext.h"
+
+CommandContext::CommandContext(const dpp::slashcommand_t& event, IInteractionResponder* responder)
+    : m_Event(event), m_Responder(responder)
+{
+}
+
+void CommandContext::defer()
+{
+    if (isDeferred())
+        return;
+
+    m_Acknowledgement = std::make_shared<Acknowledgement>();
+
+    auto onAcknowledged = [acknowledgement = m_Acknowledgement](const dpp::confirmation_callback_t&) {
+        std::vector<std::function<void()>> pending;
+
+        {
+            std::lock_guard lock(acknowledgement->mutex);
+            acknowledgement->done = true;
+            pending.swap(acknowledgement->pending);
+        }
+
+        for (const auto& action : pending)
+            action();
+    };
+
+    if (m_Responder != nullptr)
+        m_Responder->defer(getInteraction(), true, std::move(onAcknowledged));
+    else
+        m_Event.thinking(true, std::move(onAcknowledged));
+}
+
+void CommandContext::reply(const dpp::message& message, dpp::command_completion_event_t callback) const
+{
+    if (!isDeferred())
+    {
+        if (m_Responder != nullptr)
+            m_Responder->reply(getInteraction(), message, std::move(callback));
+        else
+            m_Event.reply(message, std::move(callback));
+
+        return;
+    }
+
+    // Editing before Discord processed the acknowledgement fails with an unknown interaction
+    whenAcknowledged([event = m_Event, responder = m_Responder, message, callback = std::move(callback)]() {
+        if (responder != nullptr)
+            responder->editResponse(event.command, message, callback);
+        else
+            event.edit_original_response(message, callback);
+    });
+}
+
+dpp::async<dpp::confirmation_callback_t> CommandContext::co_reply(const dpp::message& message) const
+{
+    return dpp::async<dpp::confirmation_callback_t>([this, &message](auto&& callback) {
+        reply(message, std::forward<decltype(callback)>(callback));
+    });
+}
+
+void CommandContext::whenAcknowledged(std::function<void()> action) const
+{
+    {
+        std::lock_guard lock(m_Acknowledgement->mutex);
+
+        if (!m_Acknowledgement->done)
+        {
+            m_Acknowledgement->pending.push_back(std::move(action));
+            return;
+        }
+    }
+
+    action();
+}
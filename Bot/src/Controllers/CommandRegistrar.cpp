@@ -0,0 +1,123 @@
+#include "Controllers/CommandRegistrar.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+CommandRegistrar::CommandRegistrar(ICommandPublisher& publisher, const std::filesystem::path& statePath)
+    : m_Publisher(publisher), m_StatePath(statePath)
+{
+}
+
+bool CommandRegistrar::registerCommands(const std::vector<dpp::slashcommand>& commands, CommandRouter& router, std::function<void()> onRegistered)
+{
+    if (bindRegistered(commands, router))
+    {
+        if (onRegistered)
+            onRegistered();
+
+        return false;
+    }
+
+    uint64_t hash = HashCommands(commands);
+
+    m_Publisher.bulkOverwrite(commands, [this, hash, &router, onRegistered = std::move(onRegistered)](const ICommandPublisher::CommandIds_Type& ids) {
+        for (const auto& [name, id] : ids)
+            router.bindCommandId(name, id);
+
+        saveState(State{ hash, ids });
+
+        if (onRegistered)
+            onRegistered();
+    });
+
+    return true;
+}
+
+bool CommandRegistrar::bindRegistered(const std::vector<dpp::slashcommand>& commands, CommandRouter& router) const
+{
+    State state = loadState();
+
+    bool upToDate = state.hash == HashCommands(commands) && std::all_of(commands.begin(), commands.end(), [&state](const auto& command) {
+        return state.ids.contains(command.name);
+    });
+
+    if (!upToDate)
+        return false;
+
+    for (const auto& [name, id] : state.ids)
+        router.bindCommandId(name, id);
+
+    return true;
+}
+
+uint64_t CommandRegistrar::HashCommands(const std::vector<dpp::slashcommand>& commands)
+{
+    std::vector<std::string> serialized;
+    serialized.reserve(commands.size());
+
+    for (const auto& command : commands)
+        serialized.push_back(command.build_json(false));
+
+    std::sort(serialized.begin(), serialized.end());
+
+    // FNV-1a, std::hash is not guaranteed to be stable between builds
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (const auto& json : serialized)
+    {
+        for (char c : json)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+
+        hash ^= 0xff;
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+CommandRegistrar::State CommandRegistrar::loadState() const
+{
+    State state;
+    std::ifstream file(m_StatePath);
+
+    if (!file.is_open())
+        return state;
+
+    std::string line;
+
+    // Hash
+    if (!std::getline(file, line))
+        return state;
+
+    std::stringstream(line) >> std::hex >> state.hash;
+
+    // One "name id" line per command
+    while (std::getline(file, line))
+    {
+        std::stringstream ss(line);
+        std::string name;
+        uint64_t id = 0;
+
+        if (ss >> name >> id)
+            state.ids[name] = dpp::snowflake(id);
+    }
+
+    return state;
+}
+
+void CommandRegistrar::saveState(const State& state) const
+{
+    if (m_StatePath.has_parent_path())
+        std::filesystem::create_directories(m_StatePath.parent_path());
+
+    std::ofstream file(m_StatePath);
+
+    file << std::hex << state.hash << std::dec << std::endl;
+
+    for (const auto& [name, id] : state.ids)
+        file << name << ' ' << static_cast<uint64_t>(id) << std::endl;
+}
@@ -0,0 +1,238 @@
+#include "Controllers/CommandRouter.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+#include "Discord/DppInteractionResponder.h"
+#include "Tracing/Tracer.h"
+
+CommandRouter::CommandRouter(WorkerPool* pool, MetricsRegistry* metrics, IInteractionResponder* responder)
+    : m_Pool(pool), m_Metrics(metrics), m_Responder(responder)
+{
+}
+
+void CommandRouter::addRoute(std::string_view command, std::string_view subcommand, Handler_Type handler)
+{
+    std::unique_lock lock(m_Mutex);
+
+    auto route = std::make_unique<Route>(std::string(command), std::string(subcommand), std::move(handler), nullptr);
+
+    if (!m_RoutesByName.emplace(NameKey_Type{ route->command, route->subcommand }, route.get()).second)
+        throw std::invalid_argument("Route already registered: /" + std::string(command) + " " + std::string(subcommand));
+
+    m_Routes.push_back(std::move(route));
+}
+
+void CommandRouter::addRoute(std::string_view command, Handler_Type handler)
+{
+    addRoute(command, "", std::move(handler));
+}
+
+void CommandRouter::addAutocomplete(std::string_view command, std::string_view subcommand, std::string_view option, AutocompleteHandler_Type handler)
+{
+    std::unique_lock lock(m_Mutex);
+
+    std::string key = std::string(command) + ' ' + std::string(subcommand) + ' ' + std::string(option);
+
+    if (!m_Autocompletes.emplace(key, std::move(handler)).second)
+        throw std::invalid_argument("Autocomplete already registered: /" + key);
+}
+
+void CommandRouter::setGuard(std::string_view command, Guard_Type guard)
+{
+    std::unique_lock lock(m_Mutex);
+
+    for (const auto& route : m_Routes)
+    {
+        if (route->command == command)
+            route->guard = guard;
+    }
+}
+
+void CommandRouter::bindCommandId(std::string_view command, const dpp::snowflake& id)
+{
+    std::unique_lock lock(m_Mutex);
+
+    for (const auto& route : m_Routes)
+    {
+        if (route->command == command)
+            m_RoutesById[IdKey_Type{ id, route->subcommand }] = route.get();
+    }
+}
+
+bool CommandRouter::dispatch(const dpp::slashcommand_t& event) const
+{
+    TraceSpan span("CommandRouter::dispatch");
+
+    const Route* route = findRoute(event);
+
+    if (route == nullptr)
+        return false;
+
+    if (route->guard && !route->guard(event.command, route->command, route->subcommand))
+    {
+        CommandContext(event, m_Responder).reply(dpp::message("Error: You are sending commands too fast, please try again in a moment.").set_flags(dpp::m_ephemeral));
+        return true;
+    }
+
+    route->handler(event);
+    return true;
+}
+
+bool CommandRouter::dispatchAutocomplete(const dpp::autocomplete_t& event) const
+{
+    const dpp::command_interaction* interaction = std::get_if<dpp::autocomplete_interaction>(&event.command.data);
+
+    if (interaction == nullptr)
+        interaction = std::get_if<dpp::command_interaction>(&event.command.data);
+
+    if (interaction == nullptr)
+        return false;
+
+    std::string_view subcommand;
+    const auto* options = &interaction->options;
+
+    if (!options->empty() && (*options)[0].type == dpp::co_sub_command)
+    {
+        subcommand = (*options)[0].name;
+        options = &(*options)[0].options;
+    }
+
+    auto focused = std::find_if(options->begin(), options->end(), [](const dpp::command_data_option& option) { return option.focused; });
+
+    if (focused == options->end())
+        return false;
+
+    const auto* typed = std::get_if<std::string>(&focused->value);
+    std::string key = interaction->name + ' ' + std::string(subcommand) + ' ' + focused->name;
+
+    std::vector<std::string> suggestions;
+
+    {
+        std::shared_lock lock(m_Mutex);
+
+        auto handler = m_Autocompletes.find(key);
+
+        if (handler == m_Autocompletes.end())
+            return false;
+
+        suggestions = handler->second(event.command, typed == nullptr ? std::string_view() : std::string_view(*typed));
+    }
+
+    if (suggestions.size() > MAX_AUTOCOMPLETE_CHOICES)
+        suggestions.resize(MAX_AUTOCOMPLETE_CHOICES);
+
+    if (m_Responder != nullptr)
+    {
+        m_Responder->suggest(event.command, suggestions);
+        return true;
+    }
+
+    DppInteractionResponder(*event.from->creator).suggest(event.command, suggestions);
+    return true;
+}
+
+std::vector<std::string> CommandRouter::getCommandNames() const
+{
+    std::shared_lock lock(m_Mutex);
+
+    std::vector<std::string> names;
+
+    for (const auto& route : m_Routes)
+    {
+        if (std::find(names.begin(), names.end(), route->command) == names.end())
+            names.push_back(route->command);
+    }
+
+    return names;
+}
+
+Histogram* CommandRouter::getLatencyHistogram(std::string_view command, std::string_view subcommand)
+{
+    if (m_Metrics == nullptr)
+        return nullptr;
+
+    return &m_Metrics->histogram("bot_command_duration_seconds", "Time from dispatch to the end of the command handler.",
+        MetricsRegistry::Labels({ { "command", command }, { "subcommand", subcommand } }));
+}
+
+const CommandRouter::Route* CommandRouter::findRoute(const dpp::slashcommand_t& event) const
+{
+    // Not get_command_interaction(), which copies the whole option tree
+    const auto* interaction = std::get_if<dpp::command_interaction>(&event.command.data);
+
+    if (interaction == nullptr)
+        return nullptr;
+
+    std::string_view subcommand;
+
+    if (!interaction->options.empty() && interaction->options[0].type == dpp::co_sub_command)
+        subcommand = interaction->options[0].name;
+
+    std::shared_lock lock(m_Mutex);
+
+    auto byId = m_RoutesById.find(IdKey_Type{ interaction->id, subcommand });
+
+    if (byId != m_RoutesById.end())
+        return byId->second;
+
+    // Command ids are not known until registration completes
+    auto byName = m_RoutesByName.find(NameKey_Type{ interaction->name, subcommand });
+
+    return byName == m_RoutesByName.end() ? nullptr : byName->second;
+}
+
+void CommandRouter::execute(const dpp::slashcommand_t& event, bool deferred, std::string key, Histogram* latency, std::function<void(const CommandContext&)> handler) const
+{
+    using namespace std::string_literals;
+
+    CommandContext context(event, m_Responder);
+
+    if (m_Pool == nullptr)
+    {
+        ScopedLatency timing(latency);
+        handler(context);
+        return;
+    }
+
+    if (deferred)
+        context.defer();
+
+    auto task = [context, handler = std::move(handler), latency, start = std::chrono::steady_clock::now()]() {
+        TraceSpan span("CommandRouter::handler");
+
+        try
+        {
+            handler(context);
+        }
+        catch (const std::exception& e)
+        {
+            context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        }
+
+        // Queuing time included
+        if (latency != nullptr)
+            latency->record(std::chrono::steady_clock::now() - start);
+    };
+
+    bool accepted = key.empty() ? m_Pool->submit(std::move(task)) : m_Pool->submit(key, std::move(task));
+
+    if (!accepted)
+        context.reply(dpp::message("Error: The bot is busy, please try again later.").set_flags(dpp::m_ephemeral));
+}
+
+const std::vector<dpp::command_data_option>& CommandRouter::GetOptions(const dpp::slashcommand_t& event, bool subcommand)
+{
+    static const std::vector<dpp::command_data_option> NO_OPTIONS;
+
+    const auto* interaction = std::get_if<dpp::command_interaction>(&event.command.data);
+
+    if (interaction == nullptr)
+        return NO_OPTIONS;
+
+    if (!subcommand)
+        return interaction->options;
+
+    return interaction->options.empty() ? NO_OPTIONS : interaction->options[0].options;
+}
@@ -1,7 +1,10 @@
 #include "Controllers/Controller.h"
 
-Controller::Controller(dpp::cluster& bot)
-    : m_Bot(bot)
+#include <exception>
+#include <future>
+
+Controller::Controller(dpp::cluster& bot, MetricsRegistry* metrics)
+    : m_Bot(bot), m_Metrics(metrics)
 {
 }
 
@@ -9,17 +12,69 @@ Controller::~Controller()
 {
 }
 
-void Controller::init()
+void Controller::init(StartupProfile* profile)
 {
-    onInit();
+    onInit(profile);
 }
 
-void Controller::createCommands() const
+void Controller::InitAll(const std::vector<std::unique_ptr<Controller>>& controllers, StartupProfile* profile)
 {
-    onCreateCommands();
+    std::vector<std::future<void>> initializations;
+    initializations.reserve(controllers.size());
+
+    for (const auto& controller : controllers)
+        initializations.push_back(std::async(std::launch::async, [&controller, profile]() { controller->init(profile); }));
+
+    std::exception_ptr error;
+
+    // Every initialization is waited for, a controller must not be destroyed while another thread initializes it
+    for (auto& initialization : initializations)
+    {
+        try
+        {
+            initialization.get();
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+
+    if (error)
+        std::rethrow_exception(error);
 }
 
-bool Controller::handleSlashCommand(const dpp::slashcommand_t& event)
+std::vector<dpp::slashcommand> Controller::getCommands() const
 {
-    return onSlashCommand(event);
+    return onCreateCommands();
+}
+
+void Controller::registerRoutes(CommandRouter& router)
+{
+    onRegisterRoutes(router);
+
+    auto guard = [this](const dpp::interaction& interaction, std::string_view command, std::string_view subcommand) {
+        return m_Admission.admit(command, subcommand, interaction.usr.id, interaction.guild_id);
+    };
+
+    std::string commands;
+
+    for (const auto& command : onCreateCommands())
+    {
+        router.setGuard(command.name, guard);
+        commands += (commands.empty() ? "" : ",") + command.name;
+    }
+
+    if (m_Metrics == nullptr)
+        return;
+
+    m_Metrics->addCollector("bot_admission_total", "Commands admitted or rejected by rate limiting.", MetricsRegistry::Type::Counter, [this, commands]() {
+        auto stats = m_Admission.getStats();
+        return std::vector<MetricsRegistry::Sample>{
+            { MetricsRegistry::Labels({ { "commands", commands }, { "result", "admitted" } }), double(stats.admitted) },
+            { MetricsRegistry::Labels({ { "commands", commands }, { "result", "rejected_user" } }), double(stats.rejectedByUser) },
+            { MetricsRegistry::Labels({ { "commands", commands }, { "result", "rejected_guild" } }), double(stats.rejectedByGuild) },
+        };
+    });
 }
\ No newline at end of file
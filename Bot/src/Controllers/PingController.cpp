@@ -1,5 +1,9 @@
 #include "Controllers/PingController.h"
 
+#include "Logging/Logger.h"
+
+static constexpr auto PING = MakeCommandSchema<NoParams>("ping", "Ping the bot");
+
 PingController::PingController(dpp::cluster& bot)
     : Controller(bot)
 {
@@ -9,26 +13,19 @@ PingController::~PingController()
 {
 }
 
-void PingController::onInit()
+void PingController::onInit(StartupProfile*)
 {
-    m_Bot.log(dpp::ll_info, "PingController initialized");
+    Logger::Log(dpp::ll_info, "PingController initialized");
 }
 
-void PingController::onCreateCommands() const
+std::vector<dpp::slashcommand> PingController::onCreateCommands() const
 {
-    m_Bot.global_command_create(dpp::slashcommand("ping", "Ping the bot", m_Bot.me.id));
+    return { PING.buildCommand(m_Bot.me.id) };
 }
 
-bool PingController::onSlashCommand(const dpp::slashcommand_t& event)
+void PingController::onRegisterRoutes(CommandRouter& router)
 {
-    bool handled = true;
-    
-    if (event.command.get_command_name() == "ping")
-    {
-        event.reply(dpp::message("Pong!").set_flags(dpp::m_ephemeral));
-    }
-    else
-        handled = false;
-
-    return handled;
+    router.addRoute(PING, [](const CommandContext& context, const NoParams&) -> dpp::task<void> {
+        co_await context.co_reply(dpp::message("Pong!").set_flags(dpp::m_ephemeral));
+    });
 }
\ No newline at end of file
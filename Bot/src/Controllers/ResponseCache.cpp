@@ -0,0 +1,37 @@
+#include "Controllers/ResponseCache.h"
+
+ResponseCache::Response_Type ResponseCache::find(const dpp::snowflake& guild, uint64_t version) const
+{
+    {
+        std::lock_guard lock(m_Mutex);
+
+        auto it = m_Entries.find(guild);
+
+        if (it != m_Entries.end() && it->second.version == version)
+        {
+            ++m_Hits;
+            return it->second.response;
+        }
+    }
+
+    ++m_Misses;
+    return nullptr;
+}
+
+void ResponseCache::store(const dpp::snowflake& guild, uint64_t version, Response_Type response)
+{
+    std::lock_guard lock(m_Mutex);
+
+    auto& entry = m_Entries[guild];
+
+    // A slower handler must not replace a response rendered from newer data
+    if (entry.version > version && entry.response != nullptr)
+        return;
+
+    entry = Entry{ version, std::move(response) };
+}
+
+ResponseCache::Stats ResponseCache::getStats() const
+{
+    return Stats{ m_Hits.load(), m_Misses.load() };
+}
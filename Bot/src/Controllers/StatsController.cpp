@@ -0,0 +1,84 @@
+#include "Controllers/StatsController.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "Logging/Logger.h"
+#include "Tracing/Tracer.h"
+
+static constexpr auto STATS = MakeCommandSchema<NoParams>("stats", "Show the bot performance metrics");
+
+static constexpr auto TRACE_START = MakeCommandSchema<NoParams>("start", "Drop the recorded spans and start tracing.");
+static constexpr auto TRACE_STOP = MakeCommandSchema<NoParams>("stop", "Stop tracing, keeping the recorded spans.");
+static constexpr auto TRACE_DUMP = MakeCommandSchema<NoParams>("dump", "Write the recorded spans to a Chrome trace file on the bot host.");
+static constexpr auto TRACE = CommandGroupSchema("trace", "Record where the bot spends its time", TRACE_START, TRACE_STOP, TRACE_DUMP);
+
+// Discord rejects messages longer than 2000 characters
+static constexpr size_t MAX_MESSAGE_LENGTH = 2000;
+
+StatsController::StatsController(dpp::cluster& bot, MetricsRegistry& metrics)
+    : Controller(bot, &metrics)
+{
+}
+
+StatsController::~StatsController()
+{
+}
+
+void StatsController::onInit(StartupProfile*)
+{
+    Logger::Log(dpp::ll_info, "StatsController initialized");
+}
+
+std::vector<dpp::slashcommand> StatsController::onCreateCommands() const
+{
+    // Discord only shows the commands to administrators, and not in direct messages
+    return {
+        STATS.buildCommand(m_Bot.me.id).set_default_permissions(dpp::p_administrator).set_dm_permission(false),
+        TRACE.buildCommand(m_Bot.me.id).set_default_permissions(dpp::p_administrator).set_dm_permission(false),
+    };
+}
+
+void StatsController::onRegisterRoutes(CommandRouter& router)
+{
+    router.addRoute(STATS, [this](const CommandContext& context, const NoParams&) -> dpp::task<void> {
+
+        static constexpr std::string_view OPEN = "```\n", CLOSE = "```", TRUNCATED = "...\n";
+
+        std::string summary = m_Metrics->renderSummary();
+
+        if (OPEN.size() + summary.size() + CLOSE.size() > MAX_MESSAGE_LENGTH)
+        {
+            summary.resize(MAX_MESSAGE_LENGTH - OPEN.size() - CLOSE.size() - TRUNCATED.size());
+            summary.resize(summary.rfind('\n') + 1);
+            summary += TRUNCATED;
+        }
+
+        co_await context.co_reply(dpp::message(std::string(OPEN) + summary + std::string(CLOSE)).set_flags(dpp::m_ephemeral));
+    });
+
+    router.addRoute(TRACE.name, TRACE_START, [](const CommandContext& context, const NoParams&) -> dpp::task<void> {
+        Tracer::Clear();
+        Tracer::SetEnabled(true);
+        co_await context.co_reply(dpp::message("Tracing started.").set_flags(dpp::m_ephemeral));
+    });
+
+    router.addRoute(TRACE.name, TRACE_STOP, [](const CommandContext& context, const NoParams&) -> dpp::task<void> {
+        Tracer::SetEnabled(false);
+        co_await context.co_reply(dpp::message("Tracing stopped.").set_flags(dpp::m_ephemeral));
+    });
+
+    // Traces may be large and name internal functions, they stay on the bot host
+    router.addRoute(TRACE.name, TRACE_DUMP, [](const CommandContext& context, const NoParams&) -> dpp::task<void> {
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        auto path = std::filesystem::path("data") / "traces" / ("trace_" + std::to_string(seconds) + ".json");
+
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path);
+
+        if (!file.is_open() || !(file << Tracer::ExportChromeTrace()))
+            throw std::runtime_error("Could not write " + path.string());
+
+        co_await context.co_reply(dpp::message("Trace written to " + path.string() + ", open it in chrome://tracing or ui.perfetto.dev.").set_flags(dpp::m_ephemeral));
+    }, { .deferred = true });
+}
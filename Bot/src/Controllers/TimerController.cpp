@@ -1,14 +1,79 @@
 #include "Controllers/TimerController.h"
 
+#include <future>
+#include <limits>
+
+#include "Discord/DppMessageSink.h"
+#include "Discord/DppTimerScheduler.h"
+#include "Logging/Logger.h"
+#include "Time/SystemClock.h"
+#include "Time/TimeParser.h"
+#include "Tracing/Tracer.h"
+
 static bool INSTANTIATED = false;
+static const SystemClock SYSTEM_CLOCK;
 
-TimerController::TimerController(dpp::cluster& bot)
-    : Controller(bot)
+TimerController::TimerController(dpp::cluster& bot, MetricsRegistry* metrics, const ShardMap& shards)
+    : TimerController(bot, std::make_unique<DppMessageSink>(bot), std::make_unique<DppTimerScheduler>(bot), metrics, nullptr, shards)
+{
+}
+
+TimerController::TimerController(dpp::cluster& bot, std::unique_ptr<IMessageSink> messageSink, std::unique_ptr<ITimerScheduler> scheduler,
+    MetricsRegistry* metrics, const IClock* clock, const ShardMap& shards)
+    : Controller(bot, metrics), m_TimerDAO(shards), m_GuildSettingsDAO(shards), m_MessageSink(std::move(messageSink)), m_CountdownEditor(*m_MessageSink), m_Scheduler(std::move(scheduler)),
+    m_Clock(clock != nullptr ? *clock : SYSTEM_CLOCK)
 {
     if (INSTANTIATED)
         throw std::runtime_error("TimerController is a singleton and cannot be instantiated more than once.");
     
     INSTANTIATED = true;
+
+    using namespace TimerCommands;
+
+    // Writes hit the disk, reads render every timer: both are limited well below the default
+    for (const auto& subcommand : { SET.name, UPDATE.name, STOP.name, TRIGGER.name })
+        m_Admission.setLimit(TIMER.name, subcommand, { .rate = 0.2f, .burst = 5.0f }, { .rate = 1.0f, .burst = 20.0f });
+
+    for (const auto& subcommand : { LIST.name, TIMEZONE.name })
+        m_Admission.setLimit(TIMER.name, subcommand, { .rate = 0.1f, .burst = 3.0f }, { .rate = 0.5f, .burst = 10.0f });
+
+    // A bulk command rewrites up to every timer of a guild
+    for (const auto& subcommand : { BULK_STOP.name, BULK_PAUSE.name, BULK_RESUME.name, BULK_RETARGET.name, BULK_SHIFT.name })
+        m_Admission.setLimit(TIMERS.name, subcommand, { .rate = 0.05f, .burst = 3.0f }, { .rate = 0.2f, .burst = 5.0f });
+
+    if (metrics != nullptr)
+    {
+        auto daoLatency = [metrics](std::string_view operation) {
+            return &metrics->histogram("bot_timer_dao_duration_seconds", "Duration of timer DAO operations, disk writes included.",
+                MetricsRegistry::Labels({ { "operation", operation } }));
+        };
+
+        m_Metrics.daoAdd = daoLatency("add");
+        m_Metrics.daoUpdate = daoLatency("update");
+        m_Metrics.daoDelete = daoLatency("delete");
+        m_Metrics.daoLoad = daoLatency("load");
+        m_Metrics.fireLateness = &metrics->histogram("bot_timer_fire_lateness_seconds", "Delay between the scheduled fire of a timer and its message being sent.");
+        m_Metrics.activeTimers = &metrics->gauge("bot_timers_active", "Number of running timers.");
+        m_Metrics.outboundQueueDepth = &metrics->gauge("bot_outbound_messages_pending", "Number of timer messages sent to Discord and not answered yet.");
+        m_Metrics.takeoverFirstFire = &metrics->histogram("bot_failover_first_fire_seconds", "Delay between a standby taking over and its first timer fire.");
+
+        metrics->addCollector("bot_timer_list_cache_total", "Lookups of the /timer list response cache.", MetricsRegistry::Type::Counter, [this]() {
+            auto stats = m_ListCache.getStats();
+            return std::vector<MetricsRegistry::Sample>{
+                { MetricsRegistry::Labels({ { "result", "hit" } }), double(stats.hits) },
+                { MetricsRegistry::Labels({ { "result", "miss" } }), double(stats.misses) },
+            };
+        });
+
+        metrics->addCollector("bot_countdown_updates_total", "Updates of edit in place timer messages, by outcome.", MetricsRegistry::Type::Counter, [this]() {
+            auto stats = m_CountdownEditor.getStats();
+            return std::vector<MetricsRegistry::Sample>{
+                { MetricsRegistry::Labels({ { "result", "create" } }), double(stats.creates) },
+                { MetricsRegistry::Labels({ { "result", "edit" } }), double(stats.edits) },
+                { MetricsRegistry::Labels({ { "result", "coalesced" } }), double(stats.coalesced) },
+            };
+        });
+    }
 }
 
 TimerController::~TimerController()
@@ -16,357 +81,1060 @@ TimerController::~TimerController()
     INSTANTIATED = false;
 }
 
-void TimerController::onInit()
+void TimerController::initStandby(StartupProfile* profile)
 {
-    loadTimers();
-    
-    m_Bot.log(dpp::ll_info, "PingController initialized");
+    auto guildSettings = std::async(std::launch::async, [this, profile]() {
+        StartupPhase phase(profile, "timers: load guild settings");
+        loadGuildSettings();
+    });
+
+    {
+        StartupPhase phase(profile, "timers: load timers");
+        std::unique_lock lock(m_Mutex);
+
+        // Ended timers are kept, they are deleted by the process running them
+        ScopedLatency timing(m_Metrics.daoLoad);
+        m_TimerDAO.loadTimers();
+    }
+
+    guildSettings.get();
+
+    std::unique_lock lock(m_Mutex);
+
+    {
+        StartupPhase phase(profile, "timers: build payloads");
+
+        for (const auto& [id, _] : m_TimerDAO.getDataMap())
+            buildPayload(id);
+    }
+
+    m_Standby = true;
+
+    Logger::Log(dpp::ll_info, "TimerController standing by", LogField("count", m_TimerDAO.getDataMap().size()));
 }
 
-void TimerController::onCreateCommands() const
+size_t TimerController::followPrimary()
 {
-    dpp::slashcommand timer("timer", "Timer commands", m_Bot.me.id);
+    std::unique_lock lock(m_Mutex);
 
-    dpp::command_option timer_set(dpp::co_sub_command, "set", "Set a timer");
-        timer_set.add_option(dpp::command_option(dpp::co_string, "name", "Timer name. Must be unique.", true));
-        timer_set.add_option(dpp::command_option(dpp::co_string, "interval", "Interval between each message in format \"0d 0h 0m 0s\". Example: \"1d 2h 3m 4s\".", true));
-        timer_set.add_option(dpp::command_option(dpp::co_string, "message", "Message to send.", true));
-        timer_set.add_option(dpp::command_option(dpp::co_string, "end", "End time of the timer in dd/mm/yy hh:mm:ss format.", true));
-        timer_set.add_option(dpp::command_option(dpp::co_string, "title", "Title of the timer.", false));
-        timer_set.add_option(dpp::command_option(dpp::co_string, "start", "Start time of the timer in dd/mm/yy hh:mm:ss format. Default: now.", false));
-        timer_set.add_option(dpp::command_option(dpp::co_channel, "channel", "Channel to send the message to. Default: this channel.", false));
-        timer_set.add_option(dpp::command_option(dpp::co_string, "image", "Image to send with the message.", false));
+    if (!m_Standby)
+        return 0;
 
-    dpp::command_option timer_list(dpp::co_sub_command, "list", "List running timers.");
-    dpp::command_option timer_stop(dpp::co_sub_command, "stop", "Stop a running timer.");
-        timer_stop.add_option(dpp::command_option(dpp::co_string, "name", "Name of the timer to stop.", true));
+    auto changed = m_TimerDAO.followJournals();
 
-    dpp::command_option timer_trigger(dpp::co_sub_command, "trigger", "Trigger a timer.");
-        timer_trigger.add_option(dpp::command_option(dpp::co_string, "name", "Name of the timer to trigger.", true));
-        timer_trigger.add_option(dpp::command_option(dpp::co_channel, "channel", "Channel to send the message to. Default: set timer channel.", false));
+    if (changed.empty())
+        return 0;
 
-    dpp::command_option timer_update(dpp::co_sub_command, "update", "Update a timer.");
-        timer_update.add_option(dpp::command_option(dpp::co_string, "name", "Name of the timer to update.", true));
-        timer_update.add_option(dpp::command_option(dpp::co_string, "interval", "Interval between each message in format \"0d 0h 0m 0s\". Example: \"1d 2h 3m 4s\".", false));
-        timer_update.add_option(dpp::command_option(dpp::co_string, "message", "Message to send.", false));
-        timer_update.add_option(dpp::command_option(dpp::co_string, "start", "Start time of the timer in dd/mm/yy hh:mm:ss format. Default: now.", false));
-        timer_update.add_option(dpp::command_option(dpp::co_string, "end", "End time of the timer in dd/mm/yy hh:mm:ss format.", false));
-        timer_update.add_option(dpp::command_option(dpp::co_string, "title", "Title of the timer.", false));
-        timer_update.add_option(dpp::command_option(dpp::co_channel, "channel", "Channel to send the message to. Default: set timer channel.", false));
-        timer_update.add_option(dpp::command_option(dpp::co_string, "image", "Image to send with the message.", false));
+    for (const auto& id : changed)
+    {
+        if (m_TimerDAO.idExists(id))
+            buildPayload(id);
+        else
+            m_Payloads.erase(id);
+    }
+
+    return changed.size();
+}
+
+void TimerController::onInit(StartupProfile* profile)
+{
+    if (m_Standby)
+    {
+        takeOver(profile);
+        return;
+    }
+
+    // Both are read from disk and independent, only starting the timers needs the guild zones
+    auto guildSettings = std::async(std::launch::async, [this, profile]() {
+        StartupPhase phase(profile, "timers: load guild settings");
+        loadGuildSettings();
+    });
+
+    {
+        StartupPhase phase(profile, "timers: load timers");
+        loadTimers();
+    }
 
-    timer.add_option(timer_list);
-    timer.add_option(timer_set);
-    timer.add_option(timer_update);
-    timer.add_option(timer_trigger);
-    timer.add_option(timer_stop);
+    guildSettings.get();
 
-    m_Bot.global_command_create(timer);
+    {
+        StartupPhase phase(profile, "timers: start timers");
+        startTimers();
+    }
+
+    Logger::Log(dpp::ll_info, "TimerController initialized");
 }
 
-bool TimerController::onSlashCommand(const dpp::slashcommand_t& event)
+void TimerController::takeOver(StartupProfile* profile)
 {
-    if (event.command.get_command_name() != "timer")
-        return false;
-        
-    auto commandName = event.command.get_command_interaction().options[0].name;
+    m_TakeoverStart = m_Clock.now();
 
-    using namespace std::string_literals;
+    {
+        StartupPhase phase(profile, "timers: follow primary");
+        followPrimary();
+    }
+
+    std::unordered_map<dpp::snowflake, TimeFormatter::Zone_Type> previousZones;
 
-    if (commandName == "set")
     {
-        TimerDTO::TimePoint_Type startTime;
-        std::string startStr = getParamOrCall(
-            event,
-            "start",
-            []() { 
-                return GetFormattedTime(std::chrono::system_clock::now());
-            }
-        );
+        StartupPhase phase(profile, "timers: load guild settings");
 
-        try
         {
-            startTime = TimerController::ParseTime(startStr);
+            std::shared_lock lock(m_GuildZonesMutex);
+            previousZones = m_GuildZones;
         }
-        catch(...)
+
+        loadGuildSettings();
+    }
+
+    {
+        StartupPhase phase(profile, "timers: start timers");
+        std::unique_lock lock(m_Mutex);
+
+        // Only the payloads of the guilds whose zone changed while standing by are stale
+        for (const auto& [id, timer] : m_TimerDAO.getDataMap())
         {
-            event.reply(dpp::message("Error: Could not parse start time: " + startStr).set_flags(dpp::m_ephemeral));
-            return true;
+            auto previous = previousZones.find(timer->getGuild());
+            auto previousZone = previous == previousZones.end() ? TimeFormatter::GetDefaultZone() : previous->second;
+
+            if (getGuildZone(timer->getGuild()) != previousZone)
+                buildPayload(id);
         }
 
-        TimerDTO::TimePoint_Type endTime;
-        std::string endStr = getParam<std::string>(event, "end");
+        deleteEndedTimers_NoLock();
+
+        // Not maintained while standing by, a standby never serves autocomplete
+        m_TimerNames.rebuild(m_TimerDAO.getDataMap());
+
+        // The journals followed so far describe the previous process, a new standby follows this one
+        m_TimerDAO.resetJournals();
+
+        m_Standby = false;
+        m_AwaitingTakeoverFire = true;
+    }
+
+    startTimers();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(m_Clock.now() - m_TakeoverStart);
+    Logger::Log(dpp::ll_info, "TimerController took over", LogField("duration_ms", elapsed.count()));
+}
+
+std::vector<dpp::slashcommand> TimerController::onCreateCommands() const
+{
+    return { TimerCommands::TIMER.buildCommand(m_Bot.me.id), TimerCommands::TIMERS.buildCommand(m_Bot.me.id) };
+}
+
+void TimerController::onRegisterRoutes(CommandRouter& router)
+{
+    using namespace TimerCommands;
+
+    // Handlers touching the disk are deferred, handlers on a timer are ordered by timer name
+    router.addRoute(TIMER.name, SET, [this](const CommandContext& context, const TimerSetParams& params) { return onSetCommand(context, params); },
+        { .deferred = true, .key = &TimerSetParams::name });
+    router.addRoute(TIMER.name, LIST, [this](const CommandContext& context, const NoParams&) { return onListCommand(context); },
+        { .deferred = true });
+    router.addRoute(TIMER.name, STOP, [this](const CommandContext& context, const TimerStopParams& params) { return onStopCommand(context, params); },
+        { .deferred = true, .key = &TimerStopParams::name });
+    router.addRoute(TIMER.name, TRIGGER, [this](const CommandContext& context, const TimerTriggerParams& params) { return onTriggerCommand(context, params); },
+        { .key = &TimerTriggerParams::name });
+    router.addRoute(TIMER.name, UPDATE, [this](const CommandContext& context, const TimerUpdateParams& params) { return onUpdateCommand(context, params); },
+        { .deferred = true, .key = &TimerUpdateParams::name });
+    router.addRoute(TIMER.name, TIMEZONE, [this](const CommandContext& context, const TimerTimezoneParams& params) { return onTimezoneCommand(context, params); },
+        { .deferred = true });
+
+    // Bulk commands apply under one exclusive lock, they need no ordering by timer name
+    router.addRoute(TIMERS.name, BULK_STOP, [this](const CommandContext& context, const TimerBulkParams& params) { return onBulkStopCommand(context, params); },
+        { .deferred = true });
+    router.addRoute(TIMERS.name, BULK_PAUSE, [this](const CommandContext& context, const TimerBulkParams& params) { return onBulkPauseCommand(context, params, true); },
+        { .deferred = true });
+    router.addRoute(TIMERS.name, BULK_RESUME, [this](const CommandContext& context, const TimerBulkParams& params) { return onBulkPauseCommand(context, params, false); },
+        { .deferred = true });
+    router.addRoute(TIMERS.name, BULK_RETARGET, [this](const CommandContext& context, const TimerBulkParams& params) { return onBulkRetargetCommand(context, params); },
+        { .deferred = true });
+    router.addRoute(TIMERS.name, BULK_SHIFT, [this](const CommandContext& context, const TimerBulkParams& params) { return onBulkShiftCommand(context, params); },
+        { .deferred = true });
+
+    auto completeName = [this](const dpp::interaction& interaction, std::string_view prefix) {
+        return completeTimerName(interaction.guild_id, prefix);
+    };
+
+    router.addAutocomplete(TIMER.name, STOP.name, "name", completeName);
+    router.addAutocomplete(TIMER.name, TRIGGER.name, "name", completeName);
+    router.addAutocomplete(TIMER.name, UPDATE.name, "name", completeName);
+}
+
+dpp::task<void> TimerController::onSetCommand(const CommandContext& context, const TimerSetParams& params)
+{
+    using namespace std::string_literals;
+
+    auto zone = getGuildZone(context.getInteraction().guild_id);
+
+    TimerDTO::TimePoint_Type startTime;
+    std::string startStr = params.start.value_or(GetFormattedTime(m_Clock.now(), zone));
+
+    try
+    {
+        startTime = TimerController::ParseTime(startStr, zone);
+    }
+    catch(...)
+    {
+        context.reply(dpp::message("Error: Could not parse start time: " + startStr).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    TimerDTO::TimePoint_Type endTime;
+
+    try
+    {
+        endTime = TimerController::ParseTime(params.end, zone);
+    }
+    catch (...)
+    {
+        context.reply(dpp::message("Error: Could not parse end time: " + params.end).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    uint64_t interval;
 
+    try
+    {
+        interval = TimerController::ParseInteval(params.interval);
+    }
+    catch (...)
+    {
+        context.reply(dpp::message("Error: Could not parse interval: " + params.interval).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    TimerDTO t;
+    t.setName(params.name);
+    t.setChannel(params.channel.value_or(context.getInteraction().channel_id));
+    t.setStart(startTime);
+    t.setEnd(endTime);
+    t.setInterval(interval);
+    t.setMessage(params.message);
+    t.setImageURL(params.image.value_or(""));
+    t.setTitle(params.title.value_or(""));
+    t.setGuild(context.getInteraction().guild_id);
+    t.setEditInPlace(params.edit.value_or(false));
+
+    try
+    {
+        startTimer(t);
+    }
+    catch (const std::exception& e)
+    {
+        context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    Logger::Log(dpp::ll_info, "Timer started", LogField("guild", t.getGuild()), LogField("message", params.message));
+    co_await context.co_reply(dpp::message("Timer started:\n" + std::to_string(Timer(t, zone))).set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onListCommand(const CommandContext& context)
+{
+    const auto& guild = context.getInteraction().guild_id;
+    auto zone = getGuildZone(guild);
+
+    // Taken without lock, mutations made while rendering publish new versions and do not wait
+    auto snapshot = m_TimerDAO.snapshot();
+    uint64_t version;
+
+    {
+        // Locks are never held across a suspension point
+        std::shared_lock lock(m_Mutex);
+
+        // Both versions only grow, so their sum changes with any timer or time zone mutation
+        version = snapshot->getVersion() + m_GuildSettingsDAO.getVersion();
+    }
+
+    auto msg = m_ListCache.find(guild, version);
+
+    if (!msg)
+    {
+        std::string timers;
+        size_t i = 0;
+
+        for (const auto& [_, timer] : *snapshot)
+        {
+            timers += "Timer " + std::to_string(i) + "\n" + std::to_string(Timer(timer, zone)) + '\n';
+            ++i;
+        }
+
+        msg = std::make_shared<const std::string>(timers.empty() ? "No running timers." : "Running timers:\n" + timers);
+        m_ListCache.store(guild, version, msg);
+    }
+
+    co_await context.co_reply(dpp::message(*msg).set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onStopCommand(const CommandContext& context, const TimerStopParams& params)
+{
+    try
+    {
+        stopTimer(params.name);
+    }
+    catch (...)
+    {
+        context.reply(dpp::message("Error: Could not delete timer with name: " + params.name + ".").set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    co_await context.co_reply(dpp::message("Timer with name \"" + params.name + "\" stopped.").set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onTriggerCommand(const CommandContext& context, const TimerTriggerParams& params)
+{
+    bool sent;
+
+    try
+    {
+        // Resumed once Discord answered, no thread waits meanwhile
+        sent = co_await dpp::async<bool>([this, &params](auto&& onSent) {
+            if (params.channel)
+                sendMessage(params.name, *params.channel, onSent);
+            else
+                sendMessage(params.name, onSent);
+        });
+    }
+    catch (...)
+    {
+        context.reply(dpp::message("Error: Could not trigger timer with name: " + params.name + ".").set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    if (!sent)
+    {
+        context.reply(dpp::message("Error: Discord rejected the message of timer with name: " + params.name + ".").set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    co_await context.co_reply(dpp::message("Timer with name \"" + params.name + "\" triggered.").set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onUpdateCommand(const CommandContext& context, const TimerUpdateParams& params)
+{
+    using namespace std::string_literals;
+
+    auto zone = getGuildZone(context.getInteraction().guild_id);
+
+    TimerDTO t;
+
+    try
+    {
+        std::shared_lock lock(m_Mutex);
+        t = m_TimerDAO.findOne(params.name);
+    }
+    catch (...)
+    {
+        context.reply(dpp::message("Error: Could not find timer with name: " + params.name).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    if (params.interval)
+    {
         try
         {
-            endTime = TimerController::ParseTime(endStr);
+            t.setInterval(TimerController::ParseInteval(*params.interval));
         }
         catch (...)
         {
-            event.reply(dpp::message("Error: Could not parse end time: " + endStr).set_flags(dpp::m_ephemeral));
-            return true;
+            context.reply(dpp::message("Error: Could not parse interval: " + *params.interval).set_flags(dpp::m_ephemeral));
+            co_return;
         }
+    }
+    
+    if (params.message)
+        t.setMessage(*params.message);
 
-        std::string intervalStr = getParam<std::string>(event, "interval");
-        uint64_t interval;
-
+    if (params.start)
+    {
         try
         {
-            interval = TimerController::ParseInteval(intervalStr);
+            t.setStart(TimerController::ParseTime(*params.start, zone));
         }
         catch (...)
         {
-            event.reply(dpp::message("Error: Could not parse interval: " + intervalStr).set_flags(dpp::m_ephemeral));
-            return true;
+            context.reply(dpp::message("Error: Could not parse start time: " + *params.start).set_flags(dpp::m_ephemeral));
+            co_return;
         }
+    }
 
-        std::string name = getParam<std::string>(event, "name");
-        std::string message = getParam<std::string>(event, "message");
-        dpp::snowflake channel = getParamOr(event, "channel", event.command.channel_id);
-        std::string image = getParamOr(event, "image", ""s);
-        std::string title = getParamOr(event, "title", ""s);
-
-        TimerDTO t;
-        t.setName(name);
-        t.setChannel(channel);
-        t.setStart(startTime);
-        t.setEnd(endTime);
-        t.setInterval(interval);
-        t.setMessage(message);
-        t.setImageURL(image);
-        t.setTitle(title);
-
+    if (params.end)
+    {
         try
         {
-            startTimer(t);
+            t.setEnd(TimerController::ParseTime(*params.end, zone));
         }
-        catch (const std::exception& e)
+        catch (...)
         {
-            event.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
-            return true;
+            context.reply(dpp::message("Error: Could not parse end time: " + *params.end).set_flags(dpp::m_ephemeral));
+            co_return;
         }
+    }
+
+    if (params.title)
+        t.setTitle(*params.title);
+
+    if (params.channel)
+        t.setChannel(*params.channel);
+
+    if (params.image)
+        t.setImageURL(*params.image);
+
+    if (params.edit)
+        t.setEditInPlace(*params.edit);
 
-        m_Bot.log(dpp::ll_info, "Timer started with message \"" + message + "\".");
-        event.reply(dpp::message("Timer started:\n" + std::to_string(Timer(t))).set_flags(dpp::m_ephemeral));
+    try
+    {
+        updateTimer(params.name, t);
     }
-    else if (commandName == "list")
+    catch (const std::exception& e)
     {
-        if (getTimers().empty())
-            event.reply(dpp::message("No running timers.").set_flags(dpp::m_ephemeral));
-        else
-        {
-            std::string msg = "Running timers:\n";
-            size_t i = 0;
-            for (const auto& [_, timerDTO] : getTimers())
-            {
-                msg += "Timer " + std::to_string(i) + "\n" + std::to_string(Timer(timerDTO)) + '\n';
-                ++i;
-            }
+        context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
 
-            event.reply(dpp::message(msg).set_flags(dpp::m_ephemeral));
-        }
+    Logger::Log(dpp::ll_info, "Timer updated", LogField("id", params.name), LogField("message", t.getMessage()));
+    co_await context.co_reply(dpp::message("Timer updated:\n" + std::to_string(Timer(t, zone))).set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onTimezoneCommand(const CommandContext& context, const TimerTimezoneParams& params)
+{
+    using namespace std::string_literals;
+
+    auto zone = getGuildZone(context.getInteraction().guild_id);
+
+    if (!params.zone)
+    {
+        context.reply(dpp::message("Time zone: "s + std::string(zone->name())).set_flags(dpp::m_ephemeral));
+        co_return;
     }
-    else if (commandName == "stop")
+
+    auto newZone = TimeFormatter::LocateZone(*params.zone);
+
+    if (newZone == nullptr)
     {
-        std::string name = getParam<std::string>(event, "name");
+        context.reply(dpp::message("Error: Unknown time zone: " + *params.zone).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
 
-        try
-        {
-            stopTimer(name);
-        }
-        catch (...)
-        {
-            event.reply(dpp::message("Error: Could not delete timer with name: " + name + ".").set_flags(dpp::m_ephemeral));
-            return true;
-        }
+    try
+    {
+        setGuildZone(context.getInteraction().guild_id, newZone);
+    }
+    catch (const std::exception& e)
+    {
+        context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
 
-        event.reply(dpp::message("Timer with name \"" + name + "\" stopped.").set_flags(dpp::m_ephemeral));
+    co_await context.co_reply(dpp::message("Time zone set to " + *params.zone + ".").set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onBulkStopCommand(const CommandContext& context, const TimerBulkParams& params)
+{
+    using namespace std::string_literals;
+
+    auto selector = getSelector(context, params);
+
+    if (!selector)
+        co_return;
+
+    size_t count;
+
+    try
+    {
+        count = stopSelectedTimers(*selector);
+    }
+    catch (const std::exception& e)
+    {
+        context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        co_return;
     }
-    else if (commandName == "trigger")
+
+    co_await context.co_reply(dpp::message("Stopped " + std::to_string(count) + " timers.").set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onBulkPauseCommand(const CommandContext& context, const TimerBulkParams& params, bool paused)
+{
+    using namespace std::string_literals;
+
+    auto selector = getSelector(context, params);
+
+    if (!selector)
+        co_return;
+
+    BulkResult result;
+
+    try
+    {
+        result = pauseSelectedTimers(*selector, paused);
+    }
+    catch (const std::exception& e)
+    {
+        context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    co_await context.co_reply(dpp::message(FormatBulkReply(paused ? "Paused" : "Resumed", result)).set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onBulkRetargetCommand(const CommandContext& context, const TimerBulkParams& params)
+{
+    using namespace std::string_literals;
+
+    auto selector = getSelector(context, params);
+
+    if (!selector)
+        co_return;
+
+    size_t count;
+
+    try
+    {
+        count = retargetSelectedTimers(*selector, params.to);
+    }
+    catch (const std::exception& e)
+    {
+        context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    co_await context.co_reply(dpp::message("Retargeted " + std::to_string(count) + " timers.").set_flags(dpp::m_ephemeral));
+}
+
+dpp::task<void> TimerController::onBulkShiftCommand(const CommandContext& context, const TimerBulkParams& params)
+{
+    using namespace std::string_literals;
+
+    int64_t offset;
+
+    try
     {
-        std::string name = getParam<std::string>(event, "name");
-        dpp::snowflake channel = getParamOr(event, "channel", event.command.channel_id);
+        offset = TimerController::ParseInteval(params.by);
+    }
+    catch (...)
+    {
+        context.reply(dpp::message("Error: Could not parse offset: " + params.by).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    auto selector = getSelector(context, params);
+
+    if (!selector)
+        co_return;
+
+    BulkResult result;
+
+    try
+    {
+        result = shiftSelectedTimers(*selector, std::chrono::seconds(params.earlier.value_or(false) ? -offset : offset));
+    }
+    catch (const std::exception& e)
+    {
+        context.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
+        co_return;
+    }
+
+    co_await context.co_reply(dpp::message(FormatBulkReply("Shifted", result)).set_flags(dpp::m_ephemeral));
+}
+
+void TimerController::startTimer(const TimerDTO& timer)
+{
+    std::unique_lock lock(m_Mutex);
+
+    if (IsDatePassed(timer.getEnd(), m_Clock.now()))
+        throw PastDateException("End date is in the past: " + GetFormattedTime(timer.getEnd(), getGuildZone(timer.getGuild())));
+
+    {
+        ScopedLatency timing(m_Metrics.daoAdd);
+        m_TimerDAO.add(timer.getName(), timer);
+    }
+
+    m_TimerNames.add(timer.getGuild(), timer.getName());
+
+    startTimer_NoRegister(timer.getName());
+}
+
+void TimerController::stopTimer(const std::string& id)
+{
+    std::unique_lock lock(m_Mutex);
+    stopTimer_NoLock(id);
+}
+
+void TimerController::stopTimer_NoLock(const std::string& id)
+{
+    Logger::Log(dpp::ll_info, "Stopping timer", LogField("id", id));
+
+    dpp::snowflake guild;
+
+    try
+    {
+        guild = m_TimerDAO.findOne(id).getGuild();
+
+        ScopedLatency timing(m_Metrics.daoDelete);
+        m_TimerDAO.deleteByID(id);
+    }
+    catch (const std::exception& e)
+    {
+        Logger::Log(dpp::ll_warning, "Could not delete timer", LogField("id", id), LogField("error", e.what()));
+        throw;
+    }
+
+    m_TimerNames.remove(guild, id);
+
+    // Paused timers are not scheduled
+    if (auto running = m_RunningDppTimers.find(id); running != m_RunningDppTimers.end())
+    {
+        m_Scheduler->stopTimer(running->second);
+        m_RunningDppTimers.erase(running);
+    }
+
+    m_Payloads.erase(id);
+    m_CountdownEditor.forget(id);
+
+    if (m_FiringRing != nullptr)
+        publishMutation(id, TimerMutation::Type::Remove);
+
+    if (m_Metrics.activeTimers != nullptr)
+        m_Metrics.activeTimers->set(int64_t(m_RunningDppTimers.size()));
+
+    Logger::Log(dpp::ll_info, "Timer stopped", LogField("id", id));
+}
+
+void TimerController::updateTimer(const std::string& id, const TimerDTO& timer)
+{
+    std::unique_lock lock(m_Mutex);
+
+    Logger::Log(dpp::ll_info, "Updating timer", LogField("id", id));
+
+    try
+    {
+        ScopedLatency timing(m_Metrics.daoUpdate);
+        m_TimerDAO.update(id, timer);
+    }
+    catch (const std::exception& e)
+    {
+        // The stored timer is unchanged, it keeps firing with its payload
+        Logger::Log(dpp::ll_warning, "Could not update timer", LogField("id", id), LogField("error", e.what()));
+        throw;
+    }
+
+    // Rebuilt by startTimer_NoRegister
+    m_Payloads.erase(id);
+
+    if (!timer.isEditInPlace())
+        m_CountdownEditor.forget(id);
+
+    if (auto running = m_RunningDppTimers.find(id); running != m_RunningDppTimers.end())
+    {
+        m_Scheduler->stopTimer(running->second);
+        m_RunningDppTimers.erase(running);
+    }
+
+    startTimer_NoRegister(id);
+}
+
+std::optional<TimerController::TimerSelector> TimerController::getSelector(const CommandContext& context, const TimerBulkParams& params) const
+{
+    if (!params.channel && !params.prefix && !params.ends_after && !params.ends_before)
+    {
+        context.reply(dpp::message("Error: Select the timers by channel, prefix or end time.").set_flags(dpp::m_ephemeral));
+        return std::nullopt;
+    }
+
+    TimerSelector selector;
+    selector.guild = context.getInteraction().guild_id;
+    selector.channel = params.channel;
+    selector.prefix = params.prefix.value_or("");
+
+    auto zone = getGuildZone(selector.guild);
+
+    for (auto [time, bound] : { std::pair(&params.ends_after, &selector.endsAfter), std::pair(&params.ends_before, &selector.endsBefore) })
+    {
+        if (!*time)
+            continue;
 
         try
         {
-            if (isParamDefined(event, "channel"))
-                sendMessage(name, getParam<dpp::snowflake>(event, "channel"));
-            else
-                sendMessage(name);
+            *bound = TimerController::ParseTime(**time, zone);
         }
         catch (...)
         {
-            event.reply(dpp::message("Error: Could not trigger timer with name: " + name + ".").set_flags(dpp::m_ephemeral));
-            return true;
+            context.reply(dpp::message("Error: Could not parse end time: " + **time).set_flags(dpp::m_ephemeral));
+            return std::nullopt;
         }
+    }
+
+    return selector;
+}
 
-        event.reply(dpp::message("Timer with name \"" + name + "\" triggered.").set_flags(dpp::m_ephemeral));
+std::vector<std::string> TimerController::selectTimers_NoLock(const TimerSelector& selector) const
+{
+    std::vector<std::string> selected;
+
+    // Only the timers of the guild, narrowed by the name index when a prefix is given
+    for (auto& id : m_TimerNames.findByPrefix(selector.guild, selector.prefix, std::numeric_limits<size_t>::max()))
+    {
+        const auto& timer = m_TimerDAO.findOne(id);
+
+        if (selector.channel && timer.getChannel() != *selector.channel)
+            continue;
+
+        if (selector.endsAfter && timer.getEnd() <= *selector.endsAfter)
+            continue;
+
+        if (selector.endsBefore && timer.getEnd() >= *selector.endsBefore)
+            continue;
+
+        selected.push_back(std::move(id));
     }
-    else if (commandName == "update")
+
+    return selected;
+}
+
+size_t TimerController::stopSelectedTimers(const TimerSelector& selector)
+{
+    std::unique_lock lock(m_Mutex);
+
+    auto ids = selectTimers_NoLock(selector);
+    deleteTimers_NoLock(ids);
+
+    Logger::Log(dpp::ll_info, "Timers stopped", LogField("guild", selector.guild), LogField("count", ids.size()));
+
+    return ids.size();
+}
+
+TimerController::BulkResult TimerController::pauseSelectedTimers(const TimerSelector& selector, bool paused)
+{
+    std::unique_lock lock(m_Mutex);
+
+    auto now = m_Clock.now();
+
+    std::vector<std::pair<std::string, TimerDTO>> updated;
+    std::vector<std::string> ended;
+    std::vector<dpp::snowflake> endedGuilds;
+
+    for (auto& id : selectTimers_NoLock(selector))
     {
-        TimerDTO t;
+        const auto& timer = m_TimerDAO.findOne(id);
 
-        std::string name = getParam<std::string>(event, "name");
+        if (timer.isPaused() == paused)
+            continue;
 
-        try
+        // Ended while paused, never to fire again
+        if (!paused && IsDatePassed(timer.getEnd(), now))
         {
-            t = m_TimerDAO.findOne(name);
-        }
-        catch (...)
-        {
-            event.reply(dpp::message("Error: Could not find timer with name: " + name).set_flags(dpp::m_ephemeral));
-            return true;
+            ended.push_back(std::move(id));
+            endedGuilds.push_back(timer.getGuild());
+            continue;
         }
 
-        if (isParamDefined(event, "interval"))
-        {
-            std::string intervalStr = getParam<std::string>(event, "interval");
+        updated.emplace_back(std::move(id), timer);
+        updated.back().second.setPaused(paused);
+    }
 
-            try
-            {
-                t.setInterval(TimerController::ParseInteval(intervalStr));
-            }
-            catch (...)
-            {
-                event.reply(dpp::message("Error: Could not parse interval: " + intervalStr).set_flags(dpp::m_ephemeral));
-                return true;
-            }
-        }
-        
-        if (isParamDefined(event, "message"))
-            t.setMessage(getParam<std::string>(event, "message"));
+    {
+        ScopedLatency timing(m_Metrics.daoUpdate);
+        m_TimerDAO.updateMany(updated, ended);
+    }
 
-        if (isParamDefined(event, "start"))
-        {
-            std::string startStr = getParam<std::string>(event, "start");
+    forgetTimers_NoLock(ended, endedGuilds);
 
-            try
-            {
-                t.setStart(TimerController::ParseTime(startStr));
-            }
-            catch (...)
-            {
-                event.reply(dpp::message("Error: Could not parse start time: " + startStr).set_flags(dpp::m_ephemeral));
-                return true;
-            }
-        }
+    std::vector<std::string> ids;
+    ids.reserve(updated.size());
 
-        if (isParamDefined(event, "end"))
-        {
-            std::string endStr = getParam<std::string>(event, "end");
+    for (const auto& [id, _] : updated)
+        ids.push_back(id);
 
-            try
-            {
-                t.setEnd(TimerController::ParseTime(endStr));
-            }
-            catch (...)
-            {
-                event.reply(dpp::message("Error: Could not parse end time: " + endStr).set_flags(dpp::m_ephemeral));
-                return true;
-            }
-        }
+    if (paused)
+        unscheduleTimers_NoLock(ids);
+    else
+    {
+        for (const auto& id : ids)
+            startTimer_NoRegister(id);
+    }
+
+    Logger::Log(dpp::ll_info, paused ? "Timers paused" : "Timers resumed", LogField("guild", selector.guild), LogField("count", ids.size()), LogField("ended", ended.size()));
+
+    return BulkResult{ ids.size(), ended.size() };
+}
+
+size_t TimerController::retargetSelectedTimers(const TimerSelector& selector, const dpp::snowflake& channel)
+{
+    std::unique_lock lock(m_Mutex);
+
+    std::vector<std::pair<std::string, TimerDTO>> updated;
+
+    for (auto& id : selectTimers_NoLock(selector))
+    {
+        TimerDTO timer = m_TimerDAO.findOne(id);
+        timer.setChannel(channel);
+        updated.emplace_back(std::move(id), std::move(timer));
+    }
+
+    {
+        ScopedLatency timing(m_Metrics.daoUpdate);
+        m_TimerDAO.updateMany(updated);
+    }
+
+    // The channel is read on each fire, only the firing engine keeps its own copy
+    if (m_FiringRing != nullptr)
+    {
+        for (const auto& [id, _] : updated)
+            publishMutation(id, TimerMutation::Type::Upsert);
+    }
+
+    Logger::Log(dpp::ll_info, "Timers retargeted", LogField("guild", selector.guild), LogField("count", updated.size()), LogField("channel", channel));
 
-        if (isParamDefined(event, "title"))
-            t.setTitle(getParam<std::string>(event, "title"));
+    return updated.size();
+}
 
-        if (isParamDefined(event, "channel"))
-            t.setChannel(getParam<dpp::snowflake>(event, "channel"));
+TimerController::BulkResult TimerController::shiftSelectedTimers(const TimerSelector& selector, std::chrono::seconds offset)
+{
+    std::unique_lock lock(m_Mutex);
 
-        if (isParamDefined(event, "image"))
-            t.setImageURL(getParam<std::string>(event, "image"));
+    auto now = m_Clock.now();
 
-        try
-        {
-            updateTimer(name, t);
-        }
-        catch (const std::exception& e)
+    std::vector<std::pair<std::string, TimerDTO>> updated;
+    std::vector<std::string> ended;
+    std::vector<dpp::snowflake> endedGuilds;
+
+    for (auto& id : selectTimers_NoLock(selector))
+    {
+        TimerDTO timer = m_TimerDAO.findOne(id);
+        timer.setStart(timer.getStart() + offset);
+        timer.setEnd(timer.getEnd() + offset);
+
+        if (IsDatePassed(timer.getEnd(), now))
         {
-            event.reply(dpp::message("Error: "s + e.what()).set_flags(dpp::m_ephemeral));
-            return true;
+            ended.push_back(std::move(id));
+            endedGuilds.push_back(timer.getGuild());
         }
+        else
+            updated.emplace_back(std::move(id), std::move(timer));
+    }
 
-        m_Bot.log(dpp::ll_info, "Timer updated with message \"" + t.getMessage() + "\".");
-        event.reply(dpp::message("Timer updated:\n" + std::to_string(Timer(t))).set_flags(dpp::m_ephemeral));
+    {
+        ScopedLatency timing(m_Metrics.daoUpdate);
+        m_TimerDAO.updateMany(updated, ended);
     }
-    else
+
+    forgetTimers_NoLock(ended, endedGuilds);
+
+    std::vector<std::string> ids;
+    ids.reserve(updated.size());
+
+    for (const auto& [id, _] : updated)
+        ids.push_back(id);
+
+    unscheduleTimers_NoLock(ids);
+
+    // {start} and {end} are resolved in the payloads
+    for (const auto& id : ids)
     {
-        m_Bot.log(dpp::ll_warning, "Unknown timer command: " + commandName);
-        return true;
+        m_Payloads.erase(id);
+        startTimer_NoRegister(id);
     }
 
-    return true;
+    Logger::Log(dpp::ll_info, "Timers shifted", LogField("guild", selector.guild), LogField("count", ids.size()), LogField("ended", ended.size()));
+
+    return BulkResult{ ids.size(), ended.size() };
 }
 
-void TimerController::startTimer(const TimerDTO& timer)
+void TimerController::deleteTimers_NoLock(const std::vector<std::string>& ids)
 {
-    if (IsDatePassed(timer.getEnd()))
-        throw PastDateException("End date is in the past: " + GetFormattedTime(timer.getEnd()));
+    if (ids.empty())
+        return;
 
-    m_TimerDAO.add(timer.getName(), timer);
+    std::vector<dpp::snowflake> guilds;
+    guilds.reserve(ids.size());
 
-    startTimer_NoRegister(timer.getName());
+    for (const auto& id : ids)
+        guilds.push_back(m_TimerDAO.findOne(id).getGuild());
+
+    {
+        ScopedLatency timing(m_Metrics.daoDelete);
+        m_TimerDAO.deleteMany(ids);
+    }
+
+    forgetTimers_NoLock(ids, guilds);
 }
 
-void TimerController::stopTimer(const std::string& id)
+void TimerController::forgetTimers_NoLock(const std::vector<std::string>& ids, const std::vector<dpp::snowflake>& guilds)
 {
-    m_Bot.log(dpp::ll_info, "Stopping timer with id: " + id);
+    if (ids.empty())
+        return;
 
-    try
+    for (size_t i = 0; i < ids.size(); ++i)
+        m_TimerNames.remove(guilds[i], ids[i]);
+
+    unscheduleTimers_NoLock(ids);
+
+    for (const auto& id : ids)
     {
-        m_TimerDAO.deleteByID(id);
+        m_Payloads.erase(id);
+        m_CountdownEditor.forget(id);
     }
-    catch (const std::exception& e)
+}
+
+void TimerController::unscheduleTimers_NoLock(const std::vector<std::string>& ids)
+{
+    std::vector<dpp::timer> handles;
+    handles.reserve(ids.size());
+
+    for (const auto& id : ids)
     {
-        m_Bot.log(dpp::ll_warning, "Could not delete timer with id: " + id + ". Error: " + e.what());
-        throw;
+        auto running = m_RunningDppTimers.find(id);
+
+        if (running == m_RunningDppTimers.end())
+            continue;
+
+        handles.push_back(running->second);
+        m_RunningDppTimers.erase(running);
+
+        if (m_FiringRing != nullptr)
+            publishMutation(id, TimerMutation::Type::Remove);
     }
 
-    m_Bot.stop_timer(m_RunningDppTimers.at(id));
+    m_Scheduler->stopTimers(handles);
 
-    m_RunningDppTimers.erase(id);
-    m_Bot.log(dpp::ll_info, "Timer with id: " + id + " stopped.");
+    if (m_Metrics.activeTimers != nullptr)
+        m_Metrics.activeTimers->set(int64_t(m_RunningDppTimers.size()));
 }
 
-void TimerController::updateTimer(const std::string& id, const TimerDTO& timer)
+std::vector<std::string> TimerController::completeTimerName(const dpp::snowflake& guild, std::string_view prefix) const
 {
-    m_Bot.log(dpp::ll_info, "Updating timer with id: " + id);
+    // Not under m_Mutex, the index has its own lock: the suggestions never wait for a mutation writing its files
+    return m_TimerNames.findByPrefix(guild, prefix, CommandRouter::MAX_AUTOCOMPLETE_CHOICES);
+}
+
+TimeFormatter::Zone_Type TimerController::getGuildZone(const dpp::snowflake& guild) const
+{
+    std::shared_lock lock(m_GuildZonesMutex);
+
+    auto it = m_GuildZones.find(guild);
+
+    return it == m_GuildZones.end() ? TimeFormatter::GetDefaultZone() : it->second;
+}
+
+void TimerController::setGuildZone(const dpp::snowflake& guild, TimeFormatter::Zone_Type zone)
+{
+    GuildSettingsDTO settings(guild, std::string(zone->name()));
+
+    std::unique_lock lock(m_Mutex);
+
+    if (m_GuildSettingsDAO.idExists(guild))
+        m_GuildSettingsDAO.update(guild, settings);
+    else
+        m_GuildSettingsDAO.add(guild, settings);
 
-    try
     {
-        m_TimerDAO.update(id, timer);
+        std::unique_lock zonesLock(m_GuildZonesMutex);
+        m_GuildZones[guild] = zone;
     }
-    catch (const std::exception& e)
+
+    // {start} and {end} are resolved in the cached payloads
+    for (const auto& [id, timer] : m_TimerDAO.getDataMap())
     {
-        m_Bot.log(dpp::ll_warning, "Could not update timer with id: " + id + ". Error: " + e.what());
-        throw;
+        if (timer->getGuild() != guild)
+            continue;
+
+        buildPayload(id);
+
+        if (m_FiringRing != nullptr)
+            publishMutation(id, TimerMutation::Type::Upsert);
     }
+}
 
-    m_Bot.stop_timer(m_RunningDppTimers.at(id));
+void TimerController::loadGuildSettings()
+{
+    std::unique_lock lock(m_GuildZonesMutex);
 
-    startTimer_NoRegister(id);
+    m_GuildSettingsDAO.loadGuildSettings();
+    m_GuildZones.clear();
+
+    for (const auto& [guild, settings] : m_GuildSettingsDAO.getDataMap())
+    {
+        auto zone = TimeFormatter::LocateZone(settings.getTimeZone());
+
+        if (zone == nullptr)
+        {
+            Logger::Log(dpp::ll_warning, "Unknown time zone", LogField("zone", settings.getTimeZone()), LogField("guild", guild));
+            continue;
+        }
+
+        m_GuildZones[guild] = zone;
+    }
 }
 
 void TimerController::loadTimers()
 {
-    m_TimerDAO.loadTimers();
+    std::unique_lock lock(m_Mutex);
+
+    {
+        ScopedLatency timing(m_Metrics.daoLoad);
+        m_TimerDAO.loadTimers();
+    }
     
-    // Remove timers that have already ended
+    deleteEndedTimers_NoLock();
+    m_TimerNames.rebuild(m_TimerDAO.getDataMap());
+
+    // A standby following the previous journals reloads everything from this snapshot
+    m_TimerDAO.resetJournals();
+}
+
+void TimerController::deleteEndedTimers_NoLock()
+{
+    auto now = m_Clock.now();
+
+    // Collected first as deleting invalidates the iteration
+    std::vector<std::string> ended;
+
     for (const auto& [id, timer] : m_TimerDAO.getDataMap())
     {
-        if (IsDatePassed(timer.getEnd()))
-            m_TimerDAO.deleteByID(id);
+        if (IsDatePassed(timer->getEnd(), now))
+            ended.push_back(id);
     }
 
-    // Start timers
+    // One snapshot published for all of them
+    m_TimerDAO.deleteMany(ended);
+
+    for (const auto& id : ended)
+        m_Payloads.erase(id);
+}
+
+void TimerController::startTimers()
+{
+    std::unique_lock lock(m_Mutex);
+
     for (const auto& [id, _] : m_TimerDAO.getDataMap())
-    {
         startTimer_NoRegister(id);
-    }
+
+    Logger::Log(dpp::ll_info, "Timers started", LogField("count", m_RunningDppTimers.size()));
+}
+
+void TimerController::buildPayload(const std::string& timerId)
+{
+    auto record = m_TimerDAO.findRecord(timerId);
+    Timer timer(record, getGuildZone(record->getGuild()), &m_Clock);
+
+    m_Payloads[timerId] = TimerPayload(timer.buildMessage(), record->getEnd());
 }
 
 void TimerController::startTimer_NoRegister(const std::string& timerId)
 {
-    Timer timer(m_TimerDAO.findOne(timerId));
+    Timer timer(m_TimerDAO.findRecord(timerId), nullptr, &m_Clock);
+
+    // Already built while standing by
+    if (!m_Payloads.contains(timerId))
+        buildPayload(timerId);
+
+    // Kept ready for /timer trigger, fired once resumed
+    if (timer.getData().isPaused())
+        return;
 
     int64_t secondsToNextInterval;
 
@@ -376,203 +1144,406 @@ void TimerController::startTimer_NoRegister(const std::string& timerId)
     }
     catch (const std::runtime_error& e)
     {
-        m_Bot.log(dpp::ll_error, e.what());
+        Logger::Log(dpp::ll_error, "Could not schedule timer", LogField("id", timerId), LogField("error", e.what()));
+        return;
+    }
+
+    if (m_FiringRing != nullptr)
+    {
+        publishMutation(timerId, TimerMutation::Type::Upsert);
+
+        // Fired by the engine, only deleted here once over
+        auto secondsToEnd = std::chrono::duration_cast<std::chrono::seconds>(timer.getData().getEnd() - m_Clock.now()).count() + 1;
+
+        m_RunningDppTimers[timerId] = m_Scheduler->startTimer([this, timerId](const dpp::timer& dppTimer) {
+            std::unique_lock lock(m_Mutex);
+
+            if (isRunning(timerId, dppTimer) && Timer(m_TimerDAO.findRecord(timerId), nullptr, &m_Clock).isOver())
+            {
+                Logger::Log(dpp::ll_info, "Timer is over", LogField("id", timerId));
+                stopTimer_NoLock(timerId);
+            }
+        }, uint64_t(std::max<int64_t>(secondsToEnd, 1)));
+
+        if (m_Metrics.activeTimers != nullptr)
+            m_Metrics.activeTimers->set(int64_t(m_RunningDppTimers.size()));
+
         return;
     }
     
-    m_RunningDppTimers[timerId] = m_Bot.start_timer([this, timerId](const dpp::timer& dppTimer) {
-        
-        Timer timer(m_TimerDAO.findOne(timerId));
+    m_RunningDppTimers[timerId] = m_Scheduler->startTimer([this, timerId](const dpp::timer& dppTimer) {
+
+        TraceSpan span("TimerController::fire");
+        auto now = m_Clock.now();
+
+        std::unique_lock lock(m_Mutex);
+
+        // Stopped or updated while this callback was waiting for the lock
+        if (!isRunning(timerId, dppTimer))
+            return;
+
+        Timer timer(m_TimerDAO.findRecord(timerId), nullptr, &m_Clock);
 
         if (timer.isOver())
         {
-            stopTimer(std::string(timerId));
+            stopTimer_NoLock(timerId);
             return;
         }
         else
         {
-            sendMessage(timerId);
+            if (m_Metrics.fireLateness != nullptr)
+                m_Metrics.fireLateness->record(GetFireLateness(timer.getData(), now));
 
-            m_RunningDppTimers[timerId] = m_Bot.start_timer([this, timerId](const dpp::timer& dppTimer) {
+            if (timer.getData().isEditInPlace())
+                updateCountdown_NoLock(timerId);
+            else
+                sendMessage_NoLock(timerId, timer.getData().getChannel());
+
+            recordTakeoverFire();
+
+            m_RunningDppTimers[timerId] = m_Scheduler->startTimer([this, timerId](const dpp::timer& dppTimer) {
+
+                TraceSpan span("TimerController::fire");
+                auto now = m_Clock.now();
+
+                {
+                    std::shared_lock lock(m_Mutex);
+
+                    if (!isRunning(timerId, dppTimer))
+                        return;
+
+                    Timer timer(m_TimerDAO.findRecord(timerId), nullptr, &m_Clock);
 
-                Timer timer(m_TimerDAO.findOne(timerId));
+                    // Countdowns may store their message id, they are updated under the exclusive lock
+                    if (!timer.isOver() && !timer.getData().isEditInPlace())
+                    {
+                        if (m_Metrics.fireLateness != nullptr)
+                            m_Metrics.fireLateness->record(GetFireLateness(timer.getData(), now));
+
+                        sendMessage_NoLock(timerId, timer.getData().getChannel());
+                        recordTakeoverFire();
+                        return;
+                    }
+                }
+
+                std::unique_lock lock(m_Mutex);
+
+                if (!isRunning(timerId, dppTimer))
+                    return;
+
+                Timer timer(m_TimerDAO.findRecord(timerId), nullptr, &m_Clock);
 
                 if (!timer.isOver())
-                    sendMessage(timerId);
-                else
                 {
-                    m_Bot.log(dpp::ll_info, "Timer is over. Timer id: " + timerId);
-                    stopTimer(std::string(timerId));
+                    if (m_Metrics.fireLateness != nullptr)
+                        m_Metrics.fireLateness->record(GetFireLateness(timer.getData(), now));
+
+                    if (timer.getData().isEditInPlace())
+                        updateCountdown_NoLock(timerId);
+                    else
+                        sendMessage_NoLock(timerId, timer.getData().getChannel());
+
+                    recordTakeoverFire();
+
+                    lock.unlock();
+                    saveCountdownMessages();
+                    return;
                 }
 
+                Logger::Log(dpp::ll_info, "Timer is over", LogField("id", timerId));
+                stopTimer_NoLock(timerId);
+
             }, timer.getData().getInterval());
             
-            m_Bot.stop_timer(dppTimer);
+            m_Scheduler->stopTimer(dppTimer);
         }
+
+        lock.unlock();
+        saveCountdownMessages();
     }, secondsToNextInterval);
+
+    if (m_Metrics.activeTimers != nullptr)
+        m_Metrics.activeTimers->set(int64_t(m_RunningDppTimers.size()));
 }
 
-void TimerController::sendMessage(const std::string& timerId, const dpp::snowflake& channel) const
+bool TimerController::isRunning(const std::string& timerId, const dpp::timer& dppTimer) const
 {
-    Timer timer(m_TimerDAO.findOne(timerId));
+    auto it = m_RunningDppTimers.find(timerId);
 
-    auto msg = timer.parseString(timer.getData().getMessage());
-    dpp::embed embed;
-    
-    if (timer.getData().getTitle().empty())
-        embed.set_description(msg);
-    else
+    return it != m_RunningDppTimers.end() && it->second == dppTimer;
+}
+
+void TimerController::recordTakeoverFire()
+{
+    if (!m_AwaitingTakeoverFire.exchange(false, std::memory_order_relaxed))
+        return;
+
+    auto elapsed = m_Clock.now() - m_TakeoverStart;
+
+    if (m_Metrics.takeoverFirstFire != nullptr)
+        m_Metrics.takeoverFirstFire->record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+
+    Logger::Log(dpp::ll_info, "First timer fired since takeover", LogField("duration_ms", std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+}
+
+void TimerController::publishMutation(const std::string& timerId, TimerMutation::Type type) const
+{
+    TimerMutation mutation;
+    mutation.type = type;
+    mutation.id = timerId;
+
+    // Paused timers are not fired, the engine drops them
+    if (type == TimerMutation::Type::Upsert && m_TimerDAO.findOne(timerId).isPaused())
+        mutation.type = TimerMutation::Type::Remove;
+
+    if (mutation.type == TimerMutation::Type::Upsert)
     {
-        auto title = timer.parseString(timer.getData().getTitle());
-        embed.add_field(title, msg);
+        mutation.timer = m_TimerDAO.findOne(timerId);
+        mutation.zone = getGuildZone(mutation.timer.getGuild())->name();
     }
 
-    if (!timer.getData().getImageURL().empty())
-        embed.set_image(timer.getData().getImageURL());
+    thread_local std::string record;
+    mutation.encode(record);
 
-    m_Bot.message_create(dpp::message(channel, embed));
-    m_Bot.log(dpp::ll_info, "Timer \"" + timerId + "\" triggered");
+    // The timers are persisted first: the engine reloads them once it sees mutations were dropped
+    if (!m_FiringRing->tryPush(record))
+        Logger::Log(dpp::ll_warning, "Firing engine ring full, timer mutation dropped", LogField("id", timerId));
 }
 
-void TimerController::sendMessage(const std::string& timerId) const
+void TimerController::sendMessage(const std::string& timerId, const dpp::snowflake& channel, IMessageSink::Callback_Type onSent) const
 {
-    Timer timer(m_TimerDAO.findOne(timerId));
-    sendMessage(timerId, timer.getData().getChannel());
+    std::shared_lock lock(m_Mutex);
+    sendMessage_NoLock(timerId, channel, std::move(onSent));
 }
 
-bool TimerController::IsDatePassed(const TimePoint_Type& time)
+void TimerController::sendMessage(const std::string& timerId, IMessageSink::Callback_Type onSent) const
 {
-    return std::chrono::system_clock::now() > time;
+    std::shared_lock lock(m_Mutex);
+    sendMessage_NoLock(timerId, m_TimerDAO.findOne(timerId).getChannel(), std::move(onSent));
 }
 
-std::string TimerController::GetFormattedTime(const TimePoint_Type& time)
+void TimerController::sendMessage_NoLock(const std::string& timerId, const dpp::snowflake& channel, IMessageSink::Callback_Type onSent) const
 {
-    using namespace std::chrono;
-    
-    auto time_t = system_clock::to_time_t(time);
-    auto tm = std::localtime(&time_t);
+    TraceSpan span("TimerController::sendMessage");
 
-    std::stringstream ss;
-    ss << std::put_time(tm, "%d/%m/%Y %H:%M:%S");
+    auto it = m_Payloads.find(timerId);
 
-    return ss.str();
+    if (it == m_Payloads.end())
+        throw DAOIDNotFound(timerId);
+
+    if (m_Metrics.outboundQueueDepth != nullptr)
+    {
+        m_Metrics.outboundQueueDepth->add(1);
+
+        onSent = [depth = m_Metrics.outboundQueueDepth, onSent = std::move(onSent)](bool success) {
+            depth->add(-1);
+
+            if (onSent)
+                onSent(success);
+        };
+    }
+
+    thread_local std::string buffer;
+    const std::string* body;
+
+    {
+        TraceSpan renderSpan("TimerPayload::render");
+        body = &it->second.render(buffer, m_Clock.now());
+    }
+
+    {
+        TraceSpan sendSpan("IMessageSink::createMessage");
+        m_MessageSink->createMessage(channel, *body, std::move(onSent));
+    }
+
+    Logger::Log(dpp::ll_info, "Timer triggered", LogField("id", timerId), LogField("channel", channel));
 }
 
-TimerController::TimePoint_Type TimerController::ParseTime(const std::string& time)
+void TimerController::updateCountdown_NoLock(const std::string& timerId)
 {
-    std::stringstream ss(time);
-
-    int day = -1, month = -1, year = -1, hour = -1, minute = -1, second = -1;
-    char sep1, sep2, sep4, sep5;
+    TraceSpan span("TimerController::updateCountdown");
 
-    ss >> day >> sep1 >> month >> sep2 >> year >> hour >> sep4 >> minute >> sep5 >> second;
+    auto it = m_Payloads.find(timerId);
 
-    if (ss.fail() || sep1 != '/' || sep2 != '/' || sep4 != ':' || sep5 != ':')
-        throw ParsingException("Invalid time format: " + time);
+    if (it == m_Payloads.end())
+        throw DAOIDNotFound(timerId);
 
-    std::tm tm = {};
-    tm.tm_mday = day;
-    tm.tm_mon = month - 1;
-    tm.tm_year = year - 1900;
-    tm.tm_hour = hour;
-    tm.tm_min = minute;
-    tm.tm_sec = second;
+    auto timer = m_TimerDAO.findRecord(timerId);
 
-    auto tp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    // Posted by a previous fire, stored to keep editing it after a restart. The file is written by
+    // saveCountdownMessages once the lock is released
+    auto message = m_CountdownEditor.getMessage(timerId);
 
-    if (tp == std::chrono::system_clock::time_point{})
-        throw ParsingException("Could not parse time: " + time);
+    if (message != 0 && message != timer->getMessageID())
+        m_TimerDAO.setMessageID(timerId, message);
+    else
+        message = timer->getMessageID();
 
-    return tp;
+    thread_local std::string buffer;
+    m_CountdownEditor.update(timerId, timer->getChannel(), message, it->second.render(buffer, m_Clock.now()));
 }
 
-int64_t TimerController::ParseInteval(const std::string& interval)
+size_t TimerController::applyFiringReports(SharedRing& ring)
 {
-    // Luckily, s, m, h and d are in descending order
-    static std::map<std::string, int64_t, std::less<std::string>> multipliers = {
-        {"d", 60 * 60 * 24},
-        {"h", 60 * 60},
-        {"m", 60},
-        {"s", 1},
-    };
+    thread_local std::string record;
+    std::vector<TimerMutation> reports;
+
+    while (ring.tryPop(record))
+    {
+        try
+        {
+            reports.push_back(TimerMutation::Decode(record));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            Logger::Log(dpp::ll_error, "Invalid firing report", LogField("error", e.what()));
+        }
+    }
 
-    std::stringstream ss(interval);
-    int64_t total = 0;
-    auto nextPossible = multipliers.begin();
+    if (reports.empty())
+        return 0;
+
+    size_t stored = 0;
 
-    while (!ss.eof() && nextPossible != multipliers.end())
     {
-        int64_t value;
-        std::string unit;
+        std::unique_lock lock(m_Mutex);
 
-        ss >> value >> unit;
-        
-        if (ss.fail())
-            throw ParsingException("Invalid interval format (could not parse value): " + interval);
+        for (const auto& report : reports)
+        {
+            if (report.type != TimerMutation::Type::MessageCreated)
+                continue;
+
+            auto timer = m_TimerDAO.getDataMap().find(report.id);
 
-        auto it = multipliers.find(unit);
+            // Deleted since, or already stored
+            if (timer == nullptr || timer->getMessageID() == report.message)
+                continue;
 
-        if (it == multipliers.end())
-            throw ParsingException("Invalid interval unit: " + unit);
+            m_TimerDAO.setMessageID(report.id, report.message);
+            ++stored;
+        }
+    }
 
-        if (it->second > nextPossible->second)
-            throw ParsingException("Invalid interval format (not in descending order): " + interval);
+    // Written without the lock, as after a fire
+    saveCountdownMessages();
 
-        total += value * it->second;
+    return stored;
+}
 
-        nextPossible = it;
-        ++nextPossible;
+void TimerController::saveCountdownMessages()
+{
+    try
+    {
+        ScopedLatency timing(m_Metrics.daoUpdate);
+        m_TimerDAO.saveMessageIDs();
     }
+    catch (const std::exception& e)
+    {
+        // Kept in memory and written again by the next save, only lost by a restart meanwhile
+        Logger::Log(dpp::ll_warning, "Could not store countdown messages", LogField("error", e.what()));
+    }
+}
 
-    if (!ss.eof())
-        throw ParsingException("Invalid interval format (too many units): " + interval);
+std::string TimerController::FormatBulkReply(const std::string& verb, const BulkResult& result)
+{
+    auto reply = verb + " " + std::to_string(result.changed) + " timers.";
+
+    // Counted apart, they were stopped rather than changed
+    if (result.deleted > 0)
+        reply += " Stopped " + std::to_string(result.deleted) + " ended timers.";
+
+    return reply;
+}
+
+bool TimerController::IsDatePassed(const TimePoint_Type& time)
+{
+    return IsDatePassed(time, std::chrono::system_clock::now());
+}
+
+bool TimerController::IsDatePassed(const TimePoint_Type& time, const TimePoint_Type& now)
+{
+    return now > time;
+}
+
+std::chrono::nanoseconds TimerController::GetFireLateness(const TimerDTO& timer, const TimePoint_Type& now)
+{
+    using namespace std::chrono;
+
+    if (now < timer.getStart() || timer.getInterval() <= 0)
+        return nanoseconds(0);
+
+    auto interval = duration_cast<nanoseconds>(seconds(timer.getInterval()));
+    auto lateness = (now - timer.getStart()) % interval;
 
-    return total;
+    // Fired before the boundary, not after the previous one
+    return lateness > interval / 2 ? nanoseconds(0) : duration_cast<nanoseconds>(lateness);
+}
+
+std::string TimerController::GetFormattedTime(const TimePoint_Type& time)
+{
+    return TimeFormatter::Format(time, TimeFormatter::GetDefaultZone());
+}
+
+std::string TimerController::GetFormattedTime(const TimePoint_Type& time, TimeFormatter::Zone_Type zone)
+{
+    return TimeFormatter::Format(time, zone);
+}
+
+TimerController::TimePoint_Type TimerController::ParseTime(std::string_view time, TimeFormatter::Zone_Type zone)
+{
+    return TimeParser::ParseTime(time, zone);
+}
+
+int64_t TimerController::ParseInteval(std::string_view interval)
+{
+    return TimeParser::ParseInterval(interval);
 }
 
 /* Timer nested class */
 
-TimerController::Timer::Timer(const TimerDTO& timer)
-    : m_TimerDTO(timer)
+TimerController::Timer::Timer(TimerSnapshot::Record_Type timer, TimeFormatter::Zone_Type zone, const IClock* clock)
+    : m_TimerDTO(std::move(timer)), m_Zone(zone), m_Clock(clock != nullptr ? *clock : SYSTEM_CLOCK)
+{}
+
+TimerController::Timer::Timer(const TimerDTO& timer, TimeFormatter::Zone_Type zone, const IClock* clock)
+    : Timer(std::make_shared<const TimerDTO>(timer), zone, clock)
 {}
 
 bool TimerController::Timer::isOver() const
 {
-    return IsDatePassed(m_TimerDTO.getEnd());
+    return IsDatePassed(m_TimerDTO->getEnd(), m_Clock.now());
 }
 
 int64_t TimerController::Timer::getSecondsToNextInterval() const
 {
     using namespace std::chrono;
 
-    auto now = system_clock::now();
+    auto now = m_Clock.now();
 
-    if (now > m_TimerDTO.getEnd())
+    if (now > m_TimerDTO->getEnd())
         throw PastDateException("Timer is already over");
     
-    if (now < m_TimerDTO.getStart())
-        return duration_cast<seconds>(m_TimerDTO.getStart() - now).count();
+    if (now < m_TimerDTO->getStart())
+        return duration_cast<seconds>(m_TimerDTO->getStart() - now).count();
     else
     {
-        auto sinceStart = duration_cast<seconds>(now - m_TimerDTO.getStart()).count();
+        auto sinceStart = duration_cast<seconds>(now - m_TimerDTO->getStart()).count();
         
-        return m_TimerDTO.getInterval() - (sinceStart % m_TimerDTO.getInterval());
+        return m_TimerDTO->getInterval() - (sinceStart % m_TimerDTO->getInterval());
     }
 }
 
 std::string TimerController::Timer::parseString(const std::string& str) const
 {
-    std::string parsedMessage = str;
+    TraceSpan span("Timer::parseString");
 
-    auto now = std::chrono::system_clock::now();
-    auto remaining = m_TimerDTO.getEnd() - now;
+    std::string parsedMessage = parseStaticString(str);
+
+    auto now = m_Clock.now();
+    auto remaining = m_TimerDTO->getEnd() - now;
     auto secondsLeft = std::chrono::duration_cast<std::chrono::seconds>(remaining).count();
     
     std::unordered_map<std::string, std::string> replacements = {
-        {"{name}", m_TimerDTO.getName()},
-        {"{interval}", std::to_string(m_TimerDTO.getInterval())},
-        {"{start}", GetFormattedTime(m_TimerDTO.getStart())},
-        {"{end}", GetFormattedTime(m_TimerDTO.getEnd())},
         {"{rem:days}", std::to_string(secondsLeft / 60 / 60 / 24)},
         {"{rem:hours}", std::to_string(secondsLeft / 60 / 60)},
         {"{rem:minuts}", std::to_string(secondsLeft / 60)},
@@ -590,12 +1561,54 @@ std::string TimerController::Timer::parseString(const std::string& str) const
     return parsedMessage;
 }
 
+std::string TimerController::Timer::parseStaticString(const std::string& str) const
+{
+    std::string parsedMessage = str;
+
+    std::unordered_map<std::string, std::string> replacements = {
+        {"{name}", m_TimerDTO->getName()},
+        {"{interval}", std::to_string(m_TimerDTO->getInterval())},
+        {"{start}", GetFormattedTime(m_TimerDTO->getStart(), m_Zone)},
+        {"{end}", GetFormattedTime(m_TimerDTO->getEnd(), m_Zone)},
+    };
+
+    for (const auto& [placeholder, replacement] : replacements) {
+        size_t pos = 0;
+        while ((pos = parsedMessage.find(placeholder, pos)) != std::string::npos) {
+            parsedMessage.replace(pos, placeholder.length(), replacement);
+            pos += replacement.length();
+        }
+    }
+
+    return parsedMessage;
+}
+
+dpp::message TimerController::Timer::buildMessage() const
+{
+    auto msg = parseStaticString(m_TimerDTO->getMessage());
+    dpp::embed embed;
+    
+    if (m_TimerDTO->getTitle().empty())
+        embed.set_description(msg);
+    else
+    {
+        auto title = parseStaticString(m_TimerDTO->getTitle());
+        embed.add_field(title, msg);
+    }
+
+    if (!m_TimerDTO->getImageURL().empty())
+        embed.set_image(m_TimerDTO->getImageURL());
+
+    return dpp::message(dpp::snowflake(), embed);
+}
+
 std::ostream& operator<<(std::ostream& os, const TimerController::Timer& timer)
 {
     const auto& dto = timer.getData();
+    TimeFormatter::Buffer_Type start, end;
     os  << "\tName: " << dto.getName() << '\n'
-        << "\tStart: " << TimerController::GetFormattedTime(dto.getStart()) << '\n'
-        << "\tEnd: " << TimerController::GetFormattedTime(dto.getEnd()) << '\n'
+        << "\tStart: " << TimeFormatter::Format(dto.getStart(), timer.getZone(), start) << '\n'
+        << "\tEnd: " << TimeFormatter::Format(dto.getEnd(), timer.getZone(), end) << '\n'
         << "\tInterval: " << dto.getInterval() << " seconds\n";
 
     if (!dto.getTitle().empty())
@@ -607,6 +1620,12 @@ std::ostream& operator<<(std::ostream& os, const TimerController::Timer& timer)
     if (!dto.getImageURL().empty())
         os << "\tImage: " << dto.getImageURL() << '\n';
 
+    if (dto.isEditInPlace())
+        os << "\tEdits a single message\n";
+
+    if (dto.isPaused())
+        os << "\tPaused\n";
+
     return os;
 }
 
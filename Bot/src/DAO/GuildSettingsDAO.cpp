@@ -0,0 +1,157 @@
+#include "DAO/GuildSettingsDAO.h"
+
+#include <filesystem>
+
+#include "Tracing/Tracer.h"
+
+GuildSettingsDAO::GuildSettingsDAO(const ShardMap& shards)
+    : m_Shards(shards)
+{
+}
+
+void GuildSettingsDAO::add(const ID_Type& id, const GuildSettingsDTO& settings)
+{
+    TraceSpan span("GuildSettingsDAO::add");
+
+    if (!isIDValid(id))
+        throw DAOBadID(id);
+
+    if (idExists(id))
+        throw DAOIDAlreadyExists(id);
+
+    // Create needed directories
+    std::filesystem::create_directories(getFilePath(id).parent_path());
+    auto file = std::ofstream(getFilePath(id));
+
+    if (!file.is_open())
+        throw DAOOutputStreamException(id);
+
+    file << settings.getTimeZone() << std::endl;
+
+    if (file.bad())
+    {
+        file.close();
+        std::filesystem::remove(getFilePath(id));
+        throw DAOOutputStreamException(id);
+    }
+
+    m_Elements[id] = settings;
+    ++m_Version;
+}
+
+void GuildSettingsDAO::update(const ID_Type& id, const GuildSettingsDTO& settings)
+{
+    TraceSpan span("GuildSettingsDAO::update");
+
+    deleteByID(id);
+    add(id, settings);
+}
+
+void GuildSettingsDAO::deleteByID(const ID_Type& id)
+{
+    TraceSpan span("GuildSettingsDAO::deleteByID");
+
+    if (!isIDValid(id))
+        throw DAOBadID(id);
+
+    if (!idExists(id))
+        throw DAOIDNotFound(id);
+
+    std::filesystem::remove(getFilePath(id));
+    m_Elements.erase(id);
+    ++m_Version;
+}
+
+const GuildSettingsDAO::DTO_Type& GuildSettingsDAO::findOne(const ID_Type& id) const
+{
+    if (!isIDValid(id))
+        throw DAOBadID(id);
+
+    if (!idExists(id))
+        throw DAOIDNotFound(id);
+
+    return m_Elements.at(id);
+}
+
+std::vector<GuildSettingsDAO::DTO_Type> GuildSettingsDAO::findAll() const
+{
+    std::vector<GuildSettingsDTO> settings;
+
+    for (const auto& [id, guildSettings] : m_Elements)
+        settings.push_back(guildSettings);
+
+    return settings;
+}
+
+bool GuildSettingsDAO::idExists(const ID_Type& id) const
+{
+    return m_Elements.contains(id);
+}
+
+bool GuildSettingsDAO::isIDValid(const ID_Type& id) const
+{
+    return id != 0;
+}
+
+void GuildSettingsDAO::loadGuildSettings()
+{
+    TraceSpan span("GuildSettingsDAO::loadGuildSettings");
+
+    m_Elements.clear();
+    ++m_Version;
+
+    for (uint32_t shard : m_Shards.getOwnedShards())
+        loadDirectory(m_Shards.getShardDirectory(shard) / "guilds", false);
+
+    if (m_Shards.isPartitioned())
+        loadDirectory(ShardMap::GetDataDirectory() / "guilds", true);
+}
+
+void GuildSettingsDAO::loadDirectory(const std::filesystem::path& directory, bool migrate)
+{
+    if (!std::filesystem::exists(directory))
+        return;
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+    {
+        if (!entry.is_regular_file() || !entry.path().has_extension() || entry.path().extension() != ".txt")
+            continue;
+
+        auto file = std::ifstream(entry.path());
+
+        if (!file.is_open())
+            throw DAOInputStreamException();
+
+        std::string timeZone;
+        std::getline(file, timeZone);
+
+        if (file.bad())
+            throw DAOInputStreamException();
+
+        ID_Type id;
+
+        try {
+            id = dpp::snowflake(std::stoull(entry.path().stem().string()));
+        } catch (const std::logic_error&) {
+            throw DAOParsingException(entry.path().string());
+        }
+
+        if (migrate)
+        {
+            // Left to the process owning its shard
+            if (!m_Shards.ownsGuild(id))
+                continue;
+
+            file.close();
+            std::filesystem::create_directories(getFilePath(id).parent_path());
+            std::filesystem::rename(entry.path(), getFilePath(id));
+        }
+
+        m_Elements[id] = GuildSettingsDTO(id, timeZone);
+    }
+}
+
+std::filesystem::path GuildSettingsDAO::getFilePath(const ID_Type& id) const
+{
+    return m_Shards.getDirectory(id) / "guilds" / (std::to_string(id) + ".txt");
+}
@@ -1,18 +1,52 @@
 #include "DAO/TimerDAO.h"
 
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
+#include <random>
+#include <unordered_set>
+
+#include "Logging/Logger.h"
+#include "Tracing/Tracer.h"
+
+static constexpr const char* JOURNAL_FILE = "journal.log";
+
+/**
+ * @brief Make a journal generation, unique to each reset.
+ */
+static std::string NewJournalGeneration()
+{
+    std::random_device random;
+    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    char generation[40];
+    std::snprintf(generation, sizeof(generation), "%08x%016llx", random(), (unsigned long long)now);
+
+    return generation;
+}
+
+TimerDAO::TimerDAO(const ShardMap& shards)
+    : m_Shards(shards)
+{
+}
 
 void TimerDAO::add(const ID_Type& id, const TimerDTO& timer)
 {
+    TraceSpan span("TimerDAO::add");
+
     if (!isIDValid(id))
         throw DAOBadID(id);
 
     if (idExists(id))
         throw DAOIDAlreadyExists(id);
+
+    std::lock_guard lock(m_FileWrites.mutex);
     
+    auto path = getFilePath(id, timer.getGuild());
+
     // Create needed directories
-    std::filesystem::create_directories("data/timers");
-    auto file = std::ofstream("data/timers/" + id + ".txt");
+    std::filesystem::create_directories(path.parent_path());
+    auto file = std::ofstream(path);
 
     if (!file.is_open())
         throw DAOOutputStreamException(id);
@@ -20,30 +54,250 @@ void TimerDAO::add(const ID_Type& id, const TimerDTO& timer)
     try {
         writeTimer(file, timer);
     } catch (...) {
-        std::filesystem::remove("data/timers/" + id + ".txt");
+        std::filesystem::remove(path);
         file.close();
         throw;
     }
 
-    m_Elements[id] = timer;
+    // Journaled once complete, a follower reading the file right away must not see it partly written
+    file.close();
+    appendJournal(id, timer.getGuild(), '+');
+
+    TimerSnapshot::Builder timers(getDataMap());
+    timers.set(id, std::make_shared<const TimerDTO>(timer));
+    publish(timers);
 }
 
 void TimerDAO::update(const ID_Type& id, const TimerDTO& timer)
 {
-    deleteByID(id);
-    add(id, timer);
+    TraceSpan span("TimerDAO::update");
+
+    // Replaced at once, the timer is never missing from a published version
+    updateMany({ { id, timer } });
 }
 
 void TimerDAO::deleteByID(const ID_Type& id)
 {
+    TraceSpan span("TimerDAO::deleteByID");
+
     if (!isIDValid(id))
         throw DAOBadID(id);
 
     if (!idExists(id))
         throw DAOIDNotFound(id);
 
-    std::filesystem::remove("data/timers/" + id + ".txt");
-    m_Elements.erase(id);
+    std::lock_guard lock(m_FileWrites.mutex);
+    auto guild = findOne(id).getGuild();
+
+    std::filesystem::remove(getFilePath(id, guild));
+    appendJournal(id, guild, '-');
+
+    TimerSnapshot::Builder timers(getDataMap());
+    timers.erase(id);
+    publish(timers);
+}
+
+void TimerDAO::updateMany(const std::vector<std::pair<ID_Type, TimerDTO>>& timers)
+{
+    updateMany(timers, {});
+}
+
+void TimerDAO::updateMany(const std::vector<std::pair<ID_Type, TimerDTO>>& timers, const std::vector<ID_Type>& deleted)
+{
+    TraceSpan span("TimerDAO::updateMany");
+
+    // Checked first, so that a bad id leaves every timer untouched
+    for (const auto& [id, _] : timers)
+    {
+        if (!isIDValid(id))
+            throw DAOBadID(id);
+
+        if (!idExists(id))
+            throw DAOIDNotFound(id);
+    }
+
+    for (const auto& id : deleted)
+    {
+        if (!isIDValid(id))
+            throw DAOBadID(id);
+
+        if (!idExists(id))
+            throw DAOIDNotFound(id);
+    }
+
+    std::lock_guard lock(m_FileWrites.mutex);
+
+    // Written aside first, so that a failed write leaves every timer untouched
+    std::vector<std::filesystem::path> temporaryPaths;
+    temporaryPaths.reserve(timers.size());
+
+    try
+    {
+        for (const auto& [id, timer] : timers)
+        {
+            auto temporaryPath = getFilePath(id, timer.getGuild());
+            temporaryPath += ".tmp";
+
+            std::filesystem::create_directories(temporaryPath.parent_path());
+            auto file = std::ofstream(temporaryPath);
+
+            if (!file.is_open())
+                throw DAOOutputStreamException(id);
+
+            temporaryPaths.push_back(temporaryPath);
+            writeTimer(file, timer);
+        }
+    }
+    catch (...)
+    {
+        std::error_code error;
+
+        for (const auto& temporaryPath : temporaryPaths)
+            std::filesystem::remove(temporaryPath, error);
+
+        throw;
+    }
+
+    std::vector<JournalEntry> journaled;
+    journaled.reserve(timers.size() + deleted.size());
+
+    TimerSnapshot::Builder updated(getDataMap());
+
+    // A follower rereads the file of each journaled id, whatever the operation. Also done if a rename or a delete
+    // fails, so that the timers already changed are not missed by the listings and the followers
+    auto commit = [this, &journaled, &updated]() {
+        appendJournal(journaled);
+
+        if (!journaled.empty())
+            publish(updated);
+    };
+
+    try
+    {
+        for (size_t i = 0; i < timers.size(); ++i)
+        {
+            const auto& [id, timer] = timers[i];
+            auto previousGuild = findOne(id).getGuild();
+            auto previousPath = getFilePath(id, previousGuild);
+            auto path = getFilePath(id, timer.getGuild());
+
+            std::filesystem::rename(temporaryPaths[i], path);
+
+            if (previousPath != path)
+            {
+                std::filesystem::remove(previousPath);
+                journaled.push_back({ id, previousGuild, '-' });
+            }
+
+            journaled.push_back({ id, timer.getGuild(), '+' });
+            updated.set(id, std::make_shared<const TimerDTO>(timer));
+        }
+
+        std::unordered_set<ID_Type> seen;
+
+        for (const auto& id : deleted)
+        {
+            // Listed twice
+            if (!seen.insert(id).second)
+                continue;
+
+            auto guild = findOne(id).getGuild();
+
+            std::filesystem::remove(getFilePath(id, guild));
+            journaled.push_back({ id, guild, '-' });
+            updated.erase(id);
+        }
+    }
+    catch (...)
+    {
+        commit();
+        throw;
+    }
+
+    commit();
+}
+
+void TimerDAO::deleteMany(const std::vector<ID_Type>& ids)
+{
+    TraceSpan span("TimerDAO::deleteMany");
+
+    updateMany({}, ids);
+}
+
+void TimerDAO::setMessageID(const ID_Type& id, const dpp::snowflake& message)
+{
+    auto timer = std::make_shared<TimerDTO>(*findRecord(id));
+    timer->setMessageID(message);
+
+    std::lock_guard lock(m_FileWrites.mutex);
+    m_FileWrites.unsavedMessageIDs.insert(id);
+
+    TimerSnapshot::Builder timers(getDataMap());
+    timers.set(id, std::move(timer));
+
+    // Not listed, the listings rendered at this version stay valid
+    auto snapshot = timers.build(m_Version);
+
+    std::lock_guard snapshotLock(m_Snapshot.mutex);
+    m_Snapshot.current = std::move(snapshot);
+}
+
+void TimerDAO::saveMessageIDs()
+{
+    TraceSpan span("TimerDAO::saveMessageIDs");
+
+    std::lock_guard lock(m_FileWrites.mutex);
+
+    if (m_FileWrites.unsavedMessageIDs.empty())
+        return;
+
+    // The mutations write their files under the same lock, so the published timers are the ones stored
+    auto timers = snapshot();
+    std::vector<JournalEntry> written;
+
+    // A follower rereads the file of each journaled id, the message id included
+    auto commit = [this, &written]() {
+        appendJournal(written);
+    };
+
+    try
+    {
+        while (!m_FileWrites.unsavedMessageIDs.empty())
+        {
+            const auto& id = *m_FileWrites.unsavedMessageIDs.begin();
+            auto timer = timers->find(id);
+
+            // Deleted since
+            if (timer != nullptr)
+            {
+                auto path = getFilePath(id, timer->getGuild());
+                auto temporaryPath = path;
+                temporaryPath += ".tmp";
+
+                {
+                    auto file = std::ofstream(temporaryPath);
+
+                    if (!file.is_open())
+                        throw DAOOutputStreamException(id);
+
+                    writeTimer(file, *timer);
+                }
+
+                // Replaced at once, a follower never reads the file partly written
+                std::filesystem::rename(temporaryPath, path);
+                written.push_back({ id, timer->getGuild(), '+' });
+            }
+
+            m_FileWrites.unsavedMessageIDs.erase(m_FileWrites.unsavedMessageIDs.begin());
+        }
+    }
+    catch (...)
+    {
+        commit();
+        throw;
+    }
+
+    commit();
 }
 
 const TimerDAO::DTO_Type& TimerDAO::findOne(const ID_Type& id) const
@@ -51,25 +305,47 @@ const TimerDAO::DTO_Type& TimerDAO::findOne(const ID_Type& id) const
     if (!isIDValid(id))
         throw DAOBadID(id);
 
-    if (!idExists(id))
+    auto timer = getDataMap().find(id);
+
+    if (timer == nullptr)
         throw DAOIDNotFound(id);
 
-    return m_Elements.at(id);
+    // Kept alive by the current snapshot until the next mutation
+    return *timer;
+}
+
+TimerDAO::Record_Type TimerDAO::findRecord(const ID_Type& id) const
+{
+    if (!isIDValid(id))
+        throw DAOBadID(id);
+
+    auto timer = getDataMap().find(id);
+
+    if (timer == nullptr)
+        throw DAOIDNotFound(id);
+
+    return timer;
+}
+
+TimerDAO::Snapshot_Type TimerDAO::snapshot() const
+{
+    return m_Snapshot.load();
 }
 
 std::vector<TimerDAO::DTO_Type> TimerDAO::findAll() const
 {
     std::vector<TimerDTO> timers;
+    timers.reserve(getDataMap().size());
 
-    for (const auto& [id, timer] : m_Elements)
-        timers.push_back(timer);
+    for (const auto& [id, timer] : getDataMap())
+        timers.push_back(*timer);
 
     return timers;
 }
 
 bool TimerDAO::idExists(const ID_Type& id) const
 {
-    return m_Elements.contains(id);
+    return getDataMap().contains(id);
 }
 
 bool TimerDAO::isIDValid(const ID_Type& id) const
@@ -88,7 +364,11 @@ void TimerDAO::writeTimer(std::ostream& os, const TimerDTO& timer) const
         << duration_cast<seconds>(timer.getStart().time_since_epoch()).count() << std::endl
         << duration_cast<seconds>(timer.getEnd().time_since_epoch()).count() << std::endl
         << timer.getImageURL() << std::endl
-        << timer.getTitle() << std::endl;
+        << timer.getTitle() << std::endl
+        << timer.getGuild() << std::endl
+        << (timer.isPaused() ? 1 : 0) << std::endl
+        << (timer.isEditInPlace() ? 1 : 0) << std::endl
+        << timer.getMessageID() << std::endl;
 
     if (os.bad())
         throw DAOOutputStreamException();
@@ -106,6 +386,10 @@ TimerDTO TimerDAO::readTimer(std::istream& is) const
     int64_t end;
     std::string imageURL;
     std::string title;
+    dpp::snowflake guild;
+    bool paused = false;
+    bool editInPlace = false;
+    dpp::snowflake messageID;
     std::string line;
 
     // Name
@@ -128,18 +412,64 @@ TimerDTO TimerDAO::readTimer(std::istream& is) const
     std::getline(is, imageURL);
     // Title
     std::getline(is, title);
+    // Guild (missing in files written before guild settings)
+    if (std::getline(is, line) && !line.empty())
+        guild = dpp::snowflake(std::stoull(line));
+    // Paused (missing in files written before bulk operations)
+    if (std::getline(is, line) && !line.empty())
+        paused = line == "1";
+    // Edit in place and its message (missing in files written before countdown messages)
+    if (std::getline(is, line) && !line.empty())
+        editInPlace = line == "1";
+    if (std::getline(is, line) && !line.empty())
+        messageID = dpp::snowflake(std::stoull(line));
 
     if (is.bad())
         throw DAOInputStreamException();
 
-    return TimerDTO(name, channel, interval, message, TimerDTO::TimePoint_Type(seconds(start)), TimerDTO::TimePoint_Type(seconds(end)), imageURL, title);
+    TimerDTO timer(name, channel, interval, message, TimerDTO::TimePoint_Type(seconds(start)), TimerDTO::TimePoint_Type(seconds(end)), imageURL, title, guild);
+    timer.setPaused(paused);
+    timer.setEditInPlace(editInPlace);
+    timer.setMessageID(messageID);
+
+    return timer;
+}
+
+std::filesystem::path TimerDAO::getFilePath(const ID_Type& id, const dpp::snowflake& guild) const
+{
+    return m_Shards.getDirectory(guild) / "timers" / (id + ".txt");
 }
 
 void TimerDAO::loadTimers()
 {
-    m_Elements.clear();
+    TraceSpan span("TimerDAO::loadTimers");
+
+    std::lock_guard lock(m_FileWrites.mutex);
+
+    m_JournalPositions.clear();
+
+    // Published once complete, the previous timers stay readable meanwhile
+    TimerSnapshot::Builder timers;
+
+    for (uint32_t shard : m_Shards.getOwnedShards())
+    {
+        // Taken before reading, the changes journaled meanwhile are applied again by the next follow
+        m_JournalPositions[shard] = getJournalEnd(shard);
+        loadDirectory(m_Shards.getShardDirectory(shard) / "timers", false, timers);
+    }
+
+    if (m_Shards.isPartitioned())
+        loadDirectory(ShardMap::GetDataDirectory() / "timers", true, timers);
+
+    publish(timers);
+}
+
+void TimerDAO::loadDirectory(const std::filesystem::path& directory, bool migrate, TimerSnapshot::Builder& timers)
+{
+    if (!std::filesystem::exists(directory))
+        return;
 
-    for (const auto& entry : std::filesystem::directory_iterator("data/timers"))
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
     {
         if (!entry.is_regular_file() || !entry.path().has_extension() || entry.path().extension() != ".txt")
             continue;
@@ -149,13 +479,265 @@ void TimerDAO::loadTimers()
         if (!file.is_open())
             throw DAOInputStreamException();
 
+        TimerDTO timer;
+
         try {
-            auto timer = readTimer(file);
-            ID_Type id = entry.path().stem().string();
-            m_Elements[id] = timer;
+            timer = readTimer(file);
         } catch (...) {
             file.close();
             throw;
         }
+
+        file.close();
+        ID_Type id = entry.path().stem().string();
+
+        if (migrate)
+        {
+            // Left to the process owning its shard
+            if (!m_Shards.ownsGuild(timer.getGuild()))
+                continue;
+
+            auto path = getFilePath(id, timer.getGuild());
+            std::filesystem::create_directories(path.parent_path());
+            std::filesystem::rename(entry.path(), path);
+        }
+
+        timers.set(id, std::make_shared<const TimerDTO>(std::move(timer)));
+    }
+}
+
+void TimerDAO::resetJournals()
+{
+    for (uint32_t shard : m_Shards.getOwnedShards())
+        resetJournal(shard);
+}
+
+void TimerDAO::resetJournal(uint32_t shard)
+{
+    auto path = getJournalPath(shard);
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+
+    std::filesystem::create_directories(path.parent_path());
+
+    JournalPosition position{ NewJournalGeneration(), 0 };
+
+    {
+        std::ofstream journal(temporaryPath, std::ios::binary | std::ios::trunc);
+        journal << position.generation << '\n';
+
+        if (!journal)
+            throw DAOOutputStreamException(path.string());
+    }
+
+    // Replaced at once, a follower reads either the old journal or the new one
+    std::filesystem::rename(temporaryPath, path);
+
+    position.offset = position.generation.size() + 1;
+    m_JournalPositions[shard] = position;
+}
+
+std::vector<TimerDAO::ID_Type> TimerDAO::followJournals()
+{
+    TraceSpan span("TimerDAO::followJournals");
+
+    std::unique_lock lock(m_FileWrites.mutex);
+
+    std::vector<std::pair<uint32_t, ID_Type>> touched;
+    bool reset = false;
+
+    for (uint32_t shard : m_Shards.getOwnedShards())
+    {
+        auto& position = m_JournalPositions[shard];
+        std::ifstream journal(getJournalPath(shard), std::ios::binary);
+
+        if (!journal.is_open())
+        {
+            reset = reset || !position.generation.empty();
+            continue;
+        }
+
+        std::string generation;
+
+        if (!std::getline(journal, generation) || journal.eof())
+            continue;
+
+        if (generation != position.generation)
+        {
+            // A journal created after the load only holds changes made since
+            if (!position.generation.empty())
+            {
+                reset = true;
+                break;
+            }
+
+            position = JournalPosition{ generation, generation.size() + 1 };
+        }
+
+        journal.seekg(std::streamoff(position.offset));
+        std::string line;
+
+        // A line without end is still being written, it is read by the next follow
+        while (std::getline(journal, line) && !journal.eof())
+        {
+            position.offset += line.size() + 1;
+
+            if (line.size() > 1)
+                touched.emplace_back(shard, line.substr(1));
+        }
+    }
+
+    std::vector<ID_Type> changed;
+
+    if (reset)
+    {
+        std::unordered_set<ID_Type> ids;
+
+        for (const auto& [id, _] : getDataMap())
+            ids.insert(id);
+
+        // Taken again by the load
+        lock.unlock();
+        loadTimers();
+
+        for (const auto& [id, _] : getDataMap())
+            ids.insert(id);
+
+        changed.assign(ids.begin(), ids.end());
+        return changed;
+    }
+
+    std::unordered_set<ID_Type> seen;
+    TimerSnapshot::Builder timers(getDataMap());
+
+    // The file holds the latest state, whatever the operation journaled
+    for (const auto& [shard, id] : touched)
+    {
+        if (!seen.insert(id).second)
+            continue;
+
+        TimerDTO timer;
+
+        try
+        {
+            if (readTimerFile(m_Shards.getShardDirectory(shard) / "timers" / (id + ".txt"), timer))
+                timers.set(id, std::make_shared<const TimerDTO>(std::move(timer)));
+            else
+                timers.erase(id);
+        }
+        catch (const std::exception& e)
+        {
+            // Replaced while read, the replacement is journaled after this line
+            Logger::Log(dpp::ll_debug, "Could not follow timer", LogField("id", id), LogField("error", e.what()));
+            continue;
+        }
+
+        changed.push_back(id);
     }
+
+    if (!changed.empty())
+        publish(timers);
+
+    return changed;
+}
+
+void TimerDAO::publish(TimerSnapshot::Builder& timers)
+{
+    auto snapshot = timers.build(++m_Version);
+
+    std::lock_guard lock(m_Snapshot.mutex);
+    m_Snapshot.current = std::move(snapshot);
+}
+
+std::filesystem::path TimerDAO::getJournalPath(uint32_t shard) const
+{
+    return m_Shards.getShardDirectory(shard) / "timers" / JOURNAL_FILE;
+}
+
+void TimerDAO::appendJournal(const ID_Type& id, const dpp::snowflake& guild, char operation)
+{
+    if (!m_Journaled)
+        return;
+
+    appendJournal({ { id, guild, operation } });
+}
+
+void TimerDAO::appendJournal(const std::vector<JournalEntry>& entries)
+{
+    if (!m_Journaled || entries.empty())
+        return;
+
+    std::map<uint32_t, std::string> lines;
+
+    for (const auto& [id, guild, operation] : entries)
+    {
+        auto& shardLines = lines[m_Shards.getShard(guild)];
+        shardLines += operation;
+        shardLines += id;
+        shardLines += '\n';
+    }
+
+    for (const auto& [shard, shardLines] : lines)
+    {
+        auto path = getJournalPath(shard);
+        bool created = !std::filesystem::exists(path);
+
+        std::ofstream journal(path, std::ios::binary | std::ios::app);
+
+        if (created)
+            journal << NewJournalGeneration() << '\n';
+
+        journal << shardLines;
+
+        // The timers themselves are stored, only a standby process misses the changes until it reloads
+        if (!journal)
+        {
+            Logger::Log(dpp::ll_warning, "Could not journal timers", LogField("count", entries.size()), LogField("journal", path.string()));
+            continue;
+        }
+
+        if (uint64_t(journal.tellp()) <= m_MaxJournalSize)
+            continue;
+
+        journal.close();
+
+        try
+        {
+            resetJournal(shard);
+        }
+        catch (const std::exception& e)
+        {
+            // Retried by the next append
+            Logger::Log(dpp::ll_warning, "Could not reset journal", LogField("journal", path.string()), LogField("error", e.what()));
+        }
+    }
+}
+
+TimerDAO::JournalPosition TimerDAO::getJournalEnd(uint32_t shard) const
+{
+    JournalPosition position;
+    std::ifstream journal(getJournalPath(shard), std::ios::binary | std::ios::ate);
+
+    if (!journal.is_open())
+        return position;
+
+    auto size = journal.tellg();
+    journal.seekg(0);
+
+    if (!std::getline(journal, position.generation) || journal.eof())
+        return JournalPosition();
+
+    position.offset = uint64_t(size);
+    return position;
+}
+
+bool TimerDAO::readTimerFile(const std::filesystem::path& path, TimerDTO& timer) const
+{
+    auto file = std::ifstream(path);
+
+    if (!file.is_open())
+        return false;
+
+    timer = readTimer(file);
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "DAO/TimerNameIndex.h"
+
+#include <algorithm>
+
+void TimerNameIndex::rebuild(const TimerDAO::Map_Type& timers)
+{
+    std::unordered_map<dpp::snowflake, std::vector<std::string>> guildNames;
+
+    for (const auto& [name, timer] : timers)
+        guildNames[timer->getGuild()].push_back(name);
+
+    // Sorting once, inserting one by one would move the vector for each name
+    for (auto& [_, names] : guildNames)
+        std::sort(names.begin(), names.end());
+
+    // Built aside, the queries only wait for the swap
+    std::unique_lock lock(m_Mutex);
+    m_Names.swap(guildNames);
+}
+
+void TimerNameIndex::add(const dpp::snowflake& guild, const std::string& name)
+{
+    std::unique_lock lock(m_Mutex);
+
+    auto& names = m_Names[guild];
+    auto it = std::lower_bound(names.begin(), names.end(), name);
+
+    if (it == names.end() || *it != name)
+        names.insert(it, name);
+}
+
+void TimerNameIndex::remove(const dpp::snowflake& guild, const std::string& name)
+{
+    std::unique_lock lock(m_Mutex);
+
+    auto guildNames = m_Names.find(guild);
+
+    if (guildNames == m_Names.end())
+        return;
+
+    auto& names = guildNames->second;
+    auto it = std::lower_bound(names.begin(), names.end(), name);
+
+    if (it != names.end() && *it == name)
+        names.erase(it);
+
+    if (names.empty())
+        m_Names.erase(guildNames);
+}
+
+std::vector<std::string> TimerNameIndex::findByPrefix(const dpp::snowflake& guild, std::string_view prefix, size_t limit) const
+{
+    std::vector<std::string> result;
+
+    std::shared_lock lock(m_Mutex);
+    auto guildNames = m_Names.find(guild);
+
+    if (guildNames == m_Names.end())
+        return result;
+
+    const auto& names = guildNames->second;
+
+    // Names starting with the prefix are contiguous, from the first name not less than the prefix
+    auto it = std::lower_bound(names.begin(), names.end(), prefix, [](const std::string& name, std::string_view prefix) {
+        return std::string_view(name) < prefix;
+    });
+
+    for (; it != names.end() && result.size() < limit && it->starts_with(prefix); ++it)
+        result.push_back(*it);
+
+    return result;
+}
+
+size_t TimerNameIndex::size(const dpp::snowflake& guild) const
+{
+    std::shared_lock lock(m_Mutex);
+
+    auto guildNames = m_Names.find(guild);
+
+    return guildNames == m_Names.end() ? 0 : guildNames->second.size();
+}
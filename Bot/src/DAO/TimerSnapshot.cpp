@@ -0,0 +1,245 @@
+#include "DAO/TimerSnapshot.h"
+
+#include <functional>
+#include <utility>
+
+TimerSnapshot::TimerSnapshot(uint64_t version)
+    : m_Version(version), m_Root(GetEmptyLeaf())
+{
+}
+
+TimerSnapshot::TimerSnapshot(uint64_t version, Node_Type root, size_t size)
+    : m_Version(version), m_Size(size), m_Root(std::move(root))
+{
+}
+
+TimerSnapshot::Record_Type TimerSnapshot::find(const std::string& id) const
+{
+    return Find(*m_Root, id);
+}
+
+TimerSnapshot::Record_Type TimerSnapshot::Find(const Node& root, const std::string& id)
+{
+    auto hash = std::hash<std::string>{}(id);
+    const Node* node = &root;
+
+    for (size_t depth = 0; !node->children.empty(); ++depth)
+    {
+        node = node->children[GetChildIndex(hash, depth)].get();
+
+        if (node == nullptr)
+            return nullptr;
+    }
+
+    for (const auto& [entryId, timer] : node->entries)
+    {
+        if (entryId == id)
+            return timer;
+    }
+
+    return nullptr;
+}
+
+size_t TimerSnapshot::GetChildIndex(size_t hash, size_t depth)
+{
+    return (hash >> (depth * BRANCH_BITS)) & (BRANCH_COUNT - 1);
+}
+
+const TimerSnapshot::Node_Type& TimerSnapshot::GetEmptyLeaf()
+{
+    static const Node_Type EMPTY_LEAF = std::make_shared<const Node>();
+    return EMPTY_LEAF;
+}
+
+/* Iterator */
+
+TimerSnapshot::Iterator::Iterator(const Node* root)
+{
+    if (root == nullptr)
+        return;
+
+    if (root->children.empty())
+        m_Leaf = root;
+    else
+        m_Frames[m_Depth++] = Frame{ root, 0 };
+
+    settle();
+}
+
+TimerSnapshot::Iterator& TimerSnapshot::Iterator::operator++()
+{
+    ++m_Entry;
+    settle();
+
+    return *this;
+}
+
+TimerSnapshot::Iterator TimerSnapshot::Iterator::operator++(int)
+{
+    auto previous = *this;
+    ++*this;
+
+    return previous;
+}
+
+void TimerSnapshot::Iterator::settle()
+{
+    while (m_Leaf == nullptr || m_Entry == m_Leaf->entries.size())
+    {
+        m_Leaf = nullptr;
+        m_Entry = 0;
+
+        // Every leaf visited
+        if (m_Depth == 0)
+            return;
+
+        auto& frame = m_Frames[m_Depth - 1];
+
+        if (frame.next == BRANCH_COUNT)
+        {
+            --m_Depth;
+            continue;
+        }
+
+        const Node* child = frame.node->children[frame.next++].get();
+
+        if (child == nullptr)
+            continue;
+
+        if (child->children.empty())
+            m_Leaf = child;
+        else
+            m_Frames[m_Depth++] = Frame{ child, 0 };
+    }
+}
+
+/* Builder */
+
+TimerSnapshot::Builder::Builder()
+    : m_Root(GetEmptyLeaf())
+{
+}
+
+TimerSnapshot::Builder::Builder(const TimerSnapshot& snapshot)
+    : m_Root(snapshot.m_Root), m_Size(snapshot.m_Size)
+{
+}
+
+void TimerSnapshot::Builder::set(const std::string& id, Record_Type timer)
+{
+    size_t depth;
+    auto& leaf = getLeaf(id, depth);
+
+    for (auto& [entryId, entryTimer] : leaf.entries)
+    {
+        if (entryId == id)
+        {
+            entryTimer = std::move(timer);
+            return;
+        }
+    }
+
+    leaf.entries.emplace_back(id, std::move(timer));
+    ++m_Size;
+
+    if (leaf.entries.size() > LEAF_CAPACITY && depth < MAX_DEPTH)
+        split(leaf, depth);
+}
+
+void TimerSnapshot::Builder::erase(const std::string& id)
+{
+    // Not copied when there is nothing to remove
+    if (Find(*m_Root, id) == nullptr)
+        return;
+
+    size_t depth;
+    auto& entries = getLeaf(id, depth).entries;
+
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->first != id)
+            continue;
+
+        // The order of the entries of a leaf does not matter
+        *it = std::move(entries.back());
+        entries.pop_back();
+        --m_Size;
+
+        return;
+    }
+}
+
+std::shared_ptr<const TimerSnapshot> TimerSnapshot::Builder::build(uint64_t version)
+{
+    m_Owned.clear();
+
+    // The constructor is private
+    return std::shared_ptr<const TimerSnapshot>(new TimerSnapshot(version, std::move(m_Root), m_Size));
+}
+
+TimerSnapshot::Node& TimerSnapshot::Builder::getLeaf(const std::string& id, size_t& depth)
+{
+    auto hash = std::hash<std::string>{}(id);
+    Node* node = &own(m_Root);
+
+    for (depth = 0; !node->children.empty(); ++depth)
+    {
+        auto& child = node->children[GetChildIndex(hash, depth)];
+
+        if (child == nullptr)
+        {
+            auto leaf = std::make_shared<Node>();
+            m_Owned.insert(leaf.get());
+            child = std::move(leaf);
+        }
+
+        node = &own(child);
+    }
+
+    return *node;
+}
+
+TimerSnapshot::Node& TimerSnapshot::Builder::own(Node_Type& node)
+{
+    // Created by this builder as a mutable node, only exposed as const once published
+    if (m_Owned.contains(node.get()))
+        return const_cast<Node&>(*node);
+
+    auto copy = std::make_shared<Node>(*node);
+    m_Owned.insert(copy.get());
+    node = copy;
+
+    return *copy;
+}
+
+void TimerSnapshot::Builder::split(Node& leaf, size_t depth)
+{
+    leaf.children.resize(BRANCH_COUNT);
+
+    for (auto& entry : leaf.entries)
+    {
+        auto& child = leaf.children[GetChildIndex(std::hash<std::string>{}(entry.first), depth)];
+
+        if (child == nullptr)
+        {
+            auto newLeaf = std::make_shared<Node>();
+            m_Owned.insert(newLeaf.get());
+            child = std::move(newLeaf);
+        }
+
+        const_cast<Node&>(*child).entries.push_back(std::move(entry));
+    }
+
+    leaf.entries.clear();
+    leaf.entries.shrink_to_fit();
+
+    // All the timers of the leaf may share the next bits of their hashes
+    if (depth + 1 == MAX_DEPTH)
+        return;
+
+    for (auto& child : leaf.children)
+    {
+        if (child != nullptr && child->entries.size() > LEAF_CAPACITY)
+            split(const_cast<Node&>(*child), depth + 1);
+    }
+}
@@ -0,0 +1,126 @@
+#include "Discord/CountdownEditor.h"
+
+CountdownEditor::CountdownEditor(IMessageSink& sink)
+    : m_Sink(sink)
+{
+}
+
+void CountdownEditor::update(const std::string& key, const dpp::snowflake& channel, const dpp::snowflake& message, std::string body)
+{
+    std::unique_lock lock(m_Mutex);
+
+    auto [it, inserted] = m_Countdowns.try_emplace(key);
+    auto& countdown = it->second;
+
+    if (inserted)
+    {
+        countdown.channel = channel;
+        countdown.message = message;
+        countdown.generation = m_NextGeneration++;
+    }
+
+    // The message in the previous channel is left as it is
+    if (countdown.channel != channel)
+    {
+        countdown.channel = channel;
+        countdown.message = 0;
+    }
+
+    if (countdown.inFlight)
+    {
+        if (countdown.pending)
+            m_Coalesced.fetch_add(1, std::memory_order_relaxed);
+
+        countdown.pending = std::move(body);
+        return;
+    }
+
+    countdown.inFlight = true;
+
+    auto generation = countdown.generation;
+    auto target = countdown.message;
+    lock.unlock();
+
+    send(key, generation, channel, target, body);
+}
+
+dpp::snowflake CountdownEditor::getMessage(const std::string& key) const
+{
+    std::lock_guard lock(m_Mutex);
+
+    auto it = m_Countdowns.find(key);
+
+    return it == m_Countdowns.end() ? dpp::snowflake(0) : it->second.message;
+}
+
+void CountdownEditor::forget(const std::string& key)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Countdowns.erase(key);
+}
+
+CountdownEditor::Stats CountdownEditor::getStats() const
+{
+    Stats stats;
+    stats.creates = m_Creates.load(std::memory_order_relaxed);
+    stats.edits = m_Edits.load(std::memory_order_relaxed);
+    stats.coalesced = m_Coalesced.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CountdownEditor::send(const std::string& key, uint64_t generation, const dpp::snowflake& channel, const dpp::snowflake& message, const std::string& body)
+{
+    if (message == 0)
+    {
+        m_Creates.fetch_add(1, std::memory_order_relaxed);
+
+        m_Sink.createEditableMessage(channel, body, [this, key, generation, channel](const dpp::snowflake& created) {
+            onSent(key, generation, channel, created, created != 0);
+        });
+    }
+    else
+    {
+        m_Edits.fetch_add(1, std::memory_order_relaxed);
+
+        m_Sink.editMessage(channel, message, body, [this, key, generation, channel](bool success) {
+            onSent(key, generation, channel, 0, success);
+        });
+    }
+}
+
+void CountdownEditor::onSent(const std::string& key, uint64_t generation, const dpp::snowflake& channel, const dpp::snowflake& created, bool success)
+{
+    std::unique_lock lock(m_Mutex);
+
+    auto it = m_Countdowns.find(key);
+
+    if (it == m_Countdowns.end() || it->second.generation != generation)
+        return;
+
+    auto& countdown = it->second;
+
+    // Completions of requests sent to a previous channel do not describe the current message
+    if (countdown.channel == channel)
+    {
+        if (created != 0)
+            countdown.message = created;
+        // Deleted by a user, or never created: the next update posts a new message
+        else if (!success)
+            countdown.message = 0;
+    }
+
+    if (!countdown.pending)
+    {
+        countdown.inFlight = false;
+        return;
+    }
+
+    auto body = std::move(*countdown.pending);
+    countdown.pending.reset();
+
+    auto target = countdown.message;
+    auto targetChannel = countdown.channel;
+    lock.unlock();
+
+    send(key, generation, targetChannel, target, body);
+}
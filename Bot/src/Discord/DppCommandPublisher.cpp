@@ -0,0 +1,26 @@
+#include "Discord/DppCommandPublisher.h"
+
+#include "Logging/Logger.h"
+
+DppCommandPublisher::DppCommandPublisher(dpp::cluster& bot)
+    : m_Bot(bot)
+{
+}
+
+void DppCommandPublisher::bulkOverwrite(const std::vector<dpp::slashcommand>& commands, Callback_Type onSuccess)
+{
+    m_Bot.global_bulk_command_create(commands, [this, onSuccess](const dpp::confirmation_callback_t& callback) {
+        if (callback.is_error())
+        {
+            Logger::Log(dpp::ll_error, "Could not register commands", LogField("error", callback.get_error().message));
+            return;
+        }
+
+        CommandIds_Type ids;
+
+        for (const auto& [id, command] : callback.get<dpp::slashcommand_map>())
+            ids[command.name] = id;
+
+        onSuccess(ids);
+    });
+}
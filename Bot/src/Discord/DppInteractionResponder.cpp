@@ -0,0 +1,36 @@
+#include "Discord/DppInteractionResponder.h"
+
+DppInteractionResponder::DppInteractionResponder(dpp::cluster& bot)
+    : m_Bot(bot)
+{
+}
+
+void DppInteractionResponder::reply(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback)
+{
+    m_Bot.interaction_response_create(interaction.id, interaction.token, dpp::interaction_response(dpp::ir_channel_message_with_source, message), std::move(callback));
+}
+
+void DppInteractionResponder::defer(const dpp::interaction& interaction, bool ephemeral, Callback_Type callback)
+{
+    dpp::message message;
+
+    if (ephemeral)
+        message.set_flags(dpp::m_ephemeral);
+
+    m_Bot.interaction_response_create(interaction.id, interaction.token, dpp::interaction_response(dpp::ir_deferred_channel_message_with_source, message), std::move(callback));
+}
+
+void DppInteractionResponder::editResponse(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback)
+{
+    m_Bot.interaction_response_edit(interaction.token, message, std::move(callback));
+}
+
+void DppInteractionResponder::suggest(const dpp::interaction& interaction, const std::vector<std::string>& suggestions)
+{
+    dpp::interaction_response response(dpp::ir_autocomplete_reply);
+
+    for (const auto& suggestion : suggestions)
+        response.add_autocomplete_choice(dpp::command_option_choice(suggestion, suggestion));
+
+    m_Bot.interaction_response_create(interaction.id, interaction.token, response);
+}
@@ -0,0 +1,51 @@
+#include "Discord/DppMessageSink.h"
+
+#include "Logging/Logger.h"
+
+DppMessageSink::DppMessageSink(dpp::cluster& bot)
+    : m_Bot(bot)
+{
+}
+
+void DppMessageSink::createMessage(const dpp::snowflake& channel, const std::string& body, Callback_Type onDone)
+{
+    m_Bot.post_rest(API_PATH "/channels", std::to_string(channel), "messages", dpp::m_post, body,
+        [this, channel, onDone = std::move(onDone)](dpp::json&, const dpp::http_request_completion_t& http) {
+            if (http.status >= 400)
+                Logger::Log(dpp::ll_warning, "Could not create message", LogField("channel", channel), LogField("status", http.status));
+
+            if (onDone)
+                onDone(http.status < 400);
+        }
+    );
+}
+
+void DppMessageSink::createEditableMessage(const dpp::snowflake& channel, const std::string& body, CreatedCallback_Type onCreated)
+{
+    m_Bot.post_rest(API_PATH "/channels", std::to_string(channel), "messages", dpp::m_post, body,
+        [channel, onCreated = std::move(onCreated)](dpp::json& json, const dpp::http_request_completion_t& http) {
+            dpp::snowflake message = 0;
+
+            if (http.status >= 400)
+                Logger::Log(dpp::ll_warning, "Could not create message", LogField("channel", channel), LogField("status", http.status));
+            else
+                message = dpp::snowflake_not_null(&json, "id");
+
+            if (onCreated)
+                onCreated(message);
+        }
+    );
+}
+
+void DppMessageSink::editMessage(const dpp::snowflake& channel, const dpp::snowflake& message, const std::string& body, Callback_Type onDone)
+{
+    m_Bot.post_rest(API_PATH "/channels", std::to_string(channel), "messages/" + std::to_string(message), dpp::m_patch, body,
+        [channel, message, onDone = std::move(onDone)](dpp::json&, const dpp::http_request_completion_t& http) {
+            if (http.status >= 400)
+                Logger::Log(dpp::ll_warning, "Could not edit message", LogField("channel", channel), LogField("message", message), LogField("status", http.status));
+
+            if (onDone)
+                onDone(http.status < 400);
+        }
+    );
+}
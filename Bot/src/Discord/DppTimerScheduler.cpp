@@ -0,0 +1,16 @@
+#include "Discord/DppTimerScheduler.h"
+
+DppTimerScheduler::DppTimerScheduler(dpp::cluster& bot)
+    : m_Bot(bot)
+{
+}
+
+dpp::timer DppTimerScheduler::startTimer(Callback_Type callback, uint64_t seconds)
+{
+    return m_Bot.start_timer(std::move(callback), seconds);
+}
+
+void DppTimerScheduler::stopTimer(const dpp::timer& timer)
+{
+    m_Bot.stop_timer(timer);
+}
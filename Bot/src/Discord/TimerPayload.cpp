@@ -0,0 +1,99 @@
+#include "Discord/TimerPayload.h"
+
+#include <array>
+#include <charconv>
+
+static constexpr std::array<TimerPayload::Placeholder, 4> PLACEHOLDERS = {
+    TimerPayload::Placeholder::RemainingDays,
+    TimerPayload::Placeholder::RemainingHours,
+    TimerPayload::Placeholder::RemainingMinutes,
+    TimerPayload::Placeholder::RemainingSeconds,
+};
+
+TimerPayload::TimerPayload(const dpp::message& message, const TimePoint_Type& end)
+    : m_End(end)
+{
+    const std::string json = message.build_json();
+    m_Body.reserve(json.size());
+
+    // Placeholder tokens only hold characters that are never escaped, so they appear verbatim in the JSON
+    size_t pos = 0;
+    while (pos < json.size())
+    {
+        size_t brace = json.find('{', pos);
+
+        if (brace == std::string::npos)
+        {
+            m_Body.append(json, pos);
+            break;
+        }
+
+        m_Body.append(json, pos, brace - pos);
+
+        std::string_view rest = std::string_view(json).substr(brace);
+        bool matched = false;
+
+        for (auto placeholder : PLACEHOLDERS)
+        {
+            if (rest.starts_with(GetToken(placeholder)))
+            {
+                m_Slots.push_back({ m_Body.size(), placeholder });
+                pos = brace + GetToken(placeholder).size();
+                matched = true;
+                break;
+            }
+        }
+
+        if (!matched)
+        {
+            m_Body.push_back('{');
+            pos = brace + 1;
+        }
+    }
+}
+
+const std::string& TimerPayload::render(std::string& buffer, const TimePoint_Type& now) const
+{
+    if (isStatic())
+        return m_Body;
+
+    auto secondsLeft = std::chrono::duration_cast<std::chrono::seconds>(m_End - now).count();
+
+    buffer.clear();
+
+    size_t pos = 0;
+    for (const auto& slot : m_Slots)
+    {
+        buffer.append(m_Body, pos, slot.offset - pos);
+        pos = slot.offset;
+
+        int64_t value = secondsLeft;
+        switch (slot.placeholder)
+        {
+        case Placeholder::RemainingDays:    value = secondsLeft / 60 / 60 / 24; break;
+        case Placeholder::RemainingHours:   value = secondsLeft / 60 / 60; break;
+        case Placeholder::RemainingMinutes: value = secondsLeft / 60; break;
+        case Placeholder::RemainingSeconds: value = secondsLeft; break;
+        }
+
+        char digits[24];
+        auto [end, _] = std::to_chars(std::begin(digits), std::end(digits), value);
+        buffer.append(digits, end);
+    }
+    buffer.append(m_Body, pos);
+
+    return buffer;
+}
+
+std::string_view TimerPayload::GetToken(Placeholder placeholder)
+{
+    switch (placeholder)
+    {
+    case Placeholder::RemainingDays:    return "{rem:days}";
+    case Placeholder::RemainingHours:   return "{rem:hours}";
+    case Placeholder::RemainingMinutes: return "{rem:minuts}";
+    case Placeholder::RemainingSeconds: return "{rem:seconds}";
+    }
+
+    return {};
+}
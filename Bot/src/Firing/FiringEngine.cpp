@@ -0,0 +1,241 @@
+#include "Firing/FiringEngine.h"
+
+#include "Controllers/TimerController.h"
+#include "DAO/GuildSettingsDAO.h"
+#include "DAO/TimerDAO.h"
+#include "Logging/Logger.h"
+#include "Time/SystemClock.h"
+#include "Tracing/Tracer.h"
+
+static const SystemClock SYSTEM_CLOCK;
+
+FiringEngine::FiringEngine(std::unique_ptr<IMessageSink> messageSink, std::unique_ptr<ITimerScheduler> scheduler, MetricsRegistry* metrics,
+    const IClock* clock, const ShardMap& shards)
+    : m_Shards(shards), m_Clock(clock != nullptr ? *clock : SYSTEM_CLOCK), m_MessageSink(std::move(messageSink)), m_CountdownEditor(*m_MessageSink),
+    m_Scheduler(std::move(scheduler))
+{
+    if (metrics != nullptr)
+    {
+        m_Metrics.fireLateness = &metrics->histogram("bot_timer_fire_lateness_seconds", "Delay between the scheduled fire of a timer and its message being sent.");
+        m_Metrics.fires = &metrics->counter("bot_firing_fires_total", "Timer messages sent by the firing engine.");
+        m_Metrics.mutations = &metrics->counter("bot_firing_mutations_total", "Timer mutations received from the command process.");
+        m_Metrics.activeTimers = &metrics->gauge("bot_timers_active", "Number of running timers.");
+    }
+}
+
+std::string FiringEngine::GetRingName(const ShardMap& shards)
+{
+    return "/discord-timer-bot-firing-" + std::to_string(shards.getClusterId());
+}
+
+std::string FiringEngine::GetReportRingName(const ShardMap& shards)
+{
+    return GetRingName(shards) + "-reports";
+}
+
+void FiringEngine::setReportRing(SharedRing* ring)
+{
+    std::lock_guard lock(m_Mutex);
+    m_ReportRing = ring;
+}
+
+void FiringEngine::reload()
+{
+    TraceSpan span("FiringEngine::reload");
+
+    TimerDAO timers(m_Shards);
+    GuildSettingsDAO guildSettings(m_Shards);
+
+    timers.loadTimers();
+    guildSettings.loadGuildSettings();
+
+    std::lock_guard lock(m_Mutex);
+
+    for (const auto& [_, entry] : m_Timers)
+        m_Scheduler->stopTimer(entry.handle);
+
+    m_Timers.clear();
+
+    for (const auto& [id, timer] : timers.getDataMap())
+    {
+        if (timer->isPaused())
+            continue;
+
+        TimeFormatter::Zone_Type zone = nullptr;
+
+        if (guildSettings.idExists(timer->getGuild()))
+            zone = TimeFormatter::LocateZone(guildSettings.findOne(timer->getGuild()).getTimeZone());
+
+        start_NoLock(id, *timer, zone);
+    }
+
+    if (m_Metrics.activeTimers != nullptr)
+        m_Metrics.activeTimers->set(int64_t(m_Timers.size()));
+
+    Logger::Log(dpp::ll_info, "Firing engine loaded timers", LogField("count", m_Timers.size()));
+}
+
+void FiringEngine::apply(const TimerMutation& mutation)
+{
+    // Only sent by the engine to the command process
+    if (mutation.type == TimerMutation::Type::MessageCreated)
+        return;
+
+    std::lock_guard lock(m_Mutex);
+
+    stop_NoLock(mutation.id);
+
+    if (mutation.type == TimerMutation::Type::Remove)
+        m_CountdownEditor.forget(mutation.id);
+
+    if (mutation.type == TimerMutation::Type::Upsert)
+        start_NoLock(mutation.id, mutation.timer, mutation.zone.empty() ? nullptr : TimeFormatter::LocateZone(mutation.zone));
+
+    if (m_Metrics.mutations != nullptr)
+        m_Metrics.mutations->increment();
+
+    if (m_Metrics.activeTimers != nullptr)
+        m_Metrics.activeTimers->set(int64_t(m_Timers.size()));
+}
+
+size_t FiringEngine::poll(SharedRing& ring)
+{
+    // Dropped mutations are in the persisted timers, those still in the ring are applied again after the reload
+    if (ring.takeOverflow())
+    {
+        Logger::Log(dpp::ll_warning, "Timer mutations dropped, reloading the timers");
+        reload();
+    }
+
+    thread_local std::string record;
+    size_t applied = 0;
+
+    while (ring.tryPop(record))
+    {
+        try
+        {
+            apply(TimerMutation::Decode(record));
+            ++applied;
+        }
+        catch (const std::invalid_argument& e)
+        {
+            Logger::Log(dpp::ll_error, "Invalid timer mutation", LogField("error", e.what()));
+        }
+    }
+
+    return applied;
+}
+
+size_t FiringEngine::getTimerCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Timers.size();
+}
+
+void FiringEngine::start_NoLock(const std::string& id, const TimerDTO& timer, TimeFormatter::Zone_Type zone)
+{
+    if (timer.getInterval() <= 0)
+    {
+        Logger::Log(dpp::ll_error, "Could not schedule timer", LogField("id", id), LogField("error", "invalid interval"));
+        return;
+    }
+
+    auto& entry = m_Timers[id];
+    entry.timer = timer;
+
+    int64_t secondsToNextInterval;
+
+    try
+    {
+        secondsToNextInterval = TimerController::Timer(entry.timer, nullptr, &m_Clock).getSecondsToNextInterval();
+    }
+    catch (const std::runtime_error&)
+    {
+        // Already over, the command process deletes it
+        m_Timers.erase(id);
+        return;
+    }
+
+    entry.payload = TimerPayload(TimerController::Timer(entry.timer, zone, &m_Clock).buildMessage(), entry.timer.getEnd());
+    entry.handle = m_Scheduler->startTimer([this, id](const dpp::timer& handle) { fire(id, handle); }, uint64_t(secondsToNextInterval));
+}
+
+void FiringEngine::stop_NoLock(const std::string& id)
+{
+    auto it = m_Timers.find(id);
+
+    if (it == m_Timers.end())
+        return;
+
+    m_Scheduler->stopTimer(it->second.handle);
+    m_Timers.erase(it);
+}
+
+void FiringEngine::fire(const std::string& id, const dpp::timer& handle)
+{
+    TraceSpan span("FiringEngine::fire");
+    auto now = m_Clock.now();
+
+    std::lock_guard lock(m_Mutex);
+
+    auto it = m_Timers.find(id);
+
+    // Stopped or restarted while this fire was waiting for the lock
+    if (it == m_Timers.end() || it->second.handle != handle)
+        return;
+
+    auto& entry = it->second;
+
+    if (TimerController::IsDatePassed(entry.timer.getEnd(), now))
+    {
+        m_CountdownEditor.forget(id);
+        stop_NoLock(id);
+
+        if (m_Metrics.activeTimers != nullptr)
+            m_Metrics.activeTimers->set(int64_t(m_Timers.size()));
+
+        return;
+    }
+
+    if (m_Metrics.fireLateness != nullptr)
+        m_Metrics.fireLateness->record(TimerController::GetFireLateness(entry.timer, now));
+
+    thread_local std::string buffer;
+    const auto& body = entry.payload.render(buffer, now);
+
+    if (entry.timer.isEditInPlace())
+    {
+        // Posted by a previous fire, sent back to be stored with the timer and edited again after a restart
+        auto message = m_CountdownEditor.getMessage(id);
+
+        if (message != 0 && message != entry.timer.getMessageID() && m_ReportRing != nullptr)
+        {
+            TimerMutation report;
+            report.type = TimerMutation::Type::MessageCreated;
+            report.id = id;
+            report.message = message;
+
+            thread_local std::string record;
+            report.encode(record);
+
+            // Sent again by the next fire while the ring is full
+            if (m_ReportRing->tryPush(record))
+                entry.timer.setMessageID(message);
+        }
+
+        m_CountdownEditor.update(id, entry.timer.getChannel(), message != 0 ? message : entry.timer.getMessageID(), body);
+    }
+    else
+        m_MessageSink->createMessage(entry.timer.getChannel(), body);
+
+    if (m_Metrics.fires != nullptr)
+        m_Metrics.fires->increment();
+
+    // The first fire is on the next interval boundary, the next ones every interval
+    if (!entry.aligned)
+    {
+        m_Scheduler->stopTimer(handle);
+        entry.handle = m_Scheduler->startTimer([this, id](const dpp::timer& handle) { fire(id, handle); }, uint64_t(entry.timer.getInterval()));
+        entry.aligned = true;
+    }
+}
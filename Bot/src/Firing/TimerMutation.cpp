@@ -0,0 +1,138 @@
+#include "Firing/TimerMutation.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // Integers are written in the byte order of the machine, both processes run on it
+    template<typename T>
+    void WriteValue(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteString(std::string& out, std::string_view value)
+    {
+        WriteValue(out, uint32_t(value.size()));
+        out.append(value);
+    }
+
+    void WriteTime(std::string& out, const TimerDTO::TimePoint_Type& time)
+    {
+        WriteValue(out, int64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count()));
+    }
+
+    class Reader
+    {
+    public:
+        explicit Reader(std::string_view data)
+            : m_Data(data)
+        {}
+
+        template<typename T>
+        T readValue()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(value)).data(), sizeof(value));
+            return value;
+        }
+
+        std::string readString()
+        {
+            auto size = readValue<uint32_t>();
+            return std::string(take(size));
+        }
+
+        TimerDTO::TimePoint_Type readTime()
+        {
+            auto nanoseconds = std::chrono::nanoseconds(readValue<int64_t>());
+            return TimerDTO::TimePoint_Type(std::chrono::duration_cast<TimerDTO::TimePoint_Type::duration>(nanoseconds));
+        }
+
+        inline bool isAtEnd() const { return m_Data.empty(); }
+
+    private:
+        std::string_view take(size_t size)
+        {
+            if (size > m_Data.size())
+                throw std::invalid_argument("Truncated timer mutation");
+
+            auto taken = m_Data.substr(0, size);
+            m_Data.remove_prefix(size);
+
+            return taken;
+        }
+
+    private:
+        std::string_view m_Data;
+    };
+}
+
+void TimerMutation::encode(std::string& out) const
+{
+    out.clear();
+
+    WriteValue(out, uint8_t(type));
+    WriteString(out, id);
+
+    if (type == Type::Remove)
+        return;
+
+    if (type == Type::MessageCreated)
+    {
+        WriteValue(out, uint64_t(message));
+        return;
+    }
+
+    WriteString(out, zone);
+    WriteString(out, timer.getName());
+    WriteValue(out, uint64_t(timer.getChannel()));
+    WriteValue(out, int64_t(timer.getInterval()));
+    WriteString(out, timer.getMessage());
+    WriteTime(out, timer.getStart());
+    WriteTime(out, timer.getEnd());
+    WriteString(out, timer.getImageURL());
+    WriteString(out, timer.getTitle());
+    WriteValue(out, uint64_t(timer.getGuild()));
+    WriteValue(out, uint8_t(timer.isEditInPlace() ? 1 : 0));
+    WriteValue(out, uint64_t(timer.getMessageID()));
+}
+
+TimerMutation TimerMutation::Decode(std::string_view data)
+{
+    Reader reader(data);
+    TimerMutation mutation;
+
+    auto type = reader.readValue<uint8_t>();
+
+    if (type > uint8_t(Type::MessageCreated))
+        throw std::invalid_argument("Unknown timer mutation type " + std::to_string(type));
+
+    mutation.type = Type(type);
+    mutation.id = reader.readString();
+
+    if (mutation.type == Type::Upsert)
+    {
+        mutation.zone = reader.readString();
+        mutation.timer.setName(reader.readString());
+        mutation.timer.setChannel(reader.readValue<uint64_t>());
+        mutation.timer.setInterval(reader.readValue<int64_t>());
+        mutation.timer.setMessage(reader.readString());
+        mutation.timer.setStart(reader.readTime());
+        mutation.timer.setEnd(reader.readTime());
+        mutation.timer.setImageURL(reader.readString());
+        mutation.timer.setTitle(reader.readString());
+        mutation.timer.setGuild(reader.readValue<uint64_t>());
+        mutation.timer.setEditInPlace(reader.readValue<uint8_t>() != 0);
+        mutation.timer.setMessageID(reader.readValue<uint64_t>());
+    }
+
+    if (mutation.type == Type::MessageCreated)
+        mutation.message = reader.readValue<uint64_t>();
+
+    if (!reader.isAtEnd())
+        throw std::invalid_argument("Trailing bytes after timer mutation");
+
+    return mutation;
+}
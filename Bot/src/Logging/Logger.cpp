@@ -0,0 +1,407 @@
+#include "Logging/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr size_t ENTRIES_PER_THREAD = Logger::ENTRIES_PER_THREAD;
+    constexpr size_t MAX_FIELDS = Logger::MAX_FIELDS;
+    constexpr size_t TEXT_CAPACITY = Logger::TEXT_CAPACITY;
+
+    // How long the background thread sleeps between two batches
+    constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(20);
+
+    // Logged before the first start, and after a stop
+    constexpr int LEVEL_OFF = int(dpp::ll_critical) + 1;
+
+    // A captured field, owning a copy of its text
+    struct Field
+    {
+        const char* key;
+        LogField::Type type;
+        uint8_t size;
+
+        union
+        {
+            const char* literal;
+            char text[TEXT_CAPACITY];
+            // Texts longer than TEXT_CAPACITY, deleted once written
+            std::string* longText;
+            int64_t signedValue;
+            uint64_t unsignedValue;
+            double doubleValue;
+            bool booleanValue;
+        };
+
+        inline bool isLongText() const { return type == LogField::Type::Text && size > TEXT_CAPACITY; }
+
+        inline std::string_view getText() const { return isLongText() ? std::string_view(*longText) : std::string_view(text, size); }
+    };
+
+    struct Entry
+    {
+        int64_t time;
+        dpp::loglevel level;
+        uint8_t fieldCount;
+        std::array<Field, MAX_FIELDS> fields;
+    };
+
+    // Single producer, the owning thread, and single consumer, the writing thread
+    struct ThreadBuffer
+    {
+        std::atomic<uint64_t> head = 0;
+        std::atomic<uint64_t> tail = 0;
+        std::array<Entry, ENTRIES_PER_THREAD> entries;
+    };
+
+    // Buffers outlive their thread, so entries of exited threads are still written
+    std::vector<std::unique_ptr<ThreadBuffer>> BUFFERS;
+    std::mutex BUFFERS_MUTEX;
+
+    thread_local ThreadBuffer* t_Buffer = nullptr;
+
+    std::atomic<uint64_t> DROPPED = 0;
+
+    // Serializes the consumers: the background thread, Flush and Stop
+    std::mutex WRITE_MUTEX;
+    Logger::Writer_Type WRITER;
+    uint64_t REPORTED_DROPPED = 0;
+    // Reused by every batch
+    std::vector<Entry> PENDING_ENTRIES;
+    std::string PENDING_LINES;
+
+    std::mutex THREAD_MUTEX;
+    std::thread WRITING_THREAD;
+    std::atomic<bool> RUNNING = false;
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        if (t_Buffer == nullptr)
+        {
+            std::lock_guard lock(BUFFERS_MUTEX);
+
+            auto buffer = std::make_unique<ThreadBuffer>();
+            t_Buffer = buffer.get();
+            BUFFERS.push_back(std::move(buffer));
+        }
+
+        return *t_Buffer;
+    }
+
+    const char* GetLevelName(dpp::loglevel level)
+    {
+        switch (level)
+        {
+        case dpp::ll_trace: return "TRACE";
+        case dpp::ll_debug: return "DEBUG";
+        case dpp::ll_info: return "INFO";
+        case dpp::ll_warning: return "WARN";
+        case dpp::ll_error: return "ERROR";
+        case dpp::ll_critical: return "CRITICAL";
+        }
+
+        return "UNKNOWN";
+    }
+
+    void AppendTime(std::string& out, int64_t time)
+    {
+        std::time_t seconds = std::time_t(time / 1000000000);
+        std::tm local{};
+
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+
+        char buffer[32];
+        size_t size = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+        size += size_t(std::snprintf(buffer + size, sizeof(buffer) - size, ".%03d", int(time / 1000000 % 1000)));
+
+        out.append(buffer, size);
+    }
+
+    void AppendValue(std::string& out, std::string_view text)
+    {
+        bool quoted = text.empty() || text.find_first_of(" =\"\\\n\r\t") != std::string_view::npos;
+
+        if (!quoted)
+        {
+            out += text;
+            return;
+        }
+
+        out += '"';
+
+        for (char c : text)
+        {
+            switch (c)
+            {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default: out += c; break;
+            }
+        }
+
+        out += '"';
+    }
+
+    void AppendEntry(std::string& out, const Entry& entry)
+    {
+        out += '[';
+        AppendTime(out, entry.time);
+        out += "] ";
+        out += GetLevelName(entry.level);
+        out += ':';
+
+        char number[32];
+
+        for (size_t i = 0; i < entry.fieldCount; ++i)
+        {
+            const Field& field = entry.fields[i];
+            out += ' ';
+
+            // The message, written as is
+            if (field.key == nullptr)
+            {
+                out += field.type == LogField::Type::Literal ? std::string_view(field.literal) : field.getText();
+                continue;
+            }
+
+            out += field.key;
+            out += '=';
+
+            switch (field.type)
+            {
+            case LogField::Type::Literal:
+                AppendValue(out, field.literal);
+                break;
+            case LogField::Type::Text:
+                AppendValue(out, field.getText());
+                break;
+            case LogField::Type::Signed:
+                out.append(number, size_t(std::snprintf(number, sizeof(number), "%lld", (long long)field.signedValue)));
+                break;
+            case LogField::Type::Unsigned:
+                out.append(number, size_t(std::snprintf(number, sizeof(number), "%llu", (unsigned long long)field.unsignedValue)));
+                break;
+            case LogField::Type::Double:
+                out.append(number, size_t(std::snprintf(number, sizeof(number), "%g", field.doubleValue)));
+                break;
+            case LogField::Type::Boolean:
+                out += field.booleanValue ? "true" : "false";
+                break;
+            }
+        }
+
+        out += '\n';
+    }
+
+    // Must be called with WRITE_MUTEX held
+    void WritePending_NoLock()
+    {
+        std::vector<ThreadBuffer*> buffers;
+
+        {
+            std::lock_guard lock(BUFFERS_MUTEX);
+
+            for (const auto& buffer : BUFFERS)
+                buffers.push_back(buffer.get());
+        }
+
+        auto& entries = PENDING_ENTRIES;
+        entries.clear();
+
+        for (ThreadBuffer* buffer : buffers)
+        {
+            uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+            uint64_t head = buffer->head.load(std::memory_order_acquire);
+
+            for (uint64_t i = tail; i < head; ++i)
+                entries.push_back(buffer->entries[i % ENTRIES_PER_THREAD]);
+
+            buffer->tail.store(head, std::memory_order_release);
+        }
+
+        uint64_t dropped = DROPPED.load(std::memory_order_relaxed);
+
+        if (dropped != REPORTED_DROPPED)
+        {
+            Entry& report = entries.emplace_back();
+            report.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            report.level = dpp::ll_warning;
+            report.fieldCount = 2;
+            report.fields[0] = Field{ nullptr, LogField::Type::Literal, 0, {} };
+            report.fields[0].literal = "Log entries dropped, the ring of their thread was full";
+            report.fields[1] = Field{ "count", LogField::Type::Unsigned, 0, {} };
+            report.fields[1].unsignedValue = dropped - REPORTED_DROPPED;
+
+            REPORTED_DROPPED = dropped;
+        }
+
+        if (entries.empty())
+            return;
+
+        // Interleave the threads by time
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+        auto& lines = PENDING_LINES;
+        lines.clear();
+
+        for (auto& entry : entries)
+        {
+            AppendEntry(lines, entry);
+
+            for (size_t i = 0; i < entry.fieldCount; ++i)
+            {
+                if (entry.fields[i].isLongText())
+                    delete entry.fields[i].longText;
+            }
+        }
+
+        if (WRITER)
+            WRITER(lines);
+        else
+        {
+            std::fwrite(lines.data(), 1, lines.size(), stdout);
+            std::fflush(stdout);
+        }
+    }
+
+    void Run()
+    {
+        while (RUNNING.load(std::memory_order_relaxed))
+        {
+            std::this_thread::sleep_for(WRITE_INTERVAL);
+
+            std::lock_guard lock(WRITE_MUTEX);
+            WritePending_NoLock();
+        }
+    }
+}
+
+std::atomic<int> Logger::s_Level = LEVEL_OFF;
+
+void Logger::Start(dpp::loglevel level, Writer_Type writer)
+{
+    std::lock_guard threadLock(THREAD_MUTEX);
+
+    if (RUNNING)
+        throw std::logic_error("The logger is already started");
+
+    {
+        std::lock_guard lock(WRITE_MUTEX);
+        WRITER = std::move(writer);
+    }
+
+    RUNNING = true;
+    WRITING_THREAD = std::thread(Run);
+
+    s_Level.store(int(level), std::memory_order_relaxed);
+}
+
+void Logger::Stop()
+{
+    std::lock_guard threadLock(THREAD_MUTEX);
+
+    s_Level.store(LEVEL_OFF, std::memory_order_relaxed);
+
+    if (!RUNNING)
+        return;
+
+    RUNNING = false;
+    WRITING_THREAD.join();
+
+    std::lock_guard lock(WRITE_MUTEX);
+    WritePending_NoLock();
+    WRITER = nullptr;
+}
+
+void Logger::Flush()
+{
+    std::lock_guard lock(WRITE_MUTEX);
+    WritePending_NoLock();
+}
+
+uint64_t Logger::GetDroppedCount()
+{
+    return DROPPED.load(std::memory_order_relaxed);
+}
+
+void Logger::Append(dpp::loglevel level, const LogField* fields, size_t count)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+
+    if (head - buffer.tail.load(std::memory_order_acquire) >= ENTRIES_PER_THREAD)
+    {
+        DROPPED.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Entry& entry = buffer.entries[head % ENTRIES_PER_THREAD];
+    entry.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    entry.level = level;
+    entry.fieldCount = uint8_t(std::min(count, MAX_FIELDS));
+
+    for (size_t i = 0; i < entry.fieldCount; ++i)
+    {
+        const LogField& source = fields[i];
+        Field& field = entry.fields[i];
+
+        field.key = source.getKey();
+        field.type = source.getType();
+        field.size = 0;
+
+        switch (source.getType())
+        {
+        case LogField::Type::Literal:
+            field.literal = source.getLiteral();
+            break;
+        case LogField::Type::Text:
+        {
+            auto text = source.getText();
+
+            if (text.size() <= TEXT_CAPACITY)
+            {
+                field.size = uint8_t(text.size());
+                std::copy(text.begin(), text.end(), field.text);
+            }
+            else
+            {
+                field.size = TEXT_CAPACITY + 1;
+                field.longText = new std::string(text);
+            }
+
+            break;
+        }
+        case LogField::Type::Signed:
+            field.signedValue = source.getSigned();
+            break;
+        case LogField::Type::Unsigned:
+            field.unsignedValue = source.getUnsigned();
+            break;
+        case LogField::Type::Double:
+            field.doubleValue = source.getDouble();
+            break;
+        case LogField::Type::Boolean:
+            field.booleanValue = source.getBoolean();
+            break;
+        }
+    }
+
+    buffer.head.store(head + 1, std::memory_order_release);
+}
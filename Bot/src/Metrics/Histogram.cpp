@@ -0,0 +1,42 @@
+#include "Metrics/Histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+uint64_t Histogram::Snapshot::getQuantile(double quantile) const
+{
+    if (m_Count == 0)
+        return 0;
+
+    // Rank of the value, 1-based
+    uint64_t rank = std::max<uint64_t>(1, uint64_t(std::ceil(std::clamp(quantile, 0.0, 1.0) * double(m_Count))));
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < m_Buckets.size(); ++i)
+    {
+        seen += m_Buckets[i];
+
+        if (seen >= rank)
+            return std::min(GetBucketUpperBound(i), m_Max);
+    }
+
+    return m_Max;
+}
+
+Histogram::Snapshot Histogram::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.m_Buckets.resize(BUCKET_COUNT);
+
+    for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        snapshot.m_Buckets[i] = m_Buckets[i].load(std::memory_order_relaxed);
+        snapshot.m_Count += snapshot.m_Buckets[i];
+    }
+
+    // Counted from the buckets, so quantiles stay consistent with a concurrent record
+    snapshot.m_Sum = m_Sum.load(std::memory_order_relaxed);
+    snapshot.m_Max = m_Max.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
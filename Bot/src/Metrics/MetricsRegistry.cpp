@@ -0,0 +1,244 @@
+#include "Metrics/MetricsRegistry.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+static constexpr double NANOSECONDS_PER_SECOND = 1e9;
+
+static const char* GetTypeName(MetricsRegistry::Type type)
+{
+    switch (type)
+    {
+    case MetricsRegistry::Type::Counter:
+        return "counter";
+    case MetricsRegistry::Type::Gauge:
+        return "gauge";
+    default:
+        // Quantiles are computed by the bot, not by Prometheus
+        return "summary";
+    }
+}
+
+static void AppendNumber(std::string& out, double value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    out += buffer;
+}
+
+static void AppendLine(std::string& out, std::string_view name, std::string_view labels, std::string_view extraLabel, double value)
+{
+    out += name;
+
+    if (!labels.empty() || !extraLabel.empty())
+    {
+        out += '{';
+        out += labels;
+
+        if (!labels.empty() && !extraLabel.empty())
+            out += ',';
+
+        out += extraLabel;
+        out += '}';
+    }
+
+    out += ' ';
+    AppendNumber(out, value);
+    out += '\n';
+}
+
+static std::string FormatDuration(uint64_t nanoseconds)
+{
+    char buffer[32];
+
+    if (nanoseconds < 1'000)
+        std::snprintf(buffer, sizeof(buffer), "%lluns", static_cast<unsigned long long>(nanoseconds));
+    else if (nanoseconds < 1'000'000)
+        std::snprintf(buffer, sizeof(buffer), "%.1fus", nanoseconds / 1e3);
+    else if (nanoseconds < 1'000'000'000)
+        std::snprintf(buffer, sizeof(buffer), "%.1fms", nanoseconds / 1e6);
+    else
+        std::snprintf(buffer, sizeof(buffer), "%.2fs", nanoseconds / 1e9);
+
+    return buffer;
+}
+
+static std::string FormatName(const std::string& name, const std::string& labels)
+{
+    return labels.empty() ? name : name + '{' + labels + '}';
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels)
+{
+    std::lock_guard lock(m_Mutex);
+
+    auto& instrument = getFamily_NoLock(name, help, Type::Counter).counters[labels];
+
+    if (instrument == nullptr)
+        instrument = std::make_unique<Counter>();
+
+    return *instrument;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels)
+{
+    std::lock_guard lock(m_Mutex);
+
+    auto& instrument = getFamily_NoLock(name, help, Type::Gauge).gauges[labels];
+
+    if (instrument == nullptr)
+        instrument = std::make_unique<Gauge>();
+
+    return *instrument;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const std::string& labels)
+{
+    std::lock_guard lock(m_Mutex);
+
+    auto& instrument = getFamily_NoLock(name, help, Type::Histogram).histograms[labels];
+
+    if (instrument == nullptr)
+        instrument = std::make_unique<Histogram>();
+
+    return *instrument;
+}
+
+void MetricsRegistry::addCollector(const std::string& name, const std::string& help, Type type, Collector_Type collector)
+{
+    if (type == Type::Histogram)
+        throw std::invalid_argument("Collectors can not produce histograms: " + name);
+
+    std::lock_guard lock(m_Mutex);
+
+    getFamily_NoLock(name, help, type).collectors.push_back(std::move(collector));
+}
+
+std::string MetricsRegistry::renderPrometheus() const
+{
+    std::lock_guard lock(m_Mutex);
+
+    std::string out;
+
+    for (const auto& [name, family] : m_Families)
+    {
+        out += "# HELP " + name + ' ' + family.help + '\n';
+        out += "# TYPE " + name + ' ' + GetTypeName(family.type) + '\n';
+
+        for (const auto& [labels, counter] : family.counters)
+            AppendLine(out, name, labels, "", double(counter->get()));
+
+        for (const auto& [labels, gauge] : family.gauges)
+            AppendLine(out, name, labels, "", double(gauge->get()));
+
+        for (const auto& [labels, histogram] : family.histograms)
+        {
+            auto snapshot = histogram->snapshot();
+
+            for (double quantile : QUANTILES)
+            {
+                char quantileLabel[32];
+                std::snprintf(quantileLabel, sizeof(quantileLabel), "quantile=\"%g\"", quantile);
+                AppendLine(out, name, labels, quantileLabel, snapshot.getQuantile(quantile) / NANOSECONDS_PER_SECOND);
+            }
+
+            AppendLine(out, name + "_sum", labels, "", snapshot.getSum() / NANOSECONDS_PER_SECOND);
+            AppendLine(out, name + "_count", labels, "", double(snapshot.getCount()));
+        }
+
+        for (const auto& collector : family.collectors)
+        {
+            for (const auto& sample : collector())
+                AppendLine(out, name, sample.labels, "", sample.value);
+        }
+    }
+
+    return out;
+}
+
+std::string MetricsRegistry::renderSummary() const
+{
+    std::lock_guard lock(m_Mutex);
+
+    std::string out;
+
+    for (const auto& [name, family] : m_Families)
+    {
+        for (const auto& [labels, counter] : family.counters)
+            out += FormatName(name, labels) + ' ' + std::to_string(counter->get()) + '\n';
+
+        for (const auto& [labels, gauge] : family.gauges)
+            out += FormatName(name, labels) + ' ' + std::to_string(gauge->get()) + '\n';
+
+        for (const auto& [labels, histogram] : family.histograms)
+        {
+            auto snapshot = histogram->snapshot();
+
+            if (snapshot.getCount() == 0)
+                continue;
+
+            out += FormatName(name, labels) + " n=" + std::to_string(snapshot.getCount())
+                + " p50=" + FormatDuration(snapshot.getQuantile(0.5))
+                + " p99=" + FormatDuration(snapshot.getQuantile(0.99))
+                + " max=" + FormatDuration(snapshot.getMax()) + '\n';
+        }
+
+        for (const auto& collector : family.collectors)
+        {
+            for (const auto& sample : collector())
+            {
+                out += FormatName(name, sample.labels) + ' ';
+                AppendNumber(out, sample.value);
+                out += '\n';
+            }
+        }
+    }
+
+    return out;
+}
+
+std::string MetricsRegistry::Labels(std::initializer_list<std::pair<std::string_view, std::string_view>> labels)
+{
+    std::string out;
+
+    for (const auto& [name, value] : labels)
+    {
+        if (!out.empty())
+            out += ',';
+
+        out += name;
+        out += "=\"";
+
+        for (char c : value)
+        {
+            if (c == '\\' || c == '"')
+                out += '\\';
+
+            if (c == '\n')
+                out += "\\n";
+            else
+                out += c;
+        }
+
+        out += '"';
+    }
+
+    return out;
+}
+
+MetricsRegistry::Family& MetricsRegistry::getFamily_NoLock(const std::string& name, const std::string& help, Type type)
+{
+    auto [family, inserted] = m_Families.try_emplace(name);
+
+    if (inserted)
+    {
+        family->second.help = help;
+        family->second.type = type;
+    }
+    else if (family->second.type != type)
+    {
+        throw std::invalid_argument("Metric registered with another type: " + name);
+    }
+
+    return family->second;
+}
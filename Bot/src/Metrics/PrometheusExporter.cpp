@@ -0,0 +1,148 @@
+#include "Metrics/PrometheusExporter.h"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+
+    #define poll WSAPoll
+    using SocketLength_Type = int;
+    static void CloseSocket(intptr_t socket) { closesocket(SOCKET(socket)); }
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+
+    using SocketLength_Type = socklen_t;
+    static void CloseSocket(intptr_t socket) { close(int(socket)); }
+#endif
+
+// How long the serving thread waits for a connection before checking whether it must stop
+static constexpr int POLL_TIMEOUT_MS = 200;
+static constexpr size_t MAX_REQUEST_SIZE = 4096;
+
+// A scraper closing early must not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static constexpr int SEND_FLAGS = 0;
+#endif
+
+static void SendAll(intptr_t client, const std::string& data)
+{
+    size_t sent = 0;
+
+    while (sent < data.size())
+    {
+        auto count = send(client, data.data() + sent, int(data.size() - sent), SEND_FLAGS);
+
+        if (count <= 0)
+            return;
+
+        sent += size_t(count);
+    }
+}
+
+PrometheusExporter::PrometheusExporter(const MetricsRegistry& registry, uint16_t port)
+    : m_Registry(registry)
+{
+#ifdef _WIN32
+    WSADATA data;
+    WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+
+    m_Socket = intptr_t(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+
+    if (m_Socket < 0)
+        throw std::runtime_error("Could not create the metrics socket");
+
+    int reuse = 1;
+    setsockopt(m_Socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    SocketLength_Type length = sizeof(address);
+
+    if (bind(m_Socket, reinterpret_cast<const sockaddr*>(&address), length) != 0
+        || listen(m_Socket, 4) != 0
+        || getsockname(m_Socket, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+    {
+        CloseSocket(m_Socket);
+        throw std::runtime_error("Could not listen for metrics on 127.0.0.1:" + std::to_string(port));
+    }
+
+    m_Port = ntohs(address.sin_port);
+    m_Thread = std::thread(&PrometheusExporter::run, this);
+}
+
+PrometheusExporter::~PrometheusExporter()
+{
+    m_Running = false;
+    m_Thread.join();
+    CloseSocket(m_Socket);
+}
+
+void PrometheusExporter::run()
+{
+    while (m_Running)
+    {
+        pollfd listener{};
+        listener.fd = decltype(listener.fd)(m_Socket);
+        listener.events = POLLIN;
+
+        if (poll(&listener, 1, POLL_TIMEOUT_MS) <= 0)
+            continue;
+
+        auto client = intptr_t(accept(m_Socket, nullptr, nullptr));
+
+        if (client < 0)
+            continue;
+
+        serve(client);
+        CloseSocket(client);
+    }
+}
+
+void PrometheusExporter::serve(intptr_t client) const
+{
+    std::string request;
+    char buffer[512];
+
+    // The request line is all that matters, the headers are read only to drain the socket
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+    {
+        pollfd readable{};
+        readable.fd = decltype(readable.fd)(client);
+        readable.events = POLLIN;
+
+        if (poll(&readable, 1, POLL_TIMEOUT_MS) <= 0)
+            return;
+
+        auto count = recv(client, buffer, sizeof(buffer), 0);
+
+        if (count <= 0)
+            return;
+
+        request.append(buffer, size_t(count));
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+
+    if (request.starts_with("GET /metrics ") || request.starts_with("GET /metrics?"))
+        body = m_Registry.renderPrometheus();
+    else
+        status = "404 Not Found";
+
+    SendAll(client, "HTTP/1.1 " + status + "\r\n"
+        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "Connection: close\r\n\r\n" + body);
+}
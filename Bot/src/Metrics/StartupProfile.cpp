@@ -0,0 +1,96 @@
+#include "Metrics/StartupProfile.h"
+
+#include <algorithm>
+#include <cstdio>
+
+static double ToMilliseconds(StartupProfile::Clock_Type::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+StartupProfile::StartupProfile()
+    : m_Origin(Clock_Type::now())
+{
+}
+
+void StartupProfile::record(const std::string& name, Clock_Type::time_point start, Clock_Type::time_point end)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Phases.push_back(Phase{ name, start - m_Origin, end - start });
+}
+
+void StartupProfile::mark(const std::string& name)
+{
+    auto now = Clock_Type::now();
+    record(name, now, now);
+}
+
+std::vector<StartupProfile::Phase> StartupProfile::getPhases() const
+{
+    std::vector<Phase> phases;
+
+    {
+        std::lock_guard lock(m_Mutex);
+        phases = m_Phases;
+    }
+
+    std::stable_sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) { return a.start < b.start; });
+    return phases;
+}
+
+StartupProfile::Clock_Type::duration StartupProfile::getElapsed() const
+{
+    return Clock_Type::now() - m_Origin;
+}
+
+std::string StartupProfile::render() const
+{
+    auto phases = getPhases();
+
+    size_t width = 5;
+    for (const auto& phase : phases)
+        width = std::max(width, phase.name.size());
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-*s %10s %10s\n", int(width), "phase", "start ms", "took ms");
+    std::string report = line;
+
+    for (const auto& phase : phases)
+    {
+        std::snprintf(line, sizeof(line), "%-*s %10.1f %10.1f\n", int(width), phase.name.c_str(), ToMilliseconds(phase.start), ToMilliseconds(phase.duration));
+        report += line;
+    }
+
+    return report;
+}
+
+void StartupProfile::exportTo(MetricsRegistry& registry) const
+{
+    auto collect = [this](bool end) {
+        std::vector<MetricsRegistry::Sample> samples;
+
+        for (const auto& phase : getPhases())
+        {
+            auto value = end ? phase.start + phase.duration : phase.duration;
+            samples.push_back({ MetricsRegistry::Labels({ { "phase", phase.name } }), std::chrono::duration<double>(value).count() });
+        }
+
+        return samples;
+    };
+
+    registry.addCollector("bot_startup_phase_seconds", "Duration of each startup phase.", MetricsRegistry::Type::Gauge,
+        [collect]() { return collect(false); });
+    registry.addCollector("bot_startup_phase_end_seconds", "Time from process start to the end of each startup phase.", MetricsRegistry::Type::Gauge,
+        [collect]() { return collect(true); });
+}
+
+StartupPhase::StartupPhase(StartupProfile* profile, std::string name)
+    : m_Profile(profile), m_Name(std::move(name)), m_Start(profile == nullptr ? StartupProfile::Clock_Type::time_point() : StartupProfile::Clock_Type::now())
+{
+}
+
+StartupPhase::~StartupPhase()
+{
+    if (m_Profile != nullptr)
+        m_Profile->record(m_Name, m_Start, StartupProfile::Clock_Type::now());
+}
@@ -0,0 +1,98 @@
+#include "Simulation/SimulatedGateway.h"
+
+SimulatedGateway::SimulatedGateway(CommandRouter& router, SimulatedRestApi& api)
+    : m_Router(router), m_Api(api)
+{
+}
+
+dpp::snowflake SimulatedGateway::sendCommand(const Invoker& invoker, const std::string& command, const std::string& subcommand, const std::vector<Option_Type>& options)
+{
+    dpp::command_interaction data;
+    data.name = command;
+
+    std::vector<dpp::command_data_option>* target = &data.options;
+
+    if (!subcommand.empty())
+    {
+        dpp::command_data_option option;
+        option.name = subcommand;
+        option.type = dpp::co_sub_command;
+        data.options.push_back(option);
+        target = &data.options.back().options;
+    }
+
+    for (const auto& [name, value] : options)
+        target->push_back(CreateOption(name, value));
+
+    dpp::slashcommand_t event(nullptr, "");
+    event.command = createInteraction(invoker);
+    event.command.data = data;
+
+    m_Api.onDispatched(event.command.id);
+
+    if (!m_Router.dispatch(event))
+        m_Api.reply(event.command, dpp::message("Unknown command").set_flags(dpp::m_ephemeral));
+
+    return event.command.id;
+}
+
+bool SimulatedGateway::sendAutocomplete(const Invoker& invoker, const std::string& command, const std::string& subcommand, const std::string& option, const std::string& typed)
+{
+    dpp::autocomplete_interaction data;
+    data.name = command;
+
+    dpp::command_data_option focused = CreateOption(option, typed);
+    focused.focused = true;
+
+    if (subcommand.empty())
+    {
+        data.options.push_back(focused);
+    }
+    else
+    {
+        dpp::command_data_option group;
+        group.name = subcommand;
+        group.type = dpp::co_sub_command;
+        group.options.push_back(focused);
+        data.options.push_back(group);
+    }
+
+    dpp::autocomplete_t event(nullptr, "");
+    event.command = createInteraction(invoker);
+    event.command.data = data;
+
+    return m_Router.dispatchAutocomplete(event);
+}
+
+dpp::interaction SimulatedGateway::createInteraction(const Invoker& invoker)
+{
+    uint64_t id = m_NextId.fetch_add(1, std::memory_order_relaxed);
+
+    dpp::interaction interaction;
+    interaction.id = id;
+    interaction.token = "simulated-" + std::to_string(id);
+    interaction.usr.id = invoker.user;
+    interaction.guild_id = invoker.guild;
+    interaction.channel_id = invoker.channel;
+    return interaction;
+}
+
+dpp::command_data_option SimulatedGateway::CreateOption(const std::string& name, const dpp::command_value& value)
+{
+    dpp::command_data_option option;
+    option.name = name;
+    option.value = value;
+
+    if (std::holds_alternative<int64_t>(value))
+        option.type = dpp::co_integer;
+    else if (std::holds_alternative<bool>(value))
+        option.type = dpp::co_boolean;
+    else if (std::holds_alternative<dpp::snowflake>(value))
+        option.type = dpp::co_channel;
+    else if (std::holds_alternative<double>(value))
+        option.type = dpp::co_number;
+    else
+        option.type = dpp::co_string;
+
+    return option;
+}
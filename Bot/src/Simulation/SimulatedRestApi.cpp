@@ -0,0 +1,222 @@
+#include "Simulation/SimulatedRestApi.h"
+
+/**
+ * @brief Message sink counting the messages on a simulated REST API.
+ * 
+ */
+class SimulatedRestApi::MessageSink final : public IMessageSink
+{
+public:
+    MessageSink(SimulatedRestApi& api)
+        : m_Api(api)
+    {
+    }
+
+    void createMessage(const dpp::snowflake&, const std::string& body, Callback_Type onDone = nullptr) override
+    {
+        m_Api.m_Messages.fetch_add(1, std::memory_order_relaxed);
+        m_Api.m_MessageBytes.fetch_add(body.size(), std::memory_order_relaxed);
+
+        if (onDone)
+            m_Api.deliver([onDone = std::move(onDone)]() { onDone(true); });
+    }
+
+    void createEditableMessage(const dpp::snowflake&, const std::string& body, CreatedCallback_Type onCreated) override
+    {
+        m_Api.m_Messages.fetch_add(1, std::memory_order_relaxed);
+        m_Api.m_MessageBytes.fetch_add(body.size(), std::memory_order_relaxed);
+
+        dpp::snowflake message = m_Api.m_NextMessage.fetch_add(1, std::memory_order_relaxed);
+
+        if (onCreated)
+            m_Api.deliver([onCreated = std::move(onCreated), message]() { onCreated(message); });
+    }
+
+    void editMessage(const dpp::snowflake&, const dpp::snowflake&, const std::string& body, Callback_Type onDone = nullptr) override
+    {
+        m_Api.m_MessageEdits.fetch_add(1, std::memory_order_relaxed);
+        m_Api.m_MessageBytes.fetch_add(body.size(), std::memory_order_relaxed);
+
+        if (onDone)
+            m_Api.deliver([onDone = std::move(onDone)]() { onDone(true); });
+    }
+
+private:
+    SimulatedRestApi& m_Api;
+};
+
+SimulatedRestApi::SimulatedRestApi(std::chrono::microseconds latency, bool keepResponses)
+    : m_Latency(latency), m_KeepResponses(keepResponses)
+{
+    if (m_Latency.count() > 0)
+        m_Thread = std::thread(&SimulatedRestApi::serve, this);
+}
+
+SimulatedRestApi::~SimulatedRestApi()
+{
+    if (!m_Thread.joinable())
+        return;
+
+    {
+        std::lock_guard lock(m_RequestsMutex);
+        m_Stopping = true;
+    }
+
+    m_RequestsCondition.notify_one();
+    m_Thread.join();
+}
+
+void SimulatedRestApi::reply(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback)
+{
+    m_Replies.fetch_add(1, std::memory_order_relaxed);
+    onAnswered(interaction, message);
+    respond(std::move(callback));
+}
+
+void SimulatedRestApi::defer(const dpp::interaction&, bool, Callback_Type callback)
+{
+    m_Deferrals.fetch_add(1, std::memory_order_relaxed);
+    respond(std::move(callback));
+}
+
+void SimulatedRestApi::editResponse(const dpp::interaction& interaction, const dpp::message& message, Callback_Type callback)
+{
+    m_Edits.fetch_add(1, std::memory_order_relaxed);
+    onAnswered(interaction, message);
+    respond(std::move(callback));
+}
+
+void SimulatedRestApi::suggest(const dpp::interaction&, const std::vector<std::string>&)
+{
+    m_Suggestions.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::unique_ptr<IMessageSink> SimulatedRestApi::createMessageSink()
+{
+    return std::make_unique<MessageSink>(*this);
+}
+
+void SimulatedRestApi::onDispatched(const dpp::snowflake& interaction)
+{
+    std::lock_guard lock(m_InteractionsMutex);
+    m_Dispatched[interaction] = std::chrono::steady_clock::now();
+}
+
+void SimulatedRestApi::drain()
+{
+    std::unique_lock lock(m_RequestsMutex);
+    m_DrainedCondition.wait(lock, [this]() { return m_Requests.empty() && m_InFlight == 0; });
+}
+
+SimulatedRestApi::Stats SimulatedRestApi::getStats() const
+{
+    Stats stats;
+    stats.replies = m_Replies.load(std::memory_order_relaxed);
+    stats.deferrals = m_Deferrals.load(std::memory_order_relaxed);
+    stats.edits = m_Edits.load(std::memory_order_relaxed);
+    stats.suggestions = m_Suggestions.load(std::memory_order_relaxed);
+    stats.messages = m_Messages.load(std::memory_order_relaxed);
+    stats.messageBytes = m_MessageBytes.load(std::memory_order_relaxed);
+    stats.messageEdits = m_MessageEdits.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string SimulatedRestApi::getResponse(const dpp::snowflake& interaction) const
+{
+    std::lock_guard lock(m_InteractionsMutex);
+
+    auto response = m_Responses.find(interaction);
+    return response == m_Responses.end() ? std::string() : response->second;
+}
+
+size_t SimulatedRestApi::getUnansweredCount() const
+{
+    std::lock_guard lock(m_InteractionsMutex);
+    return m_Dispatched.size();
+}
+
+void SimulatedRestApi::onAnswered(const dpp::interaction& interaction, const dpp::message& message)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard lock(m_InteractionsMutex);
+
+    auto dispatched = m_Dispatched.find(interaction.id);
+
+    if (dispatched != m_Dispatched.end())
+    {
+        m_ResponseLatency.record(now - dispatched->second);
+        m_Dispatched.erase(dispatched);
+    }
+
+    if (m_KeepResponses)
+    {
+        std::string& response = m_Responses[interaction.id];
+        response = message.content;
+
+        // Replies of the controllers are mostly embeds
+        for (const auto& embed : message.embeds)
+        {
+            response += embed.description;
+
+            for (const auto& field : embed.fields)
+                response += "\n" + field.name + ": " + field.value;
+        }
+    }
+}
+
+void SimulatedRestApi::deliver(std::function<void()> action)
+{
+    if (!m_Thread.joinable())
+    {
+        action();
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_RequestsMutex);
+        m_Requests.push_back(Request{ std::chrono::steady_clock::now() + m_Latency, std::move(action) });
+    }
+
+    m_RequestsCondition.notify_one();
+}
+
+void SimulatedRestApi::respond(Callback_Type callback)
+{
+    if (!callback)
+        return;
+
+    deliver([callback = std::move(callback)]() {
+        dpp::confirmation_callback_t result;
+        result.http_info.status = 204;
+        callback(result);
+    });
+}
+
+void SimulatedRestApi::serve()
+{
+    std::unique_lock lock(m_RequestsMutex);
+
+    while (true)
+    {
+        m_RequestsCondition.wait(lock, [this]() { return m_Stopping || !m_Requests.empty(); });
+
+        if (m_Requests.empty())
+            return;
+
+        // The latency is the same for every request, they complete in order
+        Request request = std::move(m_Requests.front());
+        m_Requests.pop_front();
+        ++m_InFlight;
+
+        lock.unlock();
+        std::this_thread::sleep_until(request.deadline);
+        request.action();
+        lock.lock();
+
+        --m_InFlight;
+
+        if (m_Requests.empty() && m_InFlight == 0)
+            m_DrainedCondition.notify_all();
+    }
+}
@@ -0,0 +1,99 @@
+#include "Simulation/SimulatedTimerScheduler.h"
+
+SimulatedTimerScheduler::SimulatedTimerScheduler(VirtualClock* clock)
+    : m_Clock(clock)
+{
+}
+
+dpp::timer SimulatedTimerScheduler::startTimer(Callback_Type callback, uint64_t seconds)
+{
+    std::lock_guard lock(m_Mutex);
+
+    // DPP timers tick at least every second
+    uint64_t period = seconds == 0 ? 1 : seconds;
+    dpp::timer timer = m_NextTimer++;
+
+    m_Timers.emplace(timer, Entry{ std::make_shared<const Callback_Type>(std::move(callback)), period });
+    m_Queue.emplace(m_Now + period, timer);
+
+    return timer;
+}
+
+void SimulatedTimerScheduler::stopTimer(const dpp::timer& timer)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Timers.erase(timer);
+}
+
+void SimulatedTimerScheduler::stopTimers(const std::vector<dpp::timer>& timers)
+{
+    std::lock_guard lock(m_Mutex);
+
+    for (const auto& timer : timers)
+        m_Timers.erase(timer);
+}
+
+size_t SimulatedTimerScheduler::advance(uint64_t seconds)
+{
+    size_t fired = 0;
+    uint64_t target;
+
+    {
+        std::lock_guard lock(m_Mutex);
+        target = m_Now + seconds;
+    }
+
+    while (true)
+    {
+        dpp::timer timer;
+        std::shared_ptr<const Callback_Type> callback;
+
+        {
+            std::lock_guard lock(m_Mutex);
+
+            if (m_Queue.empty() || m_Queue.top().first > target)
+            {
+                moveTo_NoLock(target);
+                return fired;
+            }
+
+            auto [due, next] = m_Queue.top();
+            timer = next;
+            m_Queue.pop();
+
+            auto entry = m_Timers.find(timer);
+
+            if (entry == m_Timers.end())
+                continue;
+
+            moveTo_NoLock(due);
+            m_Queue.emplace(due + entry->second.period, timer);
+
+            // Kept alive, the callback may stop its own timer
+            callback = entry->second.callback;
+        }
+
+        (*callback)(timer);
+        ++fired;
+    }
+}
+
+void SimulatedTimerScheduler::moveTo_NoLock(uint64_t time)
+{
+    if (m_Clock != nullptr)
+        m_Clock->advance(std::chrono::seconds(time - m_Now));
+
+    m_Now = time;
+}
+
+uint64_t SimulatedTimerScheduler::getNow() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Now;
+}
+
+size_t SimulatedTimerScheduler::getTimerCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Timers.size();
+}
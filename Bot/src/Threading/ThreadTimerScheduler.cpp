@@ -0,0 +1,96 @@
+#include "Threading/ThreadTimerScheduler.h"
+
+ThreadTimerScheduler::ThreadTimerScheduler()
+    : m_Thread([this]() { run(); })
+{
+}
+
+ThreadTimerScheduler::~ThreadTimerScheduler()
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Stopping = true;
+    }
+
+    m_Condition.notify_one();
+    m_Thread.join();
+}
+
+dpp::timer ThreadTimerScheduler::startTimer(Callback_Type callback, uint64_t seconds)
+{
+    dpp::timer timer;
+
+    {
+        std::lock_guard lock(m_Mutex);
+
+        // As the cluster timers, at least every second
+        auto period = std::chrono::seconds(seconds == 0 ? 1 : seconds);
+        timer = m_NextTimer++;
+
+        m_Timers.emplace(timer, Entry{ std::make_shared<const Callback_Type>(std::move(callback)), period });
+        m_Queue.emplace(Clock_Type::now() + period, timer);
+    }
+
+    m_Condition.notify_one();
+
+    return timer;
+}
+
+void ThreadTimerScheduler::stopTimer(const dpp::timer& timer)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Timers.erase(timer);
+}
+
+void ThreadTimerScheduler::stopTimers(const std::vector<dpp::timer>& timers)
+{
+    std::lock_guard lock(m_Mutex);
+
+    for (const auto& timer : timers)
+        m_Timers.erase(timer);
+}
+
+size_t ThreadTimerScheduler::getTimerCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Timers.size();
+}
+
+void ThreadTimerScheduler::run()
+{
+    std::unique_lock lock(m_Mutex);
+
+    while (!m_Stopping)
+    {
+        if (m_Queue.empty())
+        {
+            m_Condition.wait(lock);
+            continue;
+        }
+
+        auto [due, timer] = m_Queue.top();
+
+        // Woken early by a new timer, which may be due first
+        if (Clock_Type::now() < due)
+        {
+            m_Condition.wait_until(lock, due);
+            continue;
+        }
+
+        m_Queue.pop();
+
+        auto entry = m_Timers.find(timer);
+
+        if (entry == m_Timers.end())
+            continue;
+
+        m_Queue.emplace(due + entry->second.period, timer);
+
+        // Kept alive, the callback may stop its own timer. Run unlocked, it may start and stop timers
+        auto callback = entry->second.callback;
+
+        lock.unlock();
+        (*callback)(timer);
+        lock.lock();
+    }
+}
@@ -0,0 +1,153 @@
+#include "Threading/WorkerPool.h"
+
+#include <stdexcept>
+
+WorkerPool::WorkerPool(size_t threadCount, size_t capacity)
+    : m_Capacity(capacity)
+{
+    for (size_t i = 0; i < threadCount; ++i)
+        m_Threads.emplace_back([this]() { work(); });
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Stopping = true;
+    }
+
+    m_Condition.notify_all();
+
+    for (auto& thread : m_Threads)
+        thread.join();
+}
+
+bool WorkerPool::submit(Task_Type task)
+{
+    {
+        std::lock_guard lock(m_Mutex);
+
+        if (m_Pending >= m_Capacity)
+            return false;
+
+        ++m_Pending;
+        m_Ready.push_back(Job{ std::move(task), {} });
+    }
+
+    m_Condition.notify_one();
+    return true;
+}
+
+bool WorkerPool::submit(const std::string& key, Task_Type task)
+{
+    {
+        std::lock_guard lock(m_Mutex);
+
+        if (m_Pending >= m_Capacity)
+            return false;
+
+        ++m_Pending;
+
+        auto [strand, created] = m_Strands.try_emplace(key);
+        strand->second.push_back(std::move(task));
+
+        // A strand already queued or running picks the task up when its previous task completes
+        if (!created)
+            return true;
+
+        m_Ready.push_back(Job{ {}, key });
+    }
+
+    m_Condition.notify_one();
+    return true;
+}
+
+WorkerPool::ScheduleAwaitable WorkerPool::schedule()
+{
+    return ScheduleAwaitable(*this, {});
+}
+
+WorkerPool::ScheduleAwaitable WorkerPool::schedule(std::string key)
+{
+    return ScheduleAwaitable(*this, std::move(key));
+}
+
+size_t WorkerPool::getPendingCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_Pending;
+}
+
+void WorkerPool::work()
+{
+    std::unique_lock lock(m_Mutex);
+
+    while (true)
+    {
+        m_Condition.wait(lock, [this]() { return m_Stopping || !m_Ready.empty(); });
+
+        if (m_Ready.empty())
+            return;
+
+        Job job = std::move(m_Ready.front());
+        m_Ready.pop_front();
+
+        bool keyed = !job.task;
+        Task_Type task = keyed ? m_Strands.at(job.key).front() : std::move(job.task);
+
+        lock.unlock();
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // Tasks report their own errors, a throwing task must not take the worker down
+        }
+
+        lock.lock();
+
+        --m_Pending;
+
+        if (keyed)
+        {
+            auto strand = m_Strands.find(job.key);
+            strand->second.pop_front();
+
+            if (strand->second.empty())
+                m_Strands.erase(strand);
+            else
+            {
+                m_Ready.push_back(Job{ {}, job.key });
+                m_Condition.notify_one();
+            }
+        }
+    }
+}
+
+/* ScheduleAwaitable nested class */
+
+WorkerPool::ScheduleAwaitable::ScheduleAwaitable(WorkerPool& pool, std::string key)
+    : m_Pool(pool), m_Key(std::move(key))
+{
+}
+
+bool WorkerPool::ScheduleAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    auto resume = [handle]() { handle.resume(); };
+
+    // Once submitted, the coroutine may resume and destroy this awaitable before submit returns
+    if (m_Key.empty() ? m_Pool.submit(resume) : m_Pool.submit(m_Key, resume))
+        return true;
+
+    // Rejected: resume immediately, await_resume reports the error
+    m_Accepted = false;
+    return false;
+}
+
+void WorkerPool::ScheduleAwaitable::await_resume() const
+{
+    if (!m_Accepted)
+        throw std::runtime_error("The bot is busy, please try again later.");
+}
@@ -0,0 +1,6 @@
+#include "Time/SystemClock.h"
+
+SystemClock::TimePoint_Type SystemClock::now() const
+{
+    return std::chrono::system_clock::now();
+}
@@ -0,0 +1,129 @@
+#include "Time/TimeFormatter.h"
+
+#include <stdexcept>
+
+namespace
+{
+    struct FormattedEntry
+    {
+        TimeFormatter::Zone_Type zone = nullptr;
+        int64_t second = 0;
+        TimeFormatter::Buffer_Type formatted;
+    };
+
+    struct ZoneEntry
+    {
+        TimeFormatter::Zone_Type zone = nullptr;
+        std::chrono::sys_info info;
+    };
+
+    constexpr size_t FORMATTED_CACHE_SIZE = 256;
+    constexpr size_t ZONE_CACHE_SIZE = 8;
+
+    thread_local std::array<FormattedEntry, FORMATTED_CACHE_SIZE> t_FormattedCache;
+    thread_local std::array<ZoneEntry, ZONE_CACHE_SIZE> t_ZoneCache;
+    thread_local size_t t_NextZoneEntry = 0;
+
+    const std::chrono::sys_info& GetZoneInfo(TimeFormatter::Zone_Type zone, const std::chrono::sys_seconds& time)
+    {
+        for (const auto& entry : t_ZoneCache)
+        {
+            if (entry.zone == zone && entry.info.begin <= time && time < entry.info.end)
+                return entry.info;
+        }
+
+        auto& entry = t_ZoneCache[t_NextZoneEntry];
+        t_NextZoneEntry = (t_NextZoneEntry + 1) % ZONE_CACHE_SIZE;
+
+        entry.zone = zone;
+        entry.info = zone->get_info(time);
+
+        return entry.info;
+    }
+
+    void WriteDigits(char* out, unsigned value, size_t count)
+    {
+        for (size_t i = count; i > 0; --i)
+        {
+            out[i - 1] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+}
+
+std::string_view TimeFormatter::Format(const TimePoint_Type& time, Zone_Type zone, Buffer_Type& buffer)
+{
+    using namespace std::chrono;
+
+    if (zone == nullptr)
+        zone = GetDefaultZone();
+
+    auto second = floor<seconds>(time);
+    int64_t key = second.time_since_epoch().count();
+
+    size_t hash = std::hash<const void*>{}(zone) ^ (static_cast<size_t>(key) * 0x9E3779B97F4A7C15ull);
+    auto& entry = t_FormattedCache[(hash >> 32) % FORMATTED_CACHE_SIZE];
+
+    if (entry.zone != zone || entry.second != key)
+    {
+        auto local = local_seconds(second.time_since_epoch() + GetZoneInfo(zone, second).offset);
+        auto day = floor<days>(local);
+        year_month_day ymd(day);
+        hh_mm_ss hms(local - day);
+
+        // "dd/mm/YYYY hh:mm:ss"
+        char* out = entry.formatted.data();
+        WriteDigits(out + 0, static_cast<unsigned>(ymd.day()), 2);
+        out[2] = '/';
+        WriteDigits(out + 3, static_cast<unsigned>(ymd.month()), 2);
+        out[5] = '/';
+        WriteDigits(out + 6, static_cast<unsigned>(static_cast<int>(ymd.year())), 4);
+        out[10] = ' ';
+        WriteDigits(out + 11, static_cast<unsigned>(hms.hours().count()), 2);
+        out[13] = ':';
+        WriteDigits(out + 14, static_cast<unsigned>(hms.minutes().count()), 2);
+        out[16] = ':';
+        WriteDigits(out + 17, static_cast<unsigned>(hms.seconds().count()), 2);
+
+        entry.zone = zone;
+        entry.second = key;
+    }
+
+    buffer = entry.formatted;
+
+    return std::string_view(buffer.data(), buffer.size());
+}
+
+std::string TimeFormatter::Format(const TimePoint_Type& time, Zone_Type zone)
+{
+    Buffer_Type buffer;
+    return std::string(Format(time, zone, buffer));
+}
+
+TimeFormatter::Zone_Type TimeFormatter::GetDefaultZone()
+{
+    static const Zone_Type zone = []() -> Zone_Type {
+        try
+        {
+            return std::chrono::current_zone();
+        }
+        catch (const std::runtime_error&)
+        {
+            return std::chrono::locate_zone("UTC");
+        }
+    }();
+
+    return zone;
+}
+
+TimeFormatter::Zone_Type TimeFormatter::LocateZone(std::string_view name)
+{
+    try
+    {
+        return std::chrono::locate_zone(name);
+    }
+    catch (const std::runtime_error&)
+    {
+        return nullptr;
+    }
+}
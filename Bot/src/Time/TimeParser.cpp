@@ -0,0 +1,169 @@
+#include "Time/TimeParser.h"
+
+#include <array>
+#include <charconv>
+#include <limits>
+#include <string>
+
+#include "Controllers/ControllerExceptions.h"
+
+namespace
+{
+    constexpr bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    void SkipSpaces(std::string_view str, size_t& pos)
+    {
+        while (pos < str.size() && IsSpace(str[pos]))
+            ++pos;
+    }
+
+    // Same rules as operator>> on an integer: leading spaces are skipped and a sign is allowed
+    template <typename T>
+    bool ReadInteger(std::string_view str, size_t& pos, T& value)
+    {
+        SkipSpaces(str, pos);
+
+        if (pos < str.size() && str[pos] == '+')
+        {
+            if (pos + 1 >= str.size() || str[pos + 1] < '0' || str[pos + 1] > '9')
+                return false;
+
+            ++pos;
+        }
+
+        auto [end, error] = std::from_chars(str.data() + pos, str.data() + str.size(), value);
+
+        if (error != std::errc())
+            return false;
+
+        pos = end - str.data();
+        return true;
+    }
+
+    // Same rules as operator>> on a char: leading spaces are skipped
+    bool ReadChar(std::string_view str, size_t& pos, char& c)
+    {
+        SkipSpaces(str, pos);
+
+        if (pos >= str.size())
+            return false;
+
+        c = str[pos++];
+        return true;
+    }
+
+    // Same rules as operator>> on a string: leading spaces are skipped, reads until the next space
+    bool ReadWord(std::string_view str, size_t& pos, std::string_view& word)
+    {
+        SkipSpaces(str, pos);
+
+        if (pos >= str.size())
+            return false;
+
+        size_t begin = pos;
+        while (pos < str.size() && !IsSpace(str[pos]))
+            ++pos;
+
+        word = str.substr(begin, pos - begin);
+        return true;
+    }
+
+    struct IntervalUnit
+    {
+        char symbol;
+        int64_t seconds;
+    };
+
+    // In descending order
+    constexpr std::array<IntervalUnit, 4> INTERVAL_UNITS = {{
+        {'d', 60 * 60 * 24},
+        {'h', 60 * 60},
+        {'m', 60},
+        {'s', 1},
+    }};
+}
+
+TimeParser::TimePoint_Type TimeParser::ParseTime(std::string_view time, TimeFormatter::Zone_Type zone)
+{
+    using namespace std::chrono;
+
+    int day, month, yearValue, hour, minute, second;
+    char sep1, sep2, sep4, sep5;
+    size_t pos = 0;
+
+    bool ok = ReadInteger(time, pos, day) && ReadChar(time, pos, sep1)
+        && ReadInteger(time, pos, month) && ReadChar(time, pos, sep2)
+        && ReadInteger(time, pos, yearValue)
+        && ReadInteger(time, pos, hour) && ReadChar(time, pos, sep4)
+        && ReadInteger(time, pos, minute) && ReadChar(time, pos, sep5)
+        && ReadInteger(time, pos, second);
+
+    if (!ok || sep1 != '/' || sep2 != '/' || sep4 != ':' || sep5 != ':')
+        throw ParsingException("Invalid time format: " + std::string(time));
+
+    if (yearValue < static_cast<int>(year::min()) || yearValue > static_cast<int>(year::max()))
+        throw ParsingException("Could not parse time: " + std::string(time));
+
+    // Fields are normalized the same way mktime does: 13/2024 is 01/2025, day 0 is the last day of the previous month
+    auto yearMonth = year_month(year(yearValue), January) + months(month - 1);
+    auto date = sys_days(yearMonth / 1) + days(day - 1);
+    auto local = local_seconds(date.time_since_epoch()) + hours(hour) + minutes(minute) + seconds(second);
+
+    if (zone == nullptr)
+        zone = TimeFormatter::GetDefaultZone();
+
+    TimePoint_Type tp = zone->to_sys(local, choose::earliest);
+
+    if (tp == TimePoint_Type{})
+        throw ParsingException("Could not parse time: " + std::string(time));
+
+    return tp;
+}
+
+int64_t TimeParser::ParseInterval(std::string_view interval)
+{
+    int64_t total = 0;
+    size_t pos = 0;
+    size_t nextPossible = 0;
+    bool end = false;
+
+    while (!end && nextPossible < INTERVAL_UNITS.size())
+    {
+        int64_t value;
+        std::string_view unit;
+
+        if (!ReadInteger(interval, pos, value) || !ReadWord(interval, pos, unit))
+            throw ParsingException("Invalid interval format (could not parse value): " + std::string(interval));
+
+        end = pos == interval.size();
+
+        size_t index = 0;
+        while (index < INTERVAL_UNITS.size() && (unit.size() != 1 || unit[0] != INTERVAL_UNITS[index].symbol))
+            ++index;
+
+        if (index == INTERVAL_UNITS.size())
+            throw ParsingException("Invalid interval unit: " + std::string(unit));
+
+        if (index < nextPossible)
+            throw ParsingException("Invalid interval format (not in descending order): " + std::string(interval));
+
+        int64_t multiplier = INTERVAL_UNITS[index].seconds;
+        int64_t max = std::numeric_limits<int64_t>::max();
+        int64_t min = std::numeric_limits<int64_t>::min();
+
+        if (value > max / multiplier || value < min / multiplier
+            || (value > 0 && total > max - value * multiplier) || (value < 0 && total < min - value * multiplier))
+            throw ParsingException("Invalid interval format (out of range): " + std::string(interval));
+
+        total += value * multiplier;
+        nextPossible = index + 1;
+    }
+
+    if (!end)
+        throw ParsingException("Invalid interval format (too many units): " + std::string(interval));
+
+    return total;
+}
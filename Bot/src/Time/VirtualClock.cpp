@@ -0,0 +1,19 @@
+#include "Time/VirtualClock.h"
+
+VirtualClock::VirtualClock(const TimePoint_Type& start)
+    : m_Now(start.time_since_epoch().count())
+{
+}
+
+VirtualClock::TimePoint_Type VirtualClock::now() const
+{
+    return TimePoint_Type(TimePoint_Type::duration(m_Now.load(std::memory_order_acquire)));
+}
+
+void VirtualClock::advance(std::chrono::nanoseconds duration)
+{
+    if (duration.count() <= 0)
+        return;
+
+    m_Now.fetch_add(std::chrono::duration_cast<TimePoint_Type::duration>(duration).count(), std::memory_order_acq_rel);
+}
@@ -0,0 +1,152 @@
+#include "Tracing/Tracer.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    constexpr size_t EVENTS_PER_THREAD = Tracer::EVENTS_PER_THREAD;
+
+    struct Event
+    {
+        // Index of the event plus one, 0 while it is being written
+        std::atomic<uint64_t> sequence = 0;
+        std::atomic<const char*> name = nullptr;
+        std::atomic<int64_t> start = 0;
+        std::atomic<int64_t> duration = 0;
+    };
+
+    struct ThreadBuffer
+    {
+        uint32_t threadId = 0;
+        // Number of events ever written. Only the owning thread writes it
+        std::atomic<uint64_t> head = 0;
+        // Number of events written before the last clear
+        std::atomic<uint64_t> cleared = 0;
+        std::array<Event, EVENTS_PER_THREAD> events;
+    };
+
+    const auto EPOCH = std::chrono::steady_clock::now();
+
+    // Buffers outlive their thread, so spans of exited threads are still exported
+    std::vector<std::unique_ptr<ThreadBuffer>> BUFFERS;
+    std::mutex BUFFERS_MUTEX;
+
+    thread_local ThreadBuffer* t_Buffer = nullptr;
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        if (t_Buffer == nullptr)
+        {
+            std::lock_guard lock(BUFFERS_MUTEX);
+
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadId = uint32_t(BUFFERS.size() + 1);
+            t_Buffer = buffer.get();
+            BUFFERS.push_back(std::move(buffer));
+        }
+
+        return *t_Buffer;
+    }
+
+    void AppendEvent(std::string& out, const char* name, uint32_t threadId, int64_t start, int64_t duration)
+    {
+        out += "{\"name\":\"";
+
+        for (const char* c = name; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                out += '\\';
+
+            out += *c;
+        }
+
+        // Chrome trace timestamps are in microseconds
+        char fields[128];
+        std::snprintf(fields, sizeof(fields), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            threadId, start / 1e3, duration / 1e3);
+
+        out += fields;
+    }
+}
+
+std::atomic<bool> Tracer::s_Enabled = false;
+
+void Tracer::SetEnabled(bool enabled)
+{
+    s_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::Clear()
+{
+    std::lock_guard lock(BUFFERS_MUTEX);
+
+    for (const auto& buffer : BUFFERS)
+        buffer->cleared.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+std::string Tracer::ExportChromeTrace()
+{
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    std::lock_guard lock(BUFFERS_MUTEX);
+
+    for (const auto& buffer : BUFFERS)
+    {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = std::max(buffer->cleared.load(std::memory_order_relaxed), head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0);
+
+        for (uint64_t i = begin; i < head; ++i)
+        {
+            const Event& event = buffer->events[i % EVENTS_PER_THREAD];
+
+            // Seqlock read: the event is skipped if its thread overwrote it meanwhile
+            uint64_t sequence = event.sequence.load(std::memory_order_acquire);
+            const char* name = event.name.load(std::memory_order_relaxed);
+            int64_t start = event.start.load(std::memory_order_relaxed);
+            int64_t duration = event.duration.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence != i + 1 || event.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            if (!first)
+                out += ',';
+
+            first = false;
+            AppendEvent(out, name, buffer->threadId, start, duration);
+        }
+    }
+
+    out += "]}";
+    return out;
+}
+
+void Tracer::Record(const char* name, int64_t start, int64_t duration)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    Event& event = buffer.events[index % EVENTS_PER_THREAD];
+
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.duration.store(duration, std::memory_order_relaxed);
+
+    event.sequence.store(index + 1, std::memory_order_release);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+int64_t Tracer::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - EPOCH).count();
+}
@@ -1,12 +1,48 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <dpp/dpp.h>
 
 #include "Commands.h"
+#include "Cluster/Lease.h"
+#include "Cluster/SharedRing.h"
+#include "Cluster/ShardMap.h"
 #include "Controllers/TimerController.h"
 #include "Controllers/PingController.h"
+#include "Controllers/CommandRegistrar.h"
+#include "Controllers/StatsController.h"
+#include "Discord/DppCommandPublisher.h"
+#include "Discord/DppMessageSink.h"
+#include "Firing/FiringEngine.h"
+#include "Logging/Logger.h"
+#include "Metrics/MetricsRegistry.h"
+#include "Metrics/PrometheusExporter.h"
+#include "Metrics/StartupProfile.h"
+#include "Threading/ThreadTimerScheduler.h"
+#include "Threading/WorkerPool.h"
+
+// Local port of the Prometheus endpoint of cluster 0, the next clusters use the next ports
+static constexpr uint16_t METRICS_PORT = 9464;
+// Local port of the Prometheus endpoint of the firing engine of cluster 0
+static constexpr uint16_t FIRING_ENGINE_METRICS_PORT = 9564;
+
+// A primary stuck for longer loses its shards to its standby, which checks every poll interval
+static constexpr std::chrono::milliseconds LEASE_TIMEOUT(1000);
+static constexpr std::chrono::milliseconds LEASE_HEARTBEAT_INTERVAL(250);
+static constexpr std::chrono::milliseconds STANDBY_POLL_INTERVAL(100);
+
+// Mutations wait at most this long in the ring of an idle firing engine
+static constexpr std::chrono::milliseconds FIRING_POLL_INTERVAL(1);
+// Checking that the command process still runs needs a system call, only done every this many idle polls
+static constexpr size_t FIRING_CLOSED_CHECK_POLLS = 100;
+// Countdown messages created by the firing engine are stored within this delay
+static constexpr uint64_t FIRING_REPORT_POLL_SECONDS = 1;
 
 /**
  * @brief Get the bot token from file.
@@ -16,52 +52,306 @@
  * @throw std::runtime_error if the file could not be opened.
  */
 std::string GetBotToken();
+
+/**
+ * @brief Remove a flag from the command line arguments.
+ * 
+ * @param arguments The arguments, the program name first.
+ * @param flag The flag, e.g. "--standby".
+ * @return true if the flag was given.
+ */
+bool TakeFlag(std::vector<const char*>& arguments, std::string_view flag);
+
+/**
+ * @brief Create the lease on the shards of this process, so that no other process fires their timers. It is not acquired.
+ * 
+ * @param shards The shards of this process.
+ * @return std::unique_ptr<Lease> The lease.
+ * 
+ * @throw std::runtime_error if a lock file can not be opened.
+ */
+std::unique_ptr<Lease> CreateShardLease(const ShardMap& shards);
+
+/**
+ * @brief Run the firing engine of a cluster: fire the timers of the command process started with --external-firing,
+ * on a thread of their own and through a REST client of their own. Runs until the process is killed.
+ * 
+ * @param botToken The bot token.
+ * @param shards The shards of the command process.
+ */
+[[noreturn]] void RunFiringEngine(const std::string& botToken, const ShardMap& shards);
     
-int main()
+int main(int argc, char* argv[])
 {
+    // Origin of the startup report, declared first so that it also outlives the metrics registry exporting it
+    StartupProfile startup;
+
+    // Formats and writes on its own thread, stopped before returning so that pending entries are written
+    Logger::Start(dpp::ll_debug);
+
+    std::string botToken;
+    ShardMap shards;
+    // Only held when another process may run the same shards, a single process has nothing to hand over
+    std::unique_ptr<Lease> shardLease;
+    // Declared before the controllers, which send timer mutations to it until destroyed
+    std::unique_ptr<SharedRing> firingRing;
+    // Created by the firing engine, read by a DPP timer until the cluster is destroyed
+    std::unique_ptr<SharedRing> firingReports;
+    bool standby;
+    bool externalFiring;
+    bool firingEngine;
+    bool leased;
+
+    {
+        StartupPhase phase(&startup, "read configuration");
+        botToken = GetBotToken();
+
+        std::vector<const char*> arguments(argv, argv + argc);
+        standby = TakeFlag(arguments, "--standby");
+        externalFiring = TakeFlag(arguments, "--external-firing");
+        firingEngine = TakeFlag(arguments, "--firing-engine");
+
+        // The arguments left are the sharding options. A primary followed by a standby is started with one of
+        // them, e.g. --shards=1
+        leased = standby || arguments.size() > 1;
+        shards = ShardMap::FromArguments(int(arguments.size()), arguments.data());
+    }
+
+    // The engine is not a command process: it neither holds the shards nor connects to the gateway
+    if (firingEngine)
+        RunFiringEngine(botToken, shards);
+
+    {
+        StartupPhase phase(&startup, "lock shards");
+
+        if (leased)
+        {
+            shardLease = CreateShardLease(shards);
+
+            if (!standby && !shardLease->tryAcquire())
+                throw std::runtime_error("The shards are already run by another process, start with --standby to take over from it");
+        }
+
+        shards.checkLayout();
+    }
+
     /* Setup the bot */
-    dpp::cluster bot(GetBotToken());
+    // Without sharding options, DPP picks the shard count recommended by Discord
+    uint32_t shardCount = shards.getClusterCount() > 1 || shards.isPartitioned() ? shards.getShardCount() : 0;
+    dpp::cluster bot(botToken, dpp::i_default_intents, shardCount, shards.getClusterId(), shards.getClusterCount());
+
+    Logger::Log(dpp::ll_info, "Cluster configured", LogField("cluster", shards.getClusterId()), LogField("clusters", shards.getClusterCount()),
+        LogField("shards", shards.getShardCount()));
+
+    bot.on_log([](const dpp::log_t& event) {
+        Logger::Write(event.severity, event.message);
+    });
+
+    // Declared before the controllers, which record to it and export their statistics through it
+    MetricsRegistry metrics;
+    startup.exportTo(metrics);
 
     std::vector<std::unique_ptr<Controller>> controllers;
-    controllers.push_back(std::make_unique<PingController>(bot));
-    controllers.push_back(std::make_unique<TimerController>(bot));
-    
-    bot.on_log(dpp::utility::cout_logger());
+    TimerController* timerController;
+
+    {
+        StartupPhase phase(&startup, "construct controllers");
+        controllers.push_back(std::make_unique<PingController>(bot));
+
+        auto timers = std::make_unique<TimerController>(bot, &metrics, shards);
+        timerController = timers.get();
+        controllers.push_back(std::move(timers));
+
+        controllers.push_back(std::make_unique<StatsController>(bot, metrics));
+
+        // Only followed by a standby holding the same lease
+        timerController->setJournaled(leased);
+    }
+
+    // Declared after the controllers, so pending handlers complete before the controllers are destroyed
+    WorkerPool workerPool(std::max(2u, std::thread::hardware_concurrency()), 1024);
+
+    metrics.addCollector("bot_commands_pending", "Commands waiting for or running on the worker pool.", MetricsRegistry::Type::Gauge, [&workerPool]() {
+        return std::vector<MetricsRegistry::Sample>{ { "", double(workerPool.getPendingCount()) } };
+    });
+
+    CommandRouter router(&workerPool, &metrics);
+    for (const auto& controller : controllers)
+        controller->registerRoutes(router);
+
+    // Declared last, so scrapes stop before anything they read is destroyed
+    std::unique_ptr<PrometheusExporter> metricsExporter;
+
+    try
+    {
+        auto port = uint16_t(METRICS_PORT + shards.getClusterId());
+        metricsExporter = std::make_unique<PrometheusExporter>(metrics, port);
+        Logger::Log(dpp::ll_info, "Metrics served", LogField("url", "http://127.0.0.1:" + std::to_string(port) + "/metrics"));
+    }
+    catch (const std::runtime_error& e)
+    {
+        Logger::Log(dpp::ll_warning, "Metrics are only available through /stats", LogField("error", e.what()));
+    }
+
+    DppCommandPublisher commandPublisher(bot);
+    CommandRegistrar commandRegistrar(commandPublisher);
     
     /* The event is fired when someone issues your commands */
-    bot.on_slashcommand([&bot, &controllers](const dpp::slashcommand_t& event) {
+    bot.on_slashcommand([&router](const dpp::slashcommand_t& event) {
 
-        for (const auto& controller : controllers)
+        if (!router.dispatch(event))
+            event.reply(dpp::message("Unknown command").set_flags(dpp::m_ephemeral));
+    });
+    
+    bot.on_autocomplete([&router](const dpp::autocomplete_t& event) {
+        router.dispatchAutocomplete(event);
+    });
+    
+    // Warm standby: the schedule is kept ready from what the primary persists, so that only the last changes
+    // are applied once its lease lapses
+    if (standby)
+    {
         {
-            if (controller->handleSlashCommand(event))
-                return;
+            StartupPhase phase(&startup, "load standby");
+            timerController->initStandby(&startup);
         }
 
-        event.reply(dpp::message("Unknown command").set_flags(dpp::m_ephemeral));
-    });
-    
-    bot.on_ready([&bot, &controllers](const dpp::ready_t& event) {
+        Logger::Log(dpp::ll_info, "Standing by", LogField("cluster", shards.getClusterId()));
 
-        if (dpp::run_once<struct init_controllers>())
+        while (!shardLease->tryAcquire())
         {
-            for (const auto& controller : controllers)
-                controller->init();
+            std::this_thread::sleep_for(STANDBY_POLL_INTERVAL);
 
-            bot.log(dpp::ll_info, "Controllers initialized");
+            try
+            {
+                timerController->followPrimary();
+            }
+            catch (const std::exception& e)
+            {
+                // Retried on the next poll, e.g. a timer file being rewritten by the primary
+                Logger::Log(dpp::ll_warning, "Could not follow the primary", LogField("error", e.what()));
+            }
         }
 
-        if (dpp::run_once<struct clear_bot_commands>())
+        Logger::Log(dpp::ll_info, "Lease acquired, taking over", LogField("cluster", shards.getClusterId()));
+        startup.mark("lease acquired");
+    }
+
+    // Created once the shards are held, a standby would otherwise detach the engine from the primary
+    if (externalFiring)
+    {
+        firingRing = SharedRing::Create(FiringEngine::GetRingName(shards));
+        timerController->setFiringRing(firingRing.get());
+
+        Logger::Log(dpp::ll_info, "Timers fired by the firing engine", LogField("ring", firingRing->getName()));
+
+        bot.start_timer([&firingReports, &shards, timerController](const dpp::timer&) {
+            try
+            {
+                // The reports left in the ring of a stopped engine are stored before opening the next one
+                if (firingReports != nullptr)
+                    timerController->applyFiringReports(*firingReports);
+
+                if (firingReports == nullptr || firingReports->isClosed())
+                    firingReports = SharedRing::Open(FiringEngine::GetReportRingName(shards));
+            }
+            catch (const std::exception& e)
+            {
+                Logger::Log(dpp::ll_warning, "Could not read the firing engine reports", LogField("error", e.what()));
+            }
+        }, FIRING_REPORT_POLL_SECONDS);
+    }
+
+    // Before connecting: loaded timers start firing as soon as the cluster runs, without waiting for
+    // the gateway nor the command registration
+    {
+        StartupPhase phase(&startup, "init controllers");
+        Controller::InitAll(controllers, &startup);
+    }
+
+    Logger::Log(dpp::ll_info, "Controllers initialized");
+
+    // Renewed on its own thread, DPP timers only tick on whole seconds. Without lease, nothing can make the bot step down
+    std::atomic<bool> leaseLost = false;
+    std::mutex heartbeatMutex;
+    std::condition_variable heartbeatCondition;
+    bool stopping = false;
+
+    std::thread heartbeat;
+
+    if (shardLease != nullptr)
+    {
+        heartbeat = std::thread([&]() {
+            std::unique_lock lock(heartbeatMutex);
+
+            while (!heartbeatCondition.wait_for(lock, LEASE_HEARTBEAT_INTERVAL, [&stopping]() { return stopping; }))
+            {
+                if (shardLease->renew())
+                    continue;
+
+                // Another process runs the shards now, firing their timers too would duplicate messages
+                Logger::Log(dpp::ll_critical, "Lease lost, stepping down", LogField("cluster", shards.getClusterId()));
+                leaseLost = true;
+                bot.shutdown();
+                return;
+            }
+        });
+    }
+
+    auto stopHeartbeat = [&]() {
+        if (!heartbeat.joinable())
+            return;
+
         {
-            bot.global_bulk_command_delete();
-            bot.log(dpp::ll_info, "Commands cleared");
+            std::lock_guard lock(heartbeatMutex);
+            stopping = true;
         }
 
+        heartbeatCondition.notify_one();
+        heartbeat.join();
+    };
+
+    auto connectStart = StartupProfile::Clock_Type::now();
+
+    bot.on_ready([&controllers, &router, &commandRegistrar, &shards, &startup, connectStart](const dpp::ready_t& event) {
+
         if (dpp::run_once<struct register_bot_commands>())
         {
+            auto registrationStart = StartupProfile::Clock_Type::now();
+            startup.record("connect gateway", connectStart, registrationStart);
+
+            std::vector<dpp::slashcommand> commands;
             for (const auto& controller : controllers)
-                controller->createCommands();
+            {
+                auto controllerCommands = controller->getCommands();
+                commands.insert(commands.end(), controllerCommands.begin(), controllerCommands.end());
+            }
+
+            auto onRegistered = [&startup, registrationStart]() {
+                startup.record("register commands", registrationStart, StartupProfile::Clock_Type::now());
+                startup.mark("serving");
+                Logger::Write(dpp::ll_info, "Startup report:\n" + startup.render());
+            };
+
+            // Commands are global, only one process registers them. The others route by name until the registration is persisted
+            if (!shards.isLeader())
+            {
+                if (commandRegistrar.bindRegistered(commands, router))
+                    Logger::Log(dpp::ll_info, "Commands registered by cluster 0 bound");
+                else
+                    Logger::Log(dpp::ll_info, "Commands not registered by cluster 0 yet, routed by name");
+
+                onRegistered();
+                return;
+            }
 
-            bot.log(dpp::ll_info, "Commands registered");
+            // The bot fully serves once commands are routed by id
+            bool pushed = commandRegistrar.registerCommands(commands, router, onRegistered);
+
+            if (pushed)
+                Logger::Log(dpp::ll_info, "Command schema changed, commands registered");
+            else
+                Logger::Log(dpp::ll_info, "Command schema unchanged, registration skipped");
         }
     });
     
@@ -71,11 +361,16 @@ int main()
     }
     catch(...)
     {
+        stopHeartbeat();
+        Logger::Stop();
         std::cerr << "Invalid token. Please check bot_token.txt" << std::endl;
         throw;
     }
+
+    stopHeartbeat();
+    Logger::Stop();
     
-    return 0;
+    return leaseLost ? EXIT_FAILURE : 0;
 }
 
 std::string GetBotToken()
@@ -100,4 +395,113 @@ std::string GetBotToken()
     }
 
     return botToken;
+}
+
+bool TakeFlag(std::vector<const char*>& arguments, std::string_view flag)
+{
+    auto it = std::find(arguments.begin() + 1, arguments.end(), flag);
+
+    if (it == arguments.end())
+        return false;
+
+    arguments.erase(it);
+    return true;
+}
+
+std::unique_ptr<Lease> CreateShardLease(const ShardMap& shards)
+{
+    std::vector<std::filesystem::path> paths;
+
+    for (uint32_t shard : shards.getOwnedShards())
+        paths.push_back(ShardMap::GetDataDirectory() / "locks" / ("shard-" + std::to_string(shard) + ".lock"));
+
+    return std::make_unique<Lease>(paths, LEASE_TIMEOUT);
+}
+
+void RunFiringEngine(const std::string& botToken, const ShardMap& shards)
+{
+    // Only its REST client is used, it never connects to the gateway
+    dpp::cluster bot(botToken);
+
+    bot.on_log([](const dpp::log_t& event) {
+        Logger::Write(event.severity, event.message);
+    });
+
+    MetricsRegistry metrics;
+    FiringEngine engine(std::make_unique<DppMessageSink>(bot), std::make_unique<ThreadTimerScheduler>(), &metrics, nullptr, shards);
+
+    std::unique_ptr<PrometheusExporter> metricsExporter;
+
+    try
+    {
+        metricsExporter = std::make_unique<PrometheusExporter>(metrics, uint16_t(FIRING_ENGINE_METRICS_PORT + shards.getClusterId()));
+    }
+    catch (const std::runtime_error& e)
+    {
+        Logger::Log(dpp::ll_warning, "Firing engine metrics unavailable", LogField("error", e.what()));
+    }
+
+    auto ringName = FiringEngine::GetRingName(shards);
+    Logger::Log(dpp::ll_info, "Firing engine waiting for its command process", LogField("ring", ringName));
+
+    while (true)
+    {
+        auto ring = SharedRing::Open(ringName);
+
+        if (ring == nullptr)
+        {
+            std::this_thread::sleep_for(STANDBY_POLL_INTERVAL);
+            continue;
+        }
+
+        try
+        {
+            // Mutations sent meanwhile wait in the ring, they are applied once loaded
+            engine.reload();
+        }
+        catch (const std::exception& e)
+        {
+            Logger::Log(dpp::ll_warning, "Could not load the timers", LogField("error", e.what()));
+            std::this_thread::sleep_for(STANDBY_POLL_INTERVAL);
+            continue;
+        }
+
+        // Replaced on each attach, the command process opens the ring of the running engine
+        auto reports = SharedRing::Create(FiringEngine::GetReportRingName(shards));
+        engine.setReportRing(reports.get());
+
+        Logger::Log(dpp::ll_info, "Firing engine attached", LogField("ring", ringName));
+
+        size_t idlePolls = 0;
+
+        while (true)
+        {
+            size_t applied = 0;
+
+            try
+            {
+                applied = engine.poll(*ring);
+            }
+            catch (const std::exception& e)
+            {
+                Logger::Log(dpp::ll_warning, "Could not reload the timers", LogField("error", e.what()));
+            }
+
+            if (applied > 0)
+            {
+                idlePolls = 0;
+                continue;
+            }
+
+            // Only once empty, the mutations sent before closing are applied
+            if (++idlePolls % FIRING_CLOSED_CHECK_POLLS == 0 && ring->isClosed())
+                break;
+
+            std::this_thread::sleep_for(FIRING_POLL_INTERVAL);
+        }
+
+        engine.setReportRing(nullptr);
+
+        Logger::Log(dpp::ll_warning, "Command process stopped, firing engine waiting for the next one");
+    }
 }
\ No newline at end of file
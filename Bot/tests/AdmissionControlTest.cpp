@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "Controllers/AdmissionControl.h"
+
+class AdmissionControlTest : public ::testing::Test
+{
+public:
+    AdmissionControlTest() = default;
+
+    ~AdmissionControlTest() = default;
+
+protected:
+    AdmissionControl::Clock_Type::time_point at(int milliseconds)
+    {
+        return start + std::chrono::milliseconds(milliseconds);
+    }
+
+protected:
+    AdmissionControl::Clock_Type::time_point start = AdmissionControl::Clock_Type::now();
+};
+
+TEST_F(AdmissionControlTest, UserBurstThenRefill)
+{
+    AdmissionControl admission;
+    admission.setLimit("timer", "set", { .rate = 1.0f, .burst = 3.0f }, { .rate = 100.0f, .burst = 100.0f });
+
+    EXPECT_TRUE(admission.admit("timer", "set", 1, 10, at(0)));
+    EXPECT_TRUE(admission.admit("timer", "set", 1, 10, at(0)));
+    EXPECT_TRUE(admission.admit("timer", "set", 1, 10, at(0)));
+    EXPECT_FALSE(admission.admit("timer", "set", 1, 10, at(0)));
+
+    // Other users and other commands have their own buckets
+    EXPECT_TRUE(admission.admit("timer", "set", 2, 10, at(0)));
+    EXPECT_TRUE(admission.admit("timer", "list", 1, 10, at(0)));
+
+    EXPECT_FALSE(admission.admit("timer", "set", 1, 10, at(500)));
+    EXPECT_TRUE(admission.admit("timer", "set", 1, 10, at(1100)));
+
+    auto stats = admission.getStats();
+    EXPECT_EQ(stats.admitted, 6);
+    EXPECT_EQ(stats.rejectedByUser, 2);
+    EXPECT_EQ(stats.rejectedByGuild, 0);
+}
+
+TEST_F(AdmissionControlTest, GuildLimitSharedByUsers)
+{
+    AdmissionControl admission;
+    admission.setLimit("timer", "list", { .rate = 1.0f, .burst = 5.0f }, { .rate = 1.0f, .burst = 2.0f });
+
+    EXPECT_TRUE(admission.admit("timer", "list", 1, 10, at(0)));
+    EXPECT_TRUE(admission.admit("timer", "list", 2, 10, at(0)));
+    EXPECT_FALSE(admission.admit("timer", "list", 3, 10, at(0)));
+    EXPECT_TRUE(admission.admit("timer", "list", 3, 11, at(0)));
+
+    // Outside guilds only the user bucket applies
+    EXPECT_TRUE(admission.admit("timer", "list", 3, 0, at(0)));
+
+    EXPECT_EQ(admission.getStats().rejectedByGuild, 1);
+}
+
+TEST_F(AdmissionControlTest, SmallTableEvictsOldestBuckets)
+{
+    AdmissionControl admission(8);
+    admission.setDefaultLimit({ .rate = 1.0f, .burst = 1.0f }, { .rate = 1000.0f, .burst = 1000.0f });
+
+    // More drained buckets than slots: the least recently updated ones are evicted
+    for (uint64_t user = 1; user <= 100; ++user)
+        EXPECT_TRUE(admission.admit("ping", "", user, 0, at(static_cast<int>(user))));
+
+    EXPECT_FALSE(admission.admit("ping", "", 100, 0, at(100)));
+
+    // Once refilled, a bucket carries no information and its slot is reused first
+    EXPECT_TRUE(admission.admit("ping", "", 100, 0, at(1200)));
+    EXPECT_TRUE(admission.admit("ping", "", 1000, 0, at(1200)));
+    EXPECT_FALSE(admission.admit("ping", "", 100, 0, at(1200)));
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "Controllers/CommandRegistrar.h"
+#include "Controllers/TimerCommands.h"
+
+// Stands in for the Discord REST API: counts requests and answers with generated ids
+class MockCommandPublisher final : public ICommandPublisher
+{
+public:
+    void bulkOverwrite(const std::vector<dpp::slashcommand>& commands, Callback_Type onSuccess) override
+    {
+        ++requestCount;
+
+        CommandIds_Type ids;
+        for (const auto& command : commands)
+            ids[command.name] = dpp::snowflake(++lastId);
+
+        onSuccess(ids);
+    }
+
+    size_t requestCount = 0;
+    uint64_t lastId = 1000;
+};
+
+class CommandRegistrarTest : public ::testing::Test
+{
+public:
+    CommandRegistrarTest() = default;
+
+    ~CommandRegistrarTest() = default;
+
+    void TearDown() override
+    {
+        std::filesystem::remove(STATE_PATH);
+    }
+
+protected:
+    std::vector<dpp::slashcommand> createCommands(const std::string& pingDescription = "Ping the bot")
+    {
+        return {
+            dpp::slashcommand("ping", pingDescription, dpp::snowflake(1)),
+            TimerCommands::TIMER.buildCommand(dpp::snowflake(1)),
+        };
+    }
+
+    dpp::slashcommand_t createEvent(const dpp::snowflake& id)
+    {
+        dpp::command_interaction interaction;
+        interaction.id = id;
+        interaction.name = "not the registered name";
+
+        dpp::slashcommand_t event(nullptr, "");
+        event.command.data = interaction;
+        return event;
+    }
+
+protected:
+    static constexpr const char* STATE_PATH = "data/test_commands.txt";
+    MockCommandPublisher publisher;
+};
+
+TEST_F(CommandRegistrarTest, RegisterOnlyWhenChanged)
+{
+    {
+        size_t registered = 0;
+        CommandRouter router;
+        CommandRegistrar registrar(publisher, STATE_PATH);
+
+        EXPECT_TRUE(registrar.registerCommands(createCommands(), router, [&registered]() { ++registered; }));
+        EXPECT_EQ(publisher.requestCount, 1);
+        EXPECT_EQ(registered, 1);
+    }
+
+    // Restart with the same schema: no request, ids restored from the persisted state
+    {
+        bool called = false;
+        CommandRouter router;
+        router.addRoute("ping", [&called](const dpp::slashcommand_t&) { called = true; });
+        CommandRegistrar registrar(publisher, STATE_PATH);
+
+        size_t registered = 0;
+        EXPECT_FALSE(registrar.registerCommands(createCommands(), router, [&registered]() { ++registered; }));
+        EXPECT_EQ(publisher.requestCount, 1);
+        EXPECT_EQ(registered, 1);
+
+        // "ping" was given the first id
+        EXPECT_TRUE(router.dispatch(createEvent(1001)));
+        EXPECT_TRUE(called);
+    }
+
+    // Restart with a changed schema: one bulk overwrite
+    {
+        CommandRouter router;
+        CommandRegistrar registrar(publisher, STATE_PATH);
+
+        EXPECT_TRUE(registrar.registerCommands(createCommands("Ping the bot!"), router));
+        EXPECT_EQ(publisher.requestCount, 2);
+    }
+}
+
+TEST_F(CommandRegistrarTest, BindRegisteredWithoutPushing)
+{
+    CommandRouter router;
+    CommandRegistrar registrar(publisher, STATE_PATH);
+
+    EXPECT_FALSE(registrar.bindRegistered(createCommands(), router));
+
+    registrar.registerCommands(createCommands(), router);
+
+    bool called = false;
+    CommandRouter follower;
+    follower.addRoute("ping", [&called](const dpp::slashcommand_t&) { called = true; });
+
+    EXPECT_TRUE(registrar.bindRegistered(createCommands(), follower));
+    EXPECT_FALSE(registrar.bindRegistered(createCommands("Ping the bot!"), follower));
+    EXPECT_EQ(publisher.requestCount, 1);
+
+    EXPECT_TRUE(follower.dispatch(createEvent(1001)));
+    EXPECT_TRUE(called);
+}
+
+TEST_F(CommandRegistrarTest, HashCommands)
+{
+    auto commands = createCommands();
+    auto reversed = std::vector<dpp::slashcommand>(commands.rbegin(), commands.rend());
+
+    EXPECT_EQ(CommandRegistrar::HashCommands(commands), CommandRegistrar::HashCommands(reversed));
+    EXPECT_NE(CommandRegistrar::HashCommands(commands), CommandRegistrar::HashCommands(createCommands("Other description")));
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "Controllers/CommandRouter.h"
+#include "Controllers/TimerCommands.h"
+
+class CommandRouterTest : public ::testing::Test
+{
+public:
+    CommandRouterTest() = default;
+
+    ~CommandRouterTest() = default;
+
+protected:
+    dpp::slashcommand_t createEvent(const dpp::snowflake& id, const std::string& command, const std::string& subcommand)
+    {
+        dpp::command_interaction interaction;
+        interaction.id = id;
+        interaction.name = command;
+
+        if (!subcommand.empty())
+        {
+            dpp::command_data_option option;
+            option.name = subcommand;
+            option.type = dpp::co_sub_command;
+            interaction.options.push_back(option);
+        }
+
+        dpp::slashcommand_t event(nullptr, "");
+        event.command.data = interaction;
+        return event;
+    }
+
+protected:
+    CommandRouter router;
+    std::string lastRoute;
+};
+
+TEST_F(CommandRouterTest, DispatchByName)
+{
+    router.addRoute("ping", [this](const dpp::slashcommand_t&) { lastRoute = "ping"; });
+    router.addRoute("timer", "set", [this](const dpp::slashcommand_t&) { lastRoute = "timer set"; });
+    router.addRoute("timer", "list", [this](const dpp::slashcommand_t&) { lastRoute = "timer list"; });
+
+    EXPECT_TRUE(router.dispatch(createEvent(1, "ping", "")));
+    EXPECT_EQ(lastRoute, "ping");
+    EXPECT_TRUE(router.dispatch(createEvent(2, "timer", "list")));
+    EXPECT_EQ(lastRoute, "timer list");
+    EXPECT_TRUE(router.dispatch(createEvent(2, "timer", "set")));
+    EXPECT_EQ(lastRoute, "timer set");
+
+    EXPECT_FALSE(router.dispatch(createEvent(2, "timer", "stop")));
+    EXPECT_FALSE(router.dispatch(createEvent(3, "unknown", "")));
+}
+
+TEST_F(CommandRouterTest, DispatchById)
+{
+    router.addRoute("timer", "set", [this](const dpp::slashcommand_t&) { lastRoute = "timer set"; });
+    router.addRoute("timer", "list", [this](const dpp::slashcommand_t&) { lastRoute = "timer list"; });
+    router.bindCommandId("timer", 42);
+
+    // Once bound, the id is enough to find the route
+    EXPECT_TRUE(router.dispatch(createEvent(42, "renamed", "list")));
+    EXPECT_EQ(lastRoute, "timer list");
+    EXPECT_FALSE(router.dispatch(createEvent(42, "renamed", "stop")));
+}
+
+TEST_F(CommandRouterTest, DuplicateRoute)
+{
+    router.addRoute("timer", "set", [](const dpp::slashcommand_t&) {});
+
+    EXPECT_THROW(router.addRoute("timer", "set", [](const dpp::slashcommand_t&) {}), std::invalid_argument);
+    EXPECT_NO_THROW(router.addRoute("timer", "list", [](const dpp::slashcommand_t&) {}));
+    EXPECT_EQ(router.getCommandNames(), std::vector<std::string>{ "timer" });
+}
+
+TEST_F(CommandRouterTest, CoroutineRoutesOrderedByKey)
+{
+    WorkerPool pool(4, 1024);
+    CommandRouter pooledRouter(&pool);
+    std::vector<int> order;
+    int next = 0;
+
+    pooledRouter.addRoute("timer", TimerCommands::STOP, [&](const CommandContext&, const TimerStopParams& params) -> dpp::task<void> {
+        EXPECT_EQ(params.name, "countdown");
+        order.push_back(next++);
+        co_return;
+    }, { .key = &TimerStopParams::name });
+
+    auto event = createEvent(1, "timer", "stop");
+    dpp::command_data_option name;
+    name.name = "name";
+    name.type = dpp::co_string;
+    name.value = std::string("countdown");
+    std::get<dpp::command_interaction>(event.command.data).options[0].options.push_back(name);
+
+    for (int i = 0; i < 50; ++i)
+        EXPECT_TRUE(pooledRouter.dispatch(event));
+
+    while (pool.getPendingCount() > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    ASSERT_EQ(order.size(), 50);
+    for (int i = 0; i < 50; ++i)
+        EXPECT_EQ(order[i], i);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "Controllers/TimerCommands.h"
+
+class CommandSchemaTest : public ::testing::Test
+{
+public:
+    CommandSchemaTest() = default;
+
+    ~CommandSchemaTest() = default;
+
+protected:
+    dpp::command_data_option createOption(const std::string& name, const dpp::command_value& value)
+    {
+        dpp::command_data_option option;
+        option.name = name;
+        option.value = value;
+        return option;
+    }
+};
+
+TEST_F(CommandSchemaTest, BuildCommand)
+{
+    auto command = TimerCommands::TIMER.buildCommand(dpp::snowflake(1));
+
+    EXPECT_EQ(command.name, "timer");
+    ASSERT_EQ(command.options.size(), 6);
+
+    const auto& set = command.options[1];
+    EXPECT_EQ(set.name, "set");
+    EXPECT_EQ(set.type, dpp::co_sub_command);
+    ASSERT_EQ(set.options.size(), 9);
+
+    EXPECT_EQ(set.options[0].name, "name");
+    EXPECT_EQ(set.options[0].type, dpp::co_string);
+    EXPECT_TRUE(set.options[0].required);
+
+    EXPECT_EQ(set.options[6].name, "channel");
+    EXPECT_EQ(set.options[6].type, dpp::co_channel);
+    EXPECT_FALSE(set.options[6].required);
+
+    EXPECT_EQ(set.options[8].name, "edit");
+    EXPECT_EQ(set.options[8].type, dpp::co_boolean);
+    EXPECT_FALSE(set.options[8].required);
+}
+
+TEST_F(CommandSchemaTest, Bind)
+{
+    std::vector<dpp::command_data_option> options = {
+        createOption("channel", dpp::snowflake(42)),
+        createOption("name", std::string("timer")),
+        createOption("interval", std::string("1d")),
+        createOption("unknown", std::string("ignored")),
+    };
+
+    auto params = TimerCommands::SET.bind(options);
+
+    EXPECT_EQ(params.name, "timer");
+    EXPECT_EQ(params.interval, "1d");
+    EXPECT_TRUE(params.message.empty());
+    EXPECT_EQ(params.channel, std::optional<dpp::snowflake>(42));
+    EXPECT_FALSE(params.title.has_value());
+    EXPECT_FALSE(params.image.has_value());
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Discord/CountdownEditor.h"
+
+/**
+ * @brief Sink keeping its requests pending until completed by the test.
+ * 
+ */
+class PendingMessageSink final : public IMessageSink
+{
+public:
+    struct Request
+    {
+        dpp::snowflake channel;
+        // 0 for a create
+        dpp::snowflake message;
+        std::string body;
+        std::function<void(bool success)> complete;
+    };
+
+public:
+    void createMessage(const dpp::snowflake& channel, const std::string& body, Callback_Type onDone = nullptr) override
+    {
+        requests.push_back({ channel, 0, body, [onDone](bool success) { if (onDone) onDone(success); } });
+    }
+
+    void createEditableMessage(const dpp::snowflake& channel, const std::string& body, CreatedCallback_Type onCreated) override
+    {
+        requests.push_back({ channel, 0, body, [this, onCreated](bool success) { onCreated(success ? ++lastMessage : 0); } });
+    }
+
+    void editMessage(const dpp::snowflake& channel, const dpp::snowflake& message, const std::string& body, Callback_Type onDone = nullptr) override
+    {
+        requests.push_back({ channel, message, body, [onDone](bool success) { if (onDone) onDone(success); } });
+    }
+
+    /**
+     * @brief Complete the oldest pending request.
+     */
+    void complete(bool success = true)
+    {
+        auto request = requests.front();
+        requests.erase(requests.begin());
+        request.complete(success);
+    }
+
+public:
+    std::vector<Request> requests;
+    uint64_t lastMessage = 100;
+};
+
+class CountdownEditorTest : public ::testing::Test
+{
+public:
+    CountdownEditorTest() = default;
+
+    ~CountdownEditorTest() = default;
+
+protected:
+    PendingMessageSink sink;
+    CountdownEditor editor{ sink };
+};
+
+TEST_F(CountdownEditorTest, PostsOnceThenEdits)
+{
+    editor.update("countdown", 1, 0, "3 left");
+
+    ASSERT_EQ(sink.requests.size(), 1u);
+    EXPECT_EQ(sink.requests[0].message, 0u);
+
+    sink.complete();
+    EXPECT_EQ(editor.getMessage("countdown"), 101u);
+
+    editor.update("countdown", 1, 0, "2 left");
+
+    ASSERT_EQ(sink.requests.size(), 1u);
+    EXPECT_EQ(sink.requests[0].message, 101u);
+    EXPECT_EQ(sink.requests[0].body, "2 left");
+
+    sink.complete();
+
+    auto stats = editor.getStats();
+    EXPECT_EQ(stats.creates, 1u);
+    EXPECT_EQ(stats.edits, 1u);
+}
+
+TEST_F(CountdownEditorTest, CoalescesPendingUpdates)
+{
+    editor.update("countdown", 1, 50, "5 left");
+
+    // Only the latest update waiting for the edit in flight is sent
+    editor.update("countdown", 1, 50, "4 left");
+    editor.update("countdown", 1, 50, "3 left");
+    editor.update("countdown", 1, 50, "2 left");
+
+    ASSERT_EQ(sink.requests.size(), 1u);
+    EXPECT_EQ(sink.requests[0].message, 50u);
+
+    sink.complete();
+
+    ASSERT_EQ(sink.requests.size(), 1u);
+    EXPECT_EQ(sink.requests[0].body, "2 left");
+
+    sink.complete();
+    EXPECT_TRUE(sink.requests.empty());
+
+    auto stats = editor.getStats();
+    EXPECT_EQ(stats.creates, 0u);
+    EXPECT_EQ(stats.edits, 2u);
+    EXPECT_EQ(stats.coalesced, 2u);
+}
+
+TEST_F(CountdownEditorTest, PostsAgainWhenMessageIsGone)
+{
+    editor.update("countdown", 1, 50, "2 left");
+    sink.complete(false);
+
+    EXPECT_EQ(editor.getMessage("countdown"), 0u);
+
+    editor.update("countdown", 1, 50, "1 left");
+
+    ASSERT_EQ(sink.requests.size(), 1u);
+    EXPECT_EQ(sink.requests[0].message, 0u);
+    sink.complete();
+
+    // Moved to another channel, the countdown gets a message there
+    editor.update("countdown", 2, 0, "0 left");
+
+    ASSERT_EQ(sink.requests.size(), 1u);
+    EXPECT_EQ(sink.requests[0].channel, 2u);
+    EXPECT_EQ(sink.requests[0].message, 0u);
+}
+
+TEST_F(CountdownEditorTest, ForgetIgnoresRequestInFlight)
+{
+    editor.update("countdown", 1, 0, "2 left");
+    editor.update("countdown", 1, 0, "1 left");
+    editor.forget("countdown");
+
+    sink.complete();
+
+    EXPECT_TRUE(sink.requests.empty());
+    EXPECT_EQ(editor.getMessage("countdown"), 0u);
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+#include "Controllers/TimerController.h"
+#include "DAO/TimerDAO.h"
+#include "Firing/FiringEngine.h"
+#include "Simulation/SimulatedGateway.h"
+#include "Simulation/SimulatedRestApi.h"
+#include "Simulation/SimulatedTimerScheduler.h"
+#include "Time/VirtualClock.h"
+
+class FiringEngineTest : public ::testing::Test
+{
+public:
+    FiringEngineTest() = default;
+
+    ~FiringEngineTest() = default;
+
+    void SetUp() override
+    {
+        std::filesystem::remove_all("data/timers");
+        std::filesystem::remove_all("data/guilds");
+
+        auto timerScheduler = std::make_unique<SimulatedTimerScheduler>(&clock);
+        scheduler = timerScheduler.get();
+
+        engine = std::make_unique<FiringEngine>(api.createMessageSink(), std::move(timerScheduler), nullptr, &clock);
+
+        producer = SharedRing::Create(name, 4096);
+        consumer = SharedRing::Open(name);
+        ASSERT_NE(consumer, nullptr);
+    }
+
+    void TearDown() override
+    {
+        engine.reset();
+
+        std::filesystem::remove_all("data/timers");
+        std::filesystem::remove_all("data/guilds");
+    }
+
+protected:
+    TimerDTO createTimer(const std::string& name, int64_t interval = 10)
+    {
+        return TimerDTO(name, dpp::snowflake(4), interval, "{name} fired", clock.now(), clock.now() + std::chrono::hours(1), "", "", dpp::snowflake(3));
+    }
+
+    void push(const TimerMutation& mutation)
+    {
+        std::string record;
+        mutation.encode(record);
+        ASSERT_TRUE(producer->tryPush(record));
+    }
+
+protected:
+    const std::string name = "/discord-timer-bot-test-engine-" + std::to_string(
+#ifdef _WIN32
+        0
+#else
+        getpid()
+#endif
+    );
+    dpp::cluster bot{ "simulated" };
+    VirtualClock clock{ std::chrono::sys_days(std::chrono::year(2024) / 1 / 1) + std::chrono::hours(12) };
+    SimulatedRestApi api;
+    SimulatedTimerScheduler* scheduler = nullptr;
+    std::unique_ptr<FiringEngine> engine;
+    std::unique_ptr<SharedRing> producer;
+    std::unique_ptr<SharedRing> consumer;
+};
+
+TEST_F(FiringEngineTest, MutationRoundTrip)
+{
+    TimerMutation upsert{ TimerMutation::Type::Upsert, "daily", "Europe/Paris", createTimer("daily") };
+    upsert.timer.setTitle("Title");
+    upsert.timer.setImageURL("https://example.com/image.png");
+
+    std::string record;
+    upsert.encode(record);
+    auto decoded = TimerMutation::Decode(record);
+
+    EXPECT_EQ(decoded.type, TimerMutation::Type::Upsert);
+    EXPECT_EQ(decoded.id, "daily");
+    EXPECT_EQ(decoded.zone, "Europe/Paris");
+    EXPECT_EQ(decoded.timer.getMessage(), "{name} fired");
+    EXPECT_EQ(decoded.timer.getTitle(), "Title");
+    EXPECT_EQ(decoded.timer.getImageURL(), "https://example.com/image.png");
+    EXPECT_EQ(decoded.timer.getEnd(), upsert.timer.getEnd());
+    EXPECT_EQ(decoded.timer.getGuild(), dpp::snowflake(3));
+
+    EXPECT_THROW(TimerMutation::Decode(std::string_view(record).substr(0, record.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(TimerMutation::Decode(record + "x"), std::invalid_argument);
+
+    TimerMutation remove{ TimerMutation::Type::Remove, "daily" };
+    remove.encode(record);
+    EXPECT_EQ(TimerMutation::Decode(record).id, "daily");
+
+    TimerMutation created{ TimerMutation::Type::MessageCreated, "daily" };
+    created.message = dpp::snowflake(42);
+    created.encode(record);
+    EXPECT_EQ(TimerMutation::Decode(record).type, TimerMutation::Type::MessageCreated);
+    EXPECT_EQ(TimerMutation::Decode(record).message, dpp::snowflake(42));
+}
+
+TEST_F(FiringEngineTest, FiresMutationsFromTheRing)
+{
+    push({ TimerMutation::Type::Upsert, "daily", "", createTimer("daily") });
+
+    EXPECT_EQ(engine->poll(*consumer), 1);
+    EXPECT_EQ(engine->getTimerCount(), 1);
+
+    // On the next interval boundary, then every interval
+    scheduler->advance(10);
+    EXPECT_EQ(api.getStats().messages, 1);
+    scheduler->advance(20);
+    EXPECT_EQ(api.getStats().messages, 3);
+
+    // Restarted with the new interval, from the same start
+    auto updated = createTimer("daily", 60);
+    updated.setStart(clock.now() - std::chrono::seconds(30));
+
+    push({ TimerMutation::Type::Upsert, "daily", "", updated });
+    EXPECT_EQ(engine->poll(*consumer), 1);
+
+    scheduler->advance(30);
+    EXPECT_EQ(api.getStats().messages, 4);
+
+    push({ TimerMutation::Type::Remove, "daily" });
+    EXPECT_EQ(engine->poll(*consumer), 1);
+    EXPECT_EQ(engine->getTimerCount(), 0);
+
+    scheduler->advance(120);
+    EXPECT_EQ(api.getStats().messages, 4);
+}
+
+TEST_F(FiringEngineTest, ReloadsPersistedTimersOnOverflow)
+{
+    TimerDAO().add("persisted", createTimer("persisted"));
+
+    std::string record;
+    TimerMutation{ TimerMutation::Type::Remove, "unknown" }.encode(record);
+
+    while (producer->tryPush(record))
+        ;
+
+    EXPECT_GT(engine->poll(*consumer), 0);
+    EXPECT_EQ(engine->getTimerCount(), 1);
+    EXPECT_FALSE(consumer->takeOverflow());
+
+    scheduler->advance(10);
+    EXPECT_EQ(api.getStats().messages, 1);
+}
+
+TEST_F(FiringEngineTest, CommandProcessSendsMutations)
+{
+    // The command process runs on a clock of its own, only the engine fires
+    VirtualClock commandClock{ clock.now() };
+    SimulatedRestApi commandApi;
+    auto commandScheduler = std::make_unique<SimulatedTimerScheduler>(&commandClock);
+    auto* commandSchedulerPointer = commandScheduler.get();
+
+    TimerController controller(bot, commandApi.createMessageSink(), std::move(commandScheduler), nullptr, &commandClock);
+    controller.setFiringRing(producer.get());
+    controller.init();
+
+    CommandRouter router{ nullptr, nullptr, &commandApi };
+    controller.registerRoutes(router);
+    SimulatedGateway gateway{ router, commandApi };
+    SimulatedGateway::Invoker invoker = { 1, 2, 3 };
+
+    gateway.sendCommand(invoker, "timer", "set", {
+        { "name", std::string("daily") },
+        { "interval", std::string("10s") },
+        { "message", std::string("Hello") },
+        { "end", TimerController::GetFormattedTime(clock.now() + std::chrono::minutes(1)) },
+    });
+
+    EXPECT_EQ(engine->poll(*consumer), 1);
+
+    scheduler->advance(30);
+    EXPECT_EQ(api.getStats().messages, 3);
+    EXPECT_EQ(commandApi.getStats().messages, 0);
+
+    gateway.sendCommand(invoker, "timer", "stop", { { "name", std::string("daily") } });
+
+    EXPECT_EQ(engine->poll(*consumer), 1);
+    EXPECT_EQ(engine->getTimerCount(), 0);
+    EXPECT_EQ(commandSchedulerPointer->getTimerCount(), 0);
+}
+
+TEST_F(FiringEngineTest, CommandProcessDeletesEndedTimers)
+{
+    TimerDAO().add("ending", createTimer("ending"));
+
+    VirtualClock commandClock{ clock.now() };
+    SimulatedRestApi commandApi;
+    auto commandScheduler = std::make_unique<SimulatedTimerScheduler>(&commandClock);
+    auto* commandSchedulerPointer = commandScheduler.get();
+
+    TimerController controller(bot, commandApi.createMessageSink(), std::move(commandScheduler), nullptr, &commandClock);
+    controller.setFiringRing(producer.get());
+    controller.init();
+
+    EXPECT_EQ(commandSchedulerPointer->getTimerCount(), 1);
+
+    // Not fired, only deleted once over
+    commandSchedulerPointer->advance(2 * 60 * 60);
+
+    EXPECT_EQ(commandSchedulerPointer->getTimerCount(), 0);
+    EXPECT_EQ(commandApi.getStats().messages, 0);
+    EXPECT_FALSE(std::filesystem::exists("data/timers/ending.txt"));
+}
+
+TEST_F(FiringEngineTest, CommandProcessStoresCountdownMessages)
+{
+    VirtualClock commandClock{ clock.now() };
+    SimulatedRestApi commandApi;
+
+    TimerController controller(bot, commandApi.createMessageSink(), std::make_unique<SimulatedTimerScheduler>(&commandClock), nullptr, &commandClock);
+    controller.setFiringRing(producer.get());
+    controller.init();
+
+    // Created by the engine, opened by the command process
+    auto reports = SharedRing::Create(name + "-reports", 4096);
+    auto reportsConsumer = SharedRing::Open(name + "-reports");
+    ASSERT_NE(reportsConsumer, nullptr);
+    engine->setReportRing(reports.get());
+
+    CommandRouter router{ nullptr, nullptr, &commandApi };
+    controller.registerRoutes(router);
+    SimulatedGateway gateway{ router, commandApi };
+    SimulatedGateway::Invoker invoker = { 1, 2, 3 };
+
+    gateway.sendCommand(invoker, "timer", "set", {
+        { "name", std::string("countdown") },
+        { "interval", std::string("10s") },
+        { "message", std::string("{rem:seconds} seconds left") },
+        { "end", TimerController::GetFormattedTime(clock.now() + std::chrono::hours(1)) },
+        { "edit", true },
+    });
+
+    EXPECT_EQ(engine->poll(*consumer), 1);
+
+    // Posted by the first fire, sent back by the next one
+    scheduler->advance(20);
+    EXPECT_EQ(api.getStats().messages, 1);
+    EXPECT_EQ(controller.applyFiringReports(*reportsConsumer), 1);
+
+    scheduler->advance(10);
+    EXPECT_EQ(controller.applyFiringReports(*reportsConsumer), 0);
+
+    TimerDAO stored;
+    stored.loadTimers();
+    EXPECT_NE(stored.findOne("countdown").getMessageID(), 0u);
+
+    engine->setReportRing(nullptr);
+}
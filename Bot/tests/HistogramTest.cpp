@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "Metrics/Histogram.h"
+
+class HistogramTest : public ::testing::Test
+{
+public:
+    HistogramTest() = default;
+
+    ~HistogramTest() = default;
+
+protected:
+    Histogram histogram;
+};
+
+TEST_F(HistogramTest, BucketsCoverEveryValue)
+{
+    for (uint64_t value : { uint64_t(0), uint64_t(1), uint64_t(63), uint64_t(64), uint64_t(65), uint64_t(1000), uint64_t(123456789), Histogram::MAX_VALUE })
+    {
+        size_t index = Histogram::GetBucketIndex(value);
+
+        ASSERT_LT(index, Histogram::BUCKET_COUNT);
+        EXPECT_GE(Histogram::GetBucketUpperBound(index), value);
+
+        if (index > 0)
+        {
+            EXPECT_LT(Histogram::GetBucketUpperBound(index - 1), value);
+        }
+    }
+
+    EXPECT_EQ(Histogram::GetBucketIndex(Histogram::MAX_VALUE), Histogram::BUCKET_COUNT - 1);
+}
+
+TEST_F(HistogramTest, QuantilesWithinPrecision)
+{
+    for (uint64_t value = 1; value <= 100'000; ++value)
+        histogram.record(value * 1000);
+
+    auto snapshot = histogram.snapshot();
+
+    EXPECT_EQ(snapshot.getCount(), 100'000);
+    EXPECT_EQ(snapshot.getMax(), 100'000'000);
+    EXPECT_NEAR(double(snapshot.getQuantile(0.5)), 50'000'000.0, 50'000'000.0 * 0.04);
+    EXPECT_NEAR(double(snapshot.getQuantile(0.99)), 99'000'000.0, 99'000'000.0 * 0.04);
+    EXPECT_EQ(snapshot.getQuantile(1.0), 100'000'000);
+}
+
+TEST_F(HistogramTest, DurationsAndClamping)
+{
+    histogram.record(std::chrono::milliseconds(3));
+    histogram.record(std::chrono::milliseconds(-3));
+    histogram.record(std::chrono::hours(24));
+
+    auto snapshot = histogram.snapshot();
+
+    EXPECT_EQ(snapshot.getCount(), 3);
+    EXPECT_EQ(snapshot.getQuantile(0.0), 0);
+    EXPECT_EQ(snapshot.getMax(), Histogram::MAX_VALUE);
+    EXPECT_EQ(Histogram::Snapshot().getQuantile(0.5), 0);
+}
+
+TEST_F(HistogramTest, ConcurrentRecordsAreCounted)
+{
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([this]() {
+            for (int i = 0; i < 10'000; ++i)
+                histogram.record(uint64_t(i));
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(histogram.snapshot().getCount(), 40'000);
+}
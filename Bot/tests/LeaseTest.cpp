@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#ifndef _WIN32
+    #include <signal.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+#include "Cluster/Lease.h"
+#include "Time/VirtualClock.h"
+
+class LeaseTest : public ::testing::Test
+{
+public:
+    LeaseTest() = default;
+
+    ~LeaseTest() = default;
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all("data/test_leases");
+    }
+
+protected:
+    const std::vector<std::filesystem::path> paths = { "data/test_leases/shard-0.lock", "data/test_leases/shard-1.lock" };
+    VirtualClock clock{ std::chrono::sys_days(std::chrono::year(2024) / 1 / 1) };
+};
+
+TEST_F(LeaseTest, IsExclusive)
+{
+    Lease primary(paths, std::chrono::seconds(1), &clock);
+    Lease standby(paths, std::chrono::seconds(1), &clock);
+
+    EXPECT_TRUE(primary.tryAcquire());
+    EXPECT_FALSE(standby.tryAcquire());
+    EXPECT_FALSE(standby.isHeld());
+
+    // Renewed in time, the lease is kept
+    clock.advance(std::chrono::milliseconds(600));
+    EXPECT_TRUE(primary.renew());
+    clock.advance(std::chrono::milliseconds(600));
+    EXPECT_FALSE(standby.tryAcquire());
+
+    primary.release();
+
+    EXPECT_TRUE(standby.tryAcquire());
+    EXPECT_TRUE(standby.renew());
+    EXPECT_FALSE(primary.renew());
+}
+
+TEST_F(LeaseTest, StaleHeartbeatIsTakenOver)
+{
+    Lease primary(paths, std::chrono::seconds(1), &clock);
+    Lease standby(paths, std::chrono::seconds(1), &clock);
+
+    ASSERT_TRUE(primary.tryAcquire());
+
+    // The primary is stuck: its locks are held, but its heartbeat lapses
+    clock.advance(std::chrono::milliseconds(1500));
+
+    EXPECT_TRUE(standby.tryAcquire());
+    EXPECT_TRUE(standby.renew());
+
+    // The primary steps down on its next renewal, its locks then go to the standby
+    EXPECT_FALSE(primary.renew());
+    EXPECT_FALSE(primary.isHeld());
+    EXPECT_TRUE(standby.renew());
+
+    Lease third(paths, std::chrono::seconds(1), &clock);
+    EXPECT_FALSE(third.tryAcquire());
+}
+
+#ifndef _WIN32
+TEST_F(LeaseTest, StandbyTakesOverFromKilledProcess)
+{
+    using namespace std::chrono;
+
+    int ready[2];
+    ASSERT_EQ(pipe(ready), 0);
+
+    pid_t primary = fork();
+    ASSERT_GE(primary, 0);
+
+    if (primary == 0)
+    {
+        // The primary holds the lease and renews it until killed
+        Lease lease(paths, milliseconds(1000));
+        char acquired = lease.tryAcquire() ? 1 : 0;
+
+        [[maybe_unused]] auto written = write(ready[1], &acquired, 1);
+
+        for (;;)
+        {
+            std::this_thread::sleep_for(milliseconds(250));
+            lease.renew();
+        }
+    }
+
+    char acquired = 0;
+    ASSERT_EQ(read(ready[0], &acquired, 1), 1);
+    ASSERT_EQ(acquired, 1);
+
+    close(ready[0]);
+    close(ready[1]);
+
+    Lease standby(paths, milliseconds(1000));
+    EXPECT_FALSE(standby.tryAcquire());
+
+    kill(primary, SIGKILL);
+    auto killed = steady_clock::now();
+
+    // Polled as the standby process does
+    while (!standby.tryAcquire() && steady_clock::now() - killed < seconds(5))
+        std::this_thread::sleep_for(milliseconds(10));
+
+    auto takeover = steady_clock::now() - killed;
+    waitpid(primary, nullptr, 0);
+
+    EXPECT_TRUE(standby.isHeld());
+    EXPECT_LT(takeover, seconds(1));
+}
+#endif
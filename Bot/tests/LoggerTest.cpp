@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "Logging/Logger.h"
+
+class LoggerTest : public ::testing::Test
+{
+public:
+    LoggerTest() = default;
+
+    ~LoggerTest() = default;
+
+    void SetUp() override
+    {
+        Logger::Start(dpp::ll_info, [this](std::string_view lines) {
+            std::lock_guard lock(m_Mutex);
+            m_Output += lines;
+        });
+    }
+
+    void TearDown() override
+    {
+        Logger::Stop();
+    }
+
+protected:
+    std::string flush()
+    {
+        Logger::Flush();
+
+        std::lock_guard lock(m_Mutex);
+        return std::exchange(m_Output, "");
+    }
+
+private:
+    std::mutex m_Mutex;
+    std::string m_Output;
+};
+
+TEST_F(LoggerTest, WritesStructuredFields)
+{
+    std::string id = "abc";
+    std::string longMessage(Logger::TEXT_CAPACITY + 10, 'x');
+
+    Logger::Log(dpp::ll_info, "Timer triggered", LogField("id", id), LogField("channel", dpp::snowflake(42)), LogField("count", -3));
+    Logger::Log(dpp::ll_warning, "Could not update timer", LogField("error", "not \"found\""), LogField("message", longMessage));
+
+    auto output = flush();
+
+    EXPECT_NE(output.find("] INFO: Timer triggered id=abc channel=42 count=-3\n"), std::string::npos);
+    EXPECT_NE(output.find("] WARN: Could not update timer error=\"not \\\"found\\\"\" message=" + longMessage + "\n"), std::string::npos);
+    EXPECT_LT(output.find("Timer triggered"), output.find("Could not update timer"));
+}
+
+TEST_F(LoggerTest, FilteredLevelsAreNotWritten)
+{
+    EXPECT_FALSE(Logger::IsEnabled(dpp::ll_debug));
+
+    Logger::Log(dpp::ll_debug, "Hidden");
+    Logger::Write(dpp::ll_info, "Shown\nover two lines");
+
+    auto output = flush();
+
+    EXPECT_EQ(output.find("Hidden"), std::string::npos);
+    EXPECT_NE(output.find("] INFO: Shown\nover two lines\n"), std::string::npos);
+}
+
+TEST_F(LoggerTest, WritesEntriesOfEveryThread)
+{
+    std::thread worker([]() {
+        for (int i = 0; i < 10; ++i)
+            Logger::Log(dpp::ll_info, "From worker", LogField("index", i));
+    });
+    worker.join();
+
+    Logger::Log(dpp::ll_info, "From main");
+
+    auto output = flush();
+
+    EXPECT_NE(output.find("From worker index=9\n"), std::string::npos);
+    EXPECT_NE(output.find("From main\n"), std::string::npos);
+}
+
+TEST_F(LoggerTest, FullRingDropsAndReports)
+{
+    Logger::Flush();
+    uint64_t dropped = Logger::GetDroppedCount();
+
+    // The background thread is not fast enough to drain these between two entries
+    std::thread producer([]() {
+        for (size_t i = 0; i < Logger::ENTRIES_PER_THREAD * 4; ++i)
+            Logger::Log(dpp::ll_info, "Burst", LogField("index", i));
+    });
+    producer.join();
+
+    auto output = flush();
+
+    EXPECT_GT(Logger::GetDroppedCount(), dropped);
+    EXPECT_NE(output.find("WARN: Log entries dropped, the ring of their thread was full count="), std::string::npos);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "Metrics/MetricsRegistry.h"
+#include "Metrics/PrometheusExporter.h"
+
+// The scrape client is written against POSIX sockets
+#ifndef _WIN32
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+class MetricsRegistryTest : public ::testing::Test
+{
+public:
+    MetricsRegistryTest() = default;
+
+    ~MetricsRegistryTest() = default;
+
+#ifndef _WIN32
+    std::string scrape(uint16_t port, const std::string& path)
+    {
+        int client = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+
+        if (connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close(client);
+            return "";
+        }
+
+        std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        send(client, request.data(), request.size(), 0);
+
+        std::string response;
+        char buffer[512];
+        ssize_t count;
+
+        while ((count = recv(client, buffer, sizeof(buffer), 0)) > 0)
+            response.append(buffer, size_t(count));
+
+        close(client);
+        return response;
+    }
+#endif
+
+protected:
+    MetricsRegistry registry;
+};
+
+TEST_F(MetricsRegistryTest, SameNameAndLabelsShareInstrument)
+{
+    auto labels = MetricsRegistry::Labels({ { "command", "timer" } });
+
+    EXPECT_EQ(&registry.counter("requests", "Requests.", labels), &registry.counter("requests", "Requests.", labels));
+    EXPECT_NE(&registry.counter("requests", "Requests.", labels), &registry.counter("requests", "Requests."));
+    EXPECT_THROW(registry.gauge("requests", "Requests."), std::invalid_argument);
+    EXPECT_THROW(registry.addCollector("computed", "Computed.", MetricsRegistry::Type::Histogram, nullptr), std::invalid_argument);
+}
+
+TEST_F(MetricsRegistryTest, LabelsAreEscaped)
+{
+    EXPECT_EQ(MetricsRegistry::Labels({ { "name", "a\"b\\c\nd" }, { "x", "" } }), "name=\"a\\\"b\\\\c\\nd\",x=\"\"");
+}
+
+TEST_F(MetricsRegistryTest, RenderPrometheus)
+{
+    registry.counter("bot_sent_total", "Sent messages.").increment(3);
+    registry.gauge("bot_timers_active", "Running timers.").set(7);
+    registry.histogram("bot_duration_seconds", "Durations.", MetricsRegistry::Labels({ { "command", "ping" } })).record(std::chrono::milliseconds(2));
+    registry.addCollector("bot_cache_total", "Cache lookups.", MetricsRegistry::Type::Counter, []() {
+        return std::vector<MetricsRegistry::Sample>{ { "result=\"hit\"", 5 } };
+    });
+
+    auto text = registry.renderPrometheus();
+
+    EXPECT_NE(text.find("# TYPE bot_sent_total counter\nbot_sent_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE bot_timers_active gauge\nbot_timers_active 7\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE bot_duration_seconds summary\n"), std::string::npos);
+    EXPECT_NE(text.find("bot_duration_seconds{command=\"ping\",quantile=\"0.5\"} 0.002\n"), std::string::npos);
+    EXPECT_NE(text.find("bot_duration_seconds_count{command=\"ping\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("bot_cache_total{result=\"hit\"} 5\n"), std::string::npos);
+
+    auto summary = registry.renderSummary();
+
+    EXPECT_NE(summary.find("bot_duration_seconds{command=\"ping\"} n=1 p50=2.0ms"), std::string::npos);
+    EXPECT_NE(summary.find("bot_timers_active 7\n"), std::string::npos);
+}
+
+#ifndef _WIN32
+TEST_F(MetricsRegistryTest, ExporterServesMetrics)
+{
+    registry.gauge("bot_timers_active", "Running timers.").set(42);
+
+    PrometheusExporter exporter(registry, 0);
+
+    auto response = scrape(exporter.getPort(), "/metrics");
+
+    EXPECT_TRUE(response.starts_with("HTTP/1.1 200 OK\r\n"));
+    EXPECT_NE(response.find("\r\n\r\n# HELP bot_timers_active Running timers.\n"), std::string::npos);
+    EXPECT_NE(response.find("bot_timers_active 42\n"), std::string::npos);
+
+    EXPECT_TRUE(scrape(exporter.getPort(), "/").starts_with("HTTP/1.1 404 Not Found\r\n"));
+}
+#endif
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "Controllers/ResponseCache.h"
+
+class ResponseCacheTest : public ::testing::Test
+{
+public:
+    ResponseCacheTest() = default;
+
+    ~ResponseCacheTest() = default;
+
+protected:
+    ResponseCache cache;
+};
+
+TEST_F(ResponseCacheTest, HitOnlyForSameVersion)
+{
+    EXPECT_EQ(cache.find(1, 1), nullptr);
+
+    cache.store(1, 1, std::make_shared<const std::string>("Running timers: a"));
+
+    EXPECT_EQ(*cache.find(1, 1), "Running timers: a");
+    EXPECT_EQ(cache.find(1, 2), nullptr);
+    EXPECT_EQ(cache.find(2, 1), nullptr);
+
+    cache.store(1, 2, std::make_shared<const std::string>("Running timers: a, b"));
+
+    EXPECT_EQ(*cache.find(1, 2), "Running timers: a, b");
+    EXPECT_EQ(cache.find(1, 1), nullptr);
+
+    auto stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 4);
+}
+
+TEST_F(ResponseCacheTest, OlderVersionDoesNotReplaceNewer)
+{
+    cache.store(1, 3, std::make_shared<const std::string>("new"));
+    cache.store(1, 2, std::make_shared<const std::string>("old"));
+
+    EXPECT_EQ(*cache.find(1, 3), "new");
+}
+
+TEST_F(ResponseCacheTest, HitSharesResponse)
+{
+    auto response = std::make_shared<const std::string>("Running timers: a");
+    cache.store(1, 1, response);
+
+    EXPECT_EQ(cache.find(1, 1), response);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "Cluster/FileLock.h"
+#include "Cluster/ShardMap.h"
+#include "DAO/TimerDAO.h"
+
+class ShardMapTest : public ::testing::Test
+{
+public:
+    ShardMapTest() = default;
+
+    ~ShardMapTest() = default;
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all("data/timers");
+        std::filesystem::remove_all("data/shards");
+        std::filesystem::remove_all("data/test_locks");
+    }
+
+protected:
+    // A guild routed to the given shard
+    static dpp::snowflake guildOfShard(uint64_t shard, uint64_t index = 0)
+    {
+        return dpp::snowflake(((index * 16 + shard) << 22) | 12345);
+    }
+
+    static TimerDTO createTimer(const std::string& name, const dpp::snowflake& guild)
+    {
+        auto now = std::chrono::system_clock::now();
+        return TimerDTO(name, dpp::snowflake(1), 60, "message", now, now + std::chrono::hours(1), "", "", guild);
+    }
+};
+
+TEST_F(ShardMapTest, EveryShardHasOneOwner)
+{
+    std::vector<ShardMap> clusters;
+
+    for (uint32_t cluster = 0; cluster < 3; ++cluster)
+        clusters.emplace_back(8, cluster, 3);
+
+    for (uint32_t shard = 0; shard < 8; ++shard)
+    {
+        size_t owners = 0;
+
+        for (const auto& cluster : clusters)
+            owners += cluster.ownsShard(shard) ? 1 : 0;
+
+        EXPECT_EQ(owners, 1);
+    }
+
+    EXPECT_EQ(clusters[1].getOwnedShards(), std::vector<uint32_t>({ 1, 4, 7 }));
+    EXPECT_EQ(ShardMap::GetShard(guildOfShard(5), 8), 5);
+    EXPECT_TRUE(clusters[2].ownsGuild(guildOfShard(5)));
+    EXPECT_TRUE(clusters[0].ownsGuild(0));
+}
+
+TEST_F(ShardMapTest, FromArguments)
+{
+    const char* arguments[] = { "Bot", "--shards=4", "--cluster=1", "--clusters=2" };
+    auto shards = ShardMap::FromArguments(4, arguments);
+
+    EXPECT_EQ(shards.getShardCount(), 4);
+    EXPECT_EQ(shards.getClusterId(), 1);
+    EXPECT_EQ(shards.getClusterCount(), 2);
+    EXPECT_FALSE(shards.isLeader());
+
+    const char* defaults[] = { "Bot" };
+    EXPECT_FALSE(ShardMap::FromArguments(1, defaults).isPartitioned());
+
+    const char* invalid[] = { "Bot", "--shards=two" };
+    EXPECT_THROW(ShardMap::FromArguments(2, invalid), std::invalid_argument);
+
+    const char* unknown[] = { "Bot", "--verbose" };
+    EXPECT_THROW(ShardMap::FromArguments(2, unknown), std::invalid_argument);
+
+    EXPECT_THROW(ShardMap(2, 2, 2), std::invalid_argument);
+    EXPECT_THROW(ShardMap(1, 0, 2), std::invalid_argument);
+}
+
+TEST_F(ShardMapTest, ClustersLoadOnlyTheirTimers)
+{
+    {
+        ShardMap shards(4, 0, 2);
+        TimerDAO dao(shards);
+
+        dao.add("a", createTimer("a", guildOfShard(0)));
+        dao.add("b", createTimer("b", guildOfShard(2)));
+    }
+
+    {
+        ShardMap shards(4, 1, 2);
+        TimerDAO dao(shards);
+
+        dao.add("c", createTimer("c", guildOfShard(1)));
+    }
+
+    EXPECT_TRUE(std::filesystem::exists("data/shards/2/timers/b.txt"));
+    EXPECT_TRUE(std::filesystem::exists("data/shards/1/timers/c.txt"));
+
+    TimerDAO first(ShardMap(4, 0, 2));
+    first.loadTimers();
+
+    TimerDAO second(ShardMap(4, 1, 2));
+    second.loadTimers();
+
+    EXPECT_EQ(first.getDataMap().size(), 2);
+    EXPECT_TRUE(first.idExists("b"));
+    EXPECT_EQ(second.getDataMap().size(), 1);
+    EXPECT_TRUE(second.idExists("c"));
+}
+
+TEST_F(ShardMapTest, UnpartitionedTimersAreMigrated)
+{
+    {
+        TimerDAO dao;
+
+        dao.add("a", createTimer("a", guildOfShard(0)));
+        dao.add("b", createTimer("b", guildOfShard(1)));
+    }
+
+    TimerDAO first(ShardMap(2, 0, 2));
+    first.loadTimers();
+
+    EXPECT_TRUE(first.idExists("a"));
+    EXPECT_FALSE(first.idExists("b"));
+    EXPECT_TRUE(std::filesystem::exists("data/shards/0/timers/a.txt"));
+    EXPECT_TRUE(std::filesystem::exists("data/timers/b.txt"));
+
+    TimerDAO second(ShardMap(2, 1, 2));
+    second.loadTimers();
+
+    EXPECT_TRUE(second.idExists("b"));
+    EXPECT_FALSE(std::filesystem::exists("data/timers/b.txt"));
+}
+
+TEST_F(ShardMapTest, LayoutMustMatch)
+{
+    EXPECT_NO_THROW(ShardMap(4, 0, 2).checkLayout());
+    EXPECT_NO_THROW(ShardMap(4, 1, 2).checkLayout());
+    EXPECT_THROW(ShardMap(8, 0, 2).checkLayout(), std::runtime_error);
+}
+
+TEST_F(ShardMapTest, FileLockIsExclusive)
+{
+    FileLock first("data/test_locks/shard-0.lock");
+    FileLock second("data/test_locks/shard-0.lock");
+
+    EXPECT_TRUE(first.tryLock());
+    EXPECT_FALSE(second.tryLock());
+
+    first.unlock();
+
+    EXPECT_TRUE(second.tryLock());
+    EXPECT_TRUE(second.isLocked());
+}
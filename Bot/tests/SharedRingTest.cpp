@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+#include "Cluster/SharedRing.h"
+
+class SharedRingTest : public ::testing::Test
+{
+public:
+    SharedRingTest() = default;
+
+    ~SharedRingTest() = default;
+
+protected:
+    // One name per test process, tests of concurrent runs do not share rings
+    const std::string name = "/discord-timer-bot-test-" + std::to_string(
+#ifdef _WIN32
+        0
+#else
+        getpid()
+#endif
+    );
+};
+
+TEST_F(SharedRingTest, RecordsKeepTheirOrderAcrossWraps)
+{
+    auto producer = SharedRing::Create(name, 256);
+    auto consumer = SharedRing::Open(name);
+    ASSERT_NE(consumer, nullptr);
+    EXPECT_EQ(consumer->getCapacity(), 256);
+
+    std::string record;
+    EXPECT_FALSE(consumer->tryPop(record));
+
+    // Sizes not dividing the capacity, so that records wrap at every offset
+    for (size_t i = 0; i < 200; ++i)
+    {
+        auto pushed = std::string(i % 37, char('a' + i % 26)) + std::to_string(i);
+        ASSERT_TRUE(producer->tryPush(pushed));
+        ASSERT_TRUE(consumer->tryPop(record));
+        EXPECT_EQ(record, pushed);
+    }
+
+    EXPECT_FALSE(consumer->tryPop(record));
+    EXPECT_FALSE(consumer->takeOverflow());
+    EXPECT_THROW(producer->tryPush(std::string(200, 'x')), std::invalid_argument);
+}
+
+TEST_F(SharedRingTest, FullRingDropsAndFlags)
+{
+    auto producer = SharedRing::Create(name, 64);
+    auto consumer = SharedRing::Open(name);
+    ASSERT_NE(consumer, nullptr);
+
+    // 16 bytes each
+    size_t pushed = 0;
+    while (producer->tryPush("record-" + std::to_string(pushed)))
+        ++pushed;
+
+    EXPECT_EQ(pushed, 4);
+    EXPECT_TRUE(consumer->takeOverflow());
+    EXPECT_FALSE(consumer->takeOverflow());
+
+    std::string record;
+    ASSERT_TRUE(consumer->tryPop(record));
+    EXPECT_EQ(record, "record-0");
+    EXPECT_TRUE(producer->tryPush("record-4"));
+}
+
+TEST_F(SharedRingTest, ClosedWhenTheProducerIsDestroyed)
+{
+    EXPECT_EQ(SharedRing::Open(name), nullptr);
+
+    auto producer = SharedRing::Create(name);
+    auto consumer = SharedRing::Open(name);
+    ASSERT_NE(consumer, nullptr);
+
+    producer->tryPush("last");
+    EXPECT_FALSE(consumer->isClosed());
+
+    producer.reset();
+
+    // The records left can still be taken
+    std::string record;
+    EXPECT_TRUE(consumer->isClosed());
+    EXPECT_TRUE(consumer->tryPop(record));
+    EXPECT_EQ(record, "last");
+    EXPECT_EQ(SharedRing::Open(name), nullptr);
+}
+
+#ifndef _WIN32
+TEST_F(SharedRingTest, CrossesProcesses)
+{
+    constexpr size_t COUNT = 100000;
+
+    auto producer = SharedRing::Create(name, 4096);
+
+    pid_t consumerProcess = fork();
+    ASSERT_GE(consumerProcess, 0);
+
+    if (consumerProcess == 0)
+    {
+        // Checks the order, exits with the number of errors
+        auto consumer = SharedRing::Open(name);
+        std::string record;
+        size_t expected = 0;
+        int errors = consumer == nullptr ? 1 : 0;
+
+        while (consumer != nullptr && expected < COUNT)
+        {
+            if (!consumer->tryPop(record))
+                continue;
+
+            if (record != std::to_string(expected))
+                ++errors;
+
+            ++expected;
+        }
+
+        _exit(std::min(errors, 100));
+    }
+
+    // Retried when full, the consumer drains concurrently
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        while (!producer->tryPush(std::to_string(i)))
+            ;
+    }
+
+    int status = 0;
+    waitpid(consumerProcess, &status, 0);
+
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+#endif
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Controllers/Controller.h"
+#include "Metrics/StartupProfile.h"
+
+/**
+ * @brief Controller whose initialization waits for every other one to have started.
+ *
+ */
+class RendezvousController : public Controller
+{
+public:
+    RendezvousController(dpp::cluster& bot, std::atomic<int>& started, int expected, bool fail = false)
+        : Controller(bot), m_Started(started), m_Expected(expected), m_Fail(fail)
+    {}
+
+protected:
+    void onInit(StartupProfile* profile) override
+    {
+        StartupPhase phase(profile, "rendezvous");
+
+        ++m_Started;
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (m_Started < m_Expected && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+
+        if (m_Started < m_Expected)
+            throw std::runtime_error("Controllers were initialized one after the other");
+
+        if (m_Fail)
+            throw std::runtime_error("Initialization failed");
+    }
+
+    std::vector<dpp::slashcommand> onCreateCommands() const override { return {}; }
+
+    void onRegisterRoutes(CommandRouter& router) override {}
+
+private:
+    std::atomic<int>& m_Started;
+    int m_Expected;
+    bool m_Fail;
+};
+
+class StartupProfileTest : public ::testing::Test
+{
+public:
+    StartupProfileTest() = default;
+
+    ~StartupProfileTest() = default;
+
+protected:
+    dpp::cluster bot{ "token" };
+    StartupProfile profile;
+};
+
+TEST_F(StartupProfileTest, PhasesAreOrderedByStart)
+{
+    auto origin = StartupProfile::Clock_Type::now();
+
+    profile.record("second", origin + std::chrono::milliseconds(20), origin + std::chrono::milliseconds(50));
+    profile.record("first", origin + std::chrono::milliseconds(10), origin + std::chrono::milliseconds(30));
+
+    auto phases = profile.getPhases();
+
+    ASSERT_EQ(phases.size(), 2);
+    EXPECT_EQ(phases[0].name, "first");
+    EXPECT_EQ(phases[0].duration, std::chrono::milliseconds(20));
+    EXPECT_EQ(phases[1].name, "second");
+    EXPECT_EQ(phases[1].duration, std::chrono::milliseconds(30));
+
+    std::string report = profile.render();
+
+    EXPECT_LT(report.find("phase"), report.find("first"));
+    EXPECT_LT(report.find("first"), report.find("second"));
+}
+
+TEST_F(StartupProfileTest, ControllersInitializeInParallel)
+{
+    std::atomic<int> started = 0;
+
+    std::vector<std::unique_ptr<Controller>> controllers;
+    controllers.push_back(std::make_unique<RendezvousController>(bot, started, 3));
+    controllers.push_back(std::make_unique<RendezvousController>(bot, started, 3));
+    controllers.push_back(std::make_unique<RendezvousController>(bot, started, 3));
+
+    EXPECT_NO_THROW(Controller::InitAll(controllers, &profile));
+    EXPECT_EQ(profile.getPhases().size(), 3);
+}
+
+TEST_F(StartupProfileTest, InitializationErrorIsRethrown)
+{
+    std::atomic<int> started = 0;
+
+    std::vector<std::unique_ptr<Controller>> controllers;
+    controllers.push_back(std::make_unique<RendezvousController>(bot, started, 2));
+    controllers.push_back(std::make_unique<RendezvousController>(bot, started, 2, true));
+
+    EXPECT_THROW(Controller::InitAll(controllers), std::runtime_error);
+}
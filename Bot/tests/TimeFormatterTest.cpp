@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "Time/TimeFormatter.h"
+
+class TimeFormatterTest : public ::testing::Test
+{
+public:
+    TimeFormatterTest() = default;
+
+    ~TimeFormatterTest() = default;
+
+protected:
+    static TimeFormatter::TimePoint_Type FromSeconds(int64_t seconds)
+    {
+        return TimeFormatter::TimePoint_Type(std::chrono::seconds(seconds));
+    }
+};
+
+TEST_F(TimeFormatterTest, Format)
+{
+    auto utc = TimeFormatter::LocateZone("UTC");
+    ASSERT_NE(utc, nullptr);
+
+    TimeFormatter::Buffer_Type buffer;
+    EXPECT_EQ(TimeFormatter::Format(FromSeconds(0), utc, buffer), "01/01/1970 00:00:00");
+    EXPECT_EQ(TimeFormatter::Format(FromSeconds(1700000000), utc, buffer), "14/11/2023 22:13:20");
+    EXPECT_EQ(TimeFormatter::Format(FromSeconds(1700000000) + std::chrono::milliseconds(999), utc), "14/11/2023 22:13:20");
+
+    // Cached second, other zone
+    auto paris = TimeFormatter::LocateZone("Europe/Paris");
+    ASSERT_NE(paris, nullptr);
+    EXPECT_EQ(TimeFormatter::Format(FromSeconds(1700000000), paris), "14/11/2023 23:13:20");
+    EXPECT_EQ(TimeFormatter::Format(FromSeconds(1700000000), utc), "14/11/2023 22:13:20");
+}
+
+TEST_F(TimeFormatterTest, DefaultZone)
+{
+    ASSERT_NE(TimeFormatter::GetDefaultZone(), nullptr);
+
+    auto now = std::chrono::system_clock::now();
+    EXPECT_EQ(TimeFormatter::Format(now, nullptr), TimeFormatter::Format(now, TimeFormatter::GetDefaultZone()));
+}
+
+TEST_F(TimeFormatterTest, LocateZone)
+{
+    EXPECT_EQ(TimeFormatter::LocateZone("Not/A_Zone"), nullptr);
+    EXPECT_EQ(TimeFormatter::LocateZone(""), nullptr);
+}
+
+TEST_F(TimeFormatterTest, Threads)
+{
+    auto utc = TimeFormatter::LocateZone("UTC");
+    ASSERT_NE(utc, nullptr);
+
+    std::vector<std::thread> threads;
+    std::atomic<size_t> errors = 0;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&errors, utc]() {
+            TimeFormatter::Buffer_Type buffer;
+
+            for (int64_t s = 0; s < 10000; ++s)
+            {
+                // Every 86400 + 3661 seconds: one day, one hour, one minute and one second later
+                auto formatted = TimeFormatter::Format(FromSeconds(s * (86400 + 3661)), utc, buffer);
+
+                if (formatted.substr(11) != TimeFormatter::Format(FromSeconds(s * 3661 % 86400), utc).substr(11))
+                    ++errors;
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(errors, 0);
+}
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
+#include <filesystem>
 #include <random>
 
 #include "Controllers/TimerController.h"
+#include "Metrics/MetricsRegistry.h"
+#include "Simulation/SimulatedGateway.h"
+#include "Simulation/SimulatedTimerScheduler.h"
+#include "Time/VirtualClock.h"
 
 class TimerControllerTest : public ::testing::Test
 {
@@ -51,4 +56,314 @@ TEST_F(TimerControllerTest, ParseInteval)
     EXPECT_THROW(TimerController::ParseInteval("42s 42m 42h"), ParsingException);
     EXPECT_THROW(TimerController::ParseInteval("42s 42m 42h 42d"), ParsingException);
     EXPECT_THROW(TimerController::ParseInteval("42s 42m 42h 42d 42x"), ParsingException);
-}
\ No newline at end of file
+    EXPECT_THROW(TimerController::ParseInteval(""), ParsingException);
+    EXPECT_THROW(TimerController::ParseInteval("1d "), ParsingException);
+    EXPECT_THROW(TimerController::ParseInteval("1d 2d"), ParsingException);
+    EXPECT_THROW(TimerController::ParseInteval("1d 2h 3m 4s 5s"), ParsingException);
+    EXPECT_THROW(TimerController::ParseInteval("+-1d"), ParsingException);
+}
+
+TEST_F(TimerControllerTest, ParseTime)
+{
+    auto utc = TimeFormatter::LocateZone("UTC");
+    ASSERT_NE(utc, nullptr);
+
+    auto expected = TimerController::TimePoint_Type(std::chrono::seconds(1700000000));
+    EXPECT_EQ(TimerController::ParseTime("14/11/2023 22:13:20", utc), expected);
+    EXPECT_EQ(TimerController::ParseTime(" 14 / 11 / 2023  22 : 13 : 20", utc), expected);
+    EXPECT_EQ(TimerController::ParseTime("14/11/2023 22:13:20 trailing", utc), expected);
+
+    // Out of range fields are normalized
+    EXPECT_EQ(TimerController::ParseTime("32/01/2024 00:00:00", utc), TimerController::ParseTime("01/02/2024 00:00:00", utc));
+    EXPECT_EQ(TimerController::ParseTime("01/13/2024 00:00:00", utc), TimerController::ParseTime("01/01/2025 00:00:00", utc));
+    EXPECT_EQ(TimerController::ParseTime("01/03/2024 24:00:00", utc), TimerController::ParseTime("02/03/2024 00:00:00", utc));
+
+    // Times are read in the given zone
+    auto paris = TimeFormatter::LocateZone("Europe/Paris");
+    ASSERT_NE(paris, nullptr);
+    EXPECT_EQ(TimerController::ParseTime("14/11/2023 23:13:20", paris), expected);
+    EXPECT_EQ(TimerController::GetFormattedTime(TimerController::ParseTime("05/01/2024 08:30:00", paris), paris), "05/01/2024 08:30:00");
+
+    EXPECT_THROW(TimerController::ParseTime("", utc), ParsingException);
+    EXPECT_THROW(TimerController::ParseTime("14/11/2023", utc), ParsingException);
+    EXPECT_THROW(TimerController::ParseTime("14-11-2023 22:13:20", utc), ParsingException);
+    EXPECT_THROW(TimerController::ParseTime("14/11/2023 22h13m20s", utc), ParsingException);
+    EXPECT_THROW(TimerController::ParseTime("aa/11/2023 22:13:20", utc), ParsingException);
+    EXPECT_THROW(TimerController::ParseTime("99999999999/11/2023 22:13:20", utc), ParsingException);
+    EXPECT_THROW(TimerController::ParseTime("01/01/1970 00:00:00", utc), ParsingException);
+}
+
+/**
+ * @brief Drive the controller end to end, through the simulated gateway, REST API and scheduler.
+ * 
+ */
+class TimerControllerSimulationTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        std::filesystem::remove_all("data/timers");
+        std::filesystem::remove_all("data/guilds");
+        std::filesystem::create_directories("data/timers");
+
+        auto timerScheduler = std::make_unique<SimulatedTimerScheduler>(&clock);
+        scheduler = timerScheduler.get();
+
+        controller = std::make_unique<TimerController>(bot, api.createMessageSink(), std::move(timerScheduler), nullptr, &clock);
+        controller->init();
+        controller->registerRoutes(router);
+    }
+
+    void TearDown() override
+    {
+        controller.reset();
+
+        std::filesystem::remove_all("data/timers");
+        std::filesystem::remove_all("data/guilds");
+    }
+
+protected:
+    std::string sendTimerCommand(const std::string& subcommand, const std::vector<SimulatedGateway::Option_Type>& options = {})
+    {
+        return api.getResponse(gateway.sendCommand(invoker, "timer", subcommand, options));
+    }
+
+protected:
+    dpp::cluster bot{ "simulated" };
+    VirtualClock clock{ std::chrono::sys_days(std::chrono::year(2024) / 1 / 1) + std::chrono::hours(12) };
+    SimulatedRestApi api;
+    SimulatedTimerScheduler* scheduler = nullptr;
+    std::unique_ptr<TimerController> controller;
+    CommandRouter router{ nullptr, nullptr, &api };
+    SimulatedGateway gateway{ router, api };
+    SimulatedGateway::Invoker invoker = { 1, 2, 3 };
+};
+
+TEST_F(TimerControllerSimulationTest, TimerLifecycle)
+{
+    auto end = TimerController::GetFormattedTime(clock.now() + std::chrono::hours(1));
+
+    auto response = sendTimerCommand("set", {
+        { "name", std::string("daily") },
+        { "interval", std::string("10s") },
+        { "message", std::string("Hello") },
+        { "end", end },
+    });
+
+    EXPECT_TRUE(response.starts_with("Timer started")) << response;
+    EXPECT_EQ(scheduler->getTimerCount(), 1u);
+    EXPECT_EQ(api.getStats().messages, 0u);
+
+    // The first fire is on the next interval boundary, then every interval
+    scheduler->advance(10);
+    EXPECT_EQ(api.getStats().messages, 1u);
+    scheduler->advance(30);
+    EXPECT_EQ(api.getStats().messages, 4u);
+    EXPECT_EQ(scheduler->getTimerCount(), 1u);
+
+    EXPECT_NE(sendTimerCommand("list").find("daily"), std::string::npos);
+
+    sendTimerCommand("trigger", { { "name", std::string("daily") } });
+    EXPECT_EQ(api.getStats().messages, 5u);
+
+    EXPECT_TRUE(gateway.sendAutocomplete(invoker, "timer", "stop", "name", "da"));
+    EXPECT_EQ(api.getStats().suggestions, 1u);
+
+    sendTimerCommand("stop", { { "name", std::string("daily") } });
+    EXPECT_EQ(scheduler->getTimerCount(), 0u);
+
+    scheduler->advance(60);
+    EXPECT_EQ(api.getStats().messages, 5u);
+    EXPECT_EQ(api.getUnansweredCount(), 0u);
+    EXPECT_EQ(api.getResponseLatency().getCount(), 4u);
+}
+
+TEST_F(TimerControllerSimulationTest, TimerEndsOnVirtualClock)
+{
+    auto start = clock.now();
+
+    sendTimerCommand("set", {
+        { "name", std::string("hourly") },
+        { "interval", std::string("10m") },
+        { "message", std::string("{rem:minuts} minutes left") },
+        { "end", TimerController::GetFormattedTime(start + std::chrono::hours(1)) },
+    });
+
+    // Fires at 10, 20, ..., 60 minutes, then stops on the first fire past the end
+    scheduler->advance(2 * 60 * 60);
+
+    EXPECT_EQ(api.getStats().messages, 6u);
+    EXPECT_EQ(scheduler->getTimerCount(), 0u);
+    EXPECT_EQ(clock.now(), start + std::chrono::hours(2));
+}
+
+TEST_F(TimerControllerSimulationTest, FailedUpdateKeepsFiring)
+{
+    sendTimerCommand("set", {
+        { "name", std::string("daily") },
+        { "interval", std::string("10s") },
+        { "message", std::string("Hello") },
+        { "end", TimerController::GetFormattedTime(clock.now() + std::chrono::hours(1)) },
+    });
+
+    // The timer file can not be written aside
+    std::filesystem::create_directories("data/timers/daily.txt.tmp");
+
+    auto response = sendTimerCommand("update", {
+        { "name", std::string("daily") },
+        { "message", std::string("Updated") },
+    });
+    EXPECT_TRUE(response.starts_with("Error")) << response;
+
+    scheduler->advance(10);
+    EXPECT_EQ(api.getStats().messages, 1u);
+    EXPECT_EQ(scheduler->getTimerCount(), 1u);
+}
+
+TEST_F(TimerControllerSimulationTest, UnknownCommand)
+{
+    EXPECT_EQ(api.getResponse(gateway.sendCommand(invoker, "unknown", "")), "Unknown command");
+    EXPECT_EQ(api.getStats().replies, 1u);
+}
+
+TEST_F(TimerControllerSimulationTest, EditInPlaceCountdown)
+{
+    sendTimerCommand("set", {
+        { "name", std::string("countdown") },
+        { "interval", std::string("10s") },
+        { "message", std::string("{rem:seconds} seconds left") },
+        { "end", TimerController::GetFormattedTime(clock.now() + std::chrono::hours(1)) },
+        { "edit", true },
+    });
+
+    // One message posted, then edited on each fire
+    scheduler->advance(60);
+    EXPECT_EQ(api.getStats().messages, 1u);
+    EXPECT_EQ(api.getStats().messageEdits, 5u);
+
+    TimerDAO stored;
+    stored.loadTimers();
+    EXPECT_NE(stored.findOne("countdown").getMessageID(), 0u);
+    EXPECT_TRUE(stored.findOne("countdown").isEditInPlace());
+}
+
+TEST_F(TimerControllerSimulationTest, StandbyTakesOver)
+{
+    MetricsRegistry metrics;
+
+    // The fixture controller was the primary, a new one stands by
+    controller.reset();
+
+    auto timerScheduler = std::make_unique<SimulatedTimerScheduler>(&clock);
+    scheduler = timerScheduler.get();
+
+    controller = std::make_unique<TimerController>(bot, api.createMessageSink(), std::move(timerScheduler), &metrics, &clock);
+    controller->initStandby();
+    EXPECT_TRUE(controller->isStandby());
+
+    // Persisted by the primary while the standby follows
+    TimerDAO primary;
+    primary.setJournaled(true);
+    TimerDTO timer("followed", dpp::snowflake(4), 10, "Hello", clock.now(), clock.now() + std::chrono::hours(1), "", "", dpp::snowflake(3));
+    primary.add("followed", timer);
+
+    EXPECT_EQ(controller->followPrimary(), 1u);
+    EXPECT_EQ(scheduler->getTimerCount(), 0u);
+
+    controller->init();
+
+    EXPECT_FALSE(controller->isStandby());
+    EXPECT_EQ(scheduler->getTimerCount(), 1u);
+
+    scheduler->advance(10);
+    EXPECT_EQ(api.getStats().messages, 1u);
+
+    auto& firstFire = metrics.histogram("bot_failover_first_fire_seconds", "");
+    EXPECT_EQ(firstFire.snapshot().getCount(), 1u);
+    EXPECT_EQ(firstFire.snapshot().getMax(), uint64_t(std::chrono::nanoseconds(std::chrono::seconds(10)).count()));
+
+    controller.reset();
+}
+
+TEST_F(TimerControllerSimulationTest, BulkOperations)
+{
+    auto end = TimerController::GetFormattedTime(clock.now() + std::chrono::hours(1));
+
+    for (const auto& name : { "raid-1", "raid-2", "daily" })
+    {
+        sendTimerCommand("set", {
+            { "name", std::string(name) },
+            { "interval", std::string("10s") },
+            { "message", std::string("Hello") },
+            { "end", end },
+        });
+    }
+
+    auto sendBulkCommand = [this](const std::string& subcommand, const std::vector<SimulatedGateway::Option_Type>& options) {
+        return api.getResponse(gateway.sendCommand(invoker, "timers", subcommand, options));
+    };
+
+    EXPECT_TRUE(sendBulkCommand("stop", {}).starts_with("Error")) << "a bulk command needs a selection";
+
+    EXPECT_EQ(sendBulkCommand("pause", { { "prefix", std::string("raid-") } }), "Paused 2 timers.");
+    EXPECT_EQ(scheduler->getTimerCount(), 1u);
+    EXPECT_NE(sendTimerCommand("list").find("Paused"), std::string::npos);
+
+    scheduler->advance(10);
+    EXPECT_EQ(api.getStats().messages, 1u);
+
+    EXPECT_EQ(sendBulkCommand("resume", { { "channel", invoker.channel } }), "Resumed 2 timers.");
+    EXPECT_EQ(scheduler->getTimerCount(), 3u);
+
+    scheduler->advance(10);
+    EXPECT_EQ(api.getStats().messages, 4u);
+
+    EXPECT_EQ(sendBulkCommand("retarget", { { "to", dpp::snowflake(42) }, { "prefix", std::string("raid-") } }), "Retargeted 2 timers.");
+    EXPECT_EQ(sendBulkCommand("stop", { { "channel", dpp::snowflake(42) }, { "ends_before", end } }), "Stopped 0 timers.");
+
+    // Moved past the end, the timers are over
+    EXPECT_EQ(sendBulkCommand("shift", { { "by", std::string("2h") }, { "earlier", true }, { "prefix", std::string("raid-") } }), "Shifted 0 timers. Stopped 2 ended timers.");
+    EXPECT_EQ(scheduler->getTimerCount(), 1u);
+    EXPECT_EQ(sendTimerCommand("list").find("raid"), std::string::npos);
+}
+
+TEST_F(TimerControllerSimulationTest, BulkStopCleansUpChannel)
+{
+    constexpr size_t COUNT = 500;
+
+    // Stored beforehand, /timer set is rate limited well below this
+    controller.reset();
+
+    TimerDAO stored;
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        auto name = "timer-" + std::to_string(i);
+        stored.add(name, TimerDTO(name, invoker.channel, 10, "Hello", clock.now(), clock.now() + std::chrono::hours(1), "", "", invoker.guild));
+    }
+
+    auto timerScheduler = std::make_unique<SimulatedTimerScheduler>(&clock);
+    scheduler = timerScheduler.get();
+
+    controller = std::make_unique<TimerController>(bot, api.createMessageSink(), std::move(timerScheduler), nullptr, &clock);
+    controller->init();
+
+    // The fixture router still routes to the previous controller
+    CommandRouter bulkRouter{ nullptr, nullptr, &api };
+    SimulatedGateway bulkGateway{ bulkRouter, api };
+    controller->registerRoutes(bulkRouter);
+
+    EXPECT_EQ(scheduler->getTimerCount(), COUNT);
+
+    auto start = std::chrono::steady_clock::now();
+    auto response = api.getResponse(bulkGateway.sendCommand(invoker, "timers", "stop", { { "channel", invoker.channel } }));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(response, "Stopped 500 timers.");
+    EXPECT_EQ(scheduler->getTimerCount(), 0u);
+    EXPECT_EQ(api.getResponse(bulkGateway.sendCommand(invoker, "timer", "list")), "No running timers.");
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+
+    scheduler->advance(60);
+    EXPECT_EQ(api.getStats().messages, 0u);
+}
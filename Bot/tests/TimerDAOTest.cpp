@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <random>
+#include <set>
+#include <thread>
 
 #include "DAO/TimerDAO.h"
 
@@ -175,6 +178,135 @@ TEST_F(TimerDAOTest, deleteByID)
     EXPECT_THROW(dao.deleteByID(""), DAOBadID);
 }
 
+TEST_F(TimerDAOTest, updateMany)
+{
+    addMockTimerDTO("1");
+    addMockTimerDTO("2");
+
+    auto version = dao.getVersion();
+
+    auto first = createMockTimerDTO("1", "First");
+    auto second = createMockTimerDTO("2", "Second");
+    second.setPaused(true);
+
+    EXPECT_NO_THROW(dao.updateMany({ { "1", first }, { "2", second } }));
+    EXPECT_EQ(dao.getVersion(), version + 1);
+    EXPECT_EQ(dao.findOne("1").getMessage(), "First");
+    EXPECT_TRUE(dao.findOne("2").isPaused());
+    checkFileContent("1", first);
+    checkFileContent("2", second);
+
+    // Checked before anything is written
+    EXPECT_THROW(dao.updateMany({ { "1", second }, { "3", second } }), DAOIDNotFound);
+    EXPECT_EQ(dao.findOne("1").getMessage(), "First");
+
+    // A failed write leaves every timer untouched, including the ones written before
+    std::filesystem::create_directories("data/timers/2.txt.tmp");
+    version = dao.getVersion();
+
+    EXPECT_THROW(dao.updateMany({ { "1", second }, { "2", first } }), DAOOutputStreamException);
+    EXPECT_EQ(dao.getVersion(), version);
+    EXPECT_EQ(dao.findOne("1").getMessage(), "First");
+    EXPECT_FALSE(std::filesystem::exists("data/timers/1.txt.tmp"));
+    checkFileContent("1", first);
+
+    std::filesystem::remove("data/timers/2.txt.tmp");
+
+    TimerDAO reloaded;
+    reloaded.loadTimers();
+    EXPECT_TRUE(reloaded.findOne("2").isPaused());
+    EXPECT_FALSE(reloaded.findOne("1").isPaused());
+}
+
+TEST_F(TimerDAOTest, deleteMany)
+{
+    addMockTimerDTO("1");
+    addMockTimerDTO("2");
+    addMockTimerDTO("3");
+
+    auto version = dao.getVersion();
+
+    EXPECT_THROW(dao.deleteMany({ "1", "4" }), DAOIDNotFound);
+    expectSize(3);
+
+    EXPECT_NO_THROW(dao.deleteMany({ "1", "2" }));
+    EXPECT_EQ(dao.getVersion(), version + 1);
+    expectSize(1);
+    EXPECT_FALSE(std::filesystem::exists("data/timers/1.txt"));
+    EXPECT_FALSE(std::filesystem::exists("data/timers/2.txt"));
+    EXPECT_TRUE(std::filesystem::exists("data/timers/3.txt"));
+}
+
+TEST_F(TimerDAOTest, updateAndDeleteMany)
+{
+    addMockTimerDTO("1");
+    addMockTimerDTO("2");
+
+    auto version = dao.getVersion();
+    auto first = createMockTimerDTO("1", "First");
+
+    // A failed write deletes nothing
+    std::filesystem::create_directories("data/timers/1.txt.tmp");
+    EXPECT_THROW(dao.updateMany({ { "1", first } }, { "2" }), DAOOutputStreamException);
+    EXPECT_EQ(dao.getVersion(), version);
+    expectSize(2);
+
+    std::filesystem::remove("data/timers/1.txt.tmp");
+
+    EXPECT_NO_THROW(dao.updateMany({ { "1", first } }, { "2" }));
+    EXPECT_EQ(dao.getVersion(), version + 1);
+    expectSize(1);
+    checkFileContent("1", first);
+    EXPECT_FALSE(std::filesystem::exists("data/timers/2.txt"));
+}
+
+TEST_F(TimerDAOTest, version)
+{
+    auto timer = createMockTimerDTO("1", "A message");
+    auto version = dao.getVersion();
+
+    dao.add("1", timer);
+    EXPECT_GT(dao.getVersion(), version);
+    version = dao.getVersion();
+
+    dao.findOne("1");
+    EXPECT_THROW(dao.add("1", timer), DAOIDAlreadyExists);
+    EXPECT_EQ(dao.getVersion(), version);
+
+    dao.update("1", timer);
+    EXPECT_GT(dao.getVersion(), version);
+    version = dao.getVersion();
+
+    dao.deleteByID("1");
+    EXPECT_GT(dao.getVersion(), version);
+}
+
+TEST_F(TimerDAOTest, saveMessageIDs)
+{
+    dao.add("1", createMockTimerDTO("1"));
+    dao.add("2", createMockTimerDTO("2"));
+    auto version = dao.getVersion();
+
+    dao.setMessageID("1", dpp::snowflake(42));
+    dao.setMessageID("2", dpp::snowflake(43));
+
+    // Set in memory only, without a new version
+    EXPECT_EQ(dao.findOne("1").getMessageID(), dpp::snowflake(42));
+    EXPECT_EQ(dao.getVersion(), version);
+
+    dao.deleteByID("2");
+
+    TimerDAO stored;
+    stored.loadTimers();
+    EXPECT_EQ(stored.findOne("1").getMessageID(), dpp::snowflake(0));
+
+    // The deleted timer is not written again
+    dao.saveMessageIDs();
+    stored.loadTimers();
+    EXPECT_EQ(stored.findOne("1").getMessageID(), dpp::snowflake(42));
+    EXPECT_FALSE(stored.idExists("2"));
+}
+
 TEST_F(TimerDAOTest, findOne)
 {
     auto timer = createMockTimerDTO("1", "A message");
@@ -189,6 +321,123 @@ TEST_F(TimerDAOTest, findOne)
     EXPECT_THROW(dao.findOne(""), DAOBadID);
 }
 
+TEST_F(TimerDAOTest, snapshot)
+{
+    addMockTimerDTO("1", "First");
+    addMockTimerDTO("2", "Second");
+    addMockTimerDTO("3", "Third");
+
+    auto snapshot = dao.snapshot();
+    EXPECT_EQ(snapshot->getVersion(), dao.getVersion());
+    EXPECT_EQ(snapshot->size(), 3);
+
+    // Shared until the next mutation
+    EXPECT_EQ(dao.snapshot(), snapshot);
+
+    auto record = dao.findRecord("1");
+    dao.update("1", createMockTimerDTO("1", "Updated"));
+    dao.deleteByID("2");
+
+    // Unchanged by the mutations, the records held stay valid
+    EXPECT_EQ(snapshot->size(), 3);
+    EXPECT_EQ(snapshot->find("1")->getMessage(), "First");
+    EXPECT_EQ(snapshot->find("2")->getMessage(), "Second");
+    EXPECT_EQ(record->getMessage(), "First");
+
+    auto latest = dao.snapshot();
+    EXPECT_GT(latest->getVersion(), snapshot->getVersion());
+    EXPECT_EQ(latest->size(), 2);
+    EXPECT_EQ(latest->find("1")->getMessage(), "Updated");
+    EXPECT_EQ(latest->find("2"), nullptr);
+
+    // The untouched timer is shared between versions
+    EXPECT_EQ(latest->find("3"), snapshot->find("3"));
+
+    EXPECT_THROW(dao.findRecord("2"), DAOIDNotFound);
+    EXPECT_THROW(dao.findRecord(""), DAOBadID);
+}
+
+TEST_F(TimerDAOTest, snapshotReadDuringMutations)
+{
+    for (int i = 0; i < 20; ++i)
+        addMockTimerDTO(std::to_string(i), "0");
+
+    std::atomic<bool> done = false;
+
+    // Updated as a whole: every timer of a version shows the same message
+    std::thread writer([&]() {
+        for (int round = 1; round <= 25; ++round)
+        {
+            std::vector<std::pair<std::string, TimerDTO>> timers;
+
+            for (int i = 0; i < 20; ++i)
+                timers.emplace_back(std::to_string(i), createMockTimerDTO(std::to_string(i), std::to_string(round)));
+
+            dao.updateMany(timers);
+        }
+
+        done = true;
+    });
+
+    size_t reads = 0;
+
+    while (!done || reads == 0)
+    {
+        // Taken without lock while the writer publishes new versions
+        auto snapshot = dao.snapshot();
+        ASSERT_EQ(snapshot->size(), 20);
+
+        const auto& message = snapshot->begin()->second->getMessage();
+
+        for (const auto& [id, timer] : *snapshot)
+            EXPECT_EQ(timer->getMessage(), message);
+
+        ++reads;
+    }
+
+    writer.join();
+
+    EXPECT_EQ(dao.snapshot()->find("0")->getMessage(), "25");
+}
+
+TEST_F(TimerDAOTest, snapshotManyTimers)
+{
+    // Enough timers to split the trie over several levels
+    TimerSnapshot::Builder builder;
+
+    for (int i = 0; i < 5000; ++i)
+        builder.set(std::to_string(i), std::make_shared<const TimerDTO>(createMockTimerDTO(std::to_string(i), "First")));
+
+    auto snapshot = builder.build(1);
+    ASSERT_EQ(snapshot->size(), 5000);
+
+    TimerSnapshot::Builder next(*snapshot);
+
+    for (int i = 0; i < 5000; i += 2)
+        next.erase(std::to_string(i));
+
+    next.set("1", std::make_shared<const TimerDTO>(createMockTimerDTO("1", "Updated")));
+    next.erase("unknown");
+
+    auto latest = next.build(2);
+    EXPECT_EQ(latest->size(), 2500);
+    EXPECT_EQ(latest->find("0"), nullptr);
+    EXPECT_EQ(latest->find("1")->getMessage(), "Updated");
+    EXPECT_EQ(latest->find("3"), snapshot->find("3"));
+
+    std::set<std::string> ids;
+
+    for (const auto& [id, timer] : *latest)
+        EXPECT_TRUE(ids.insert(id).second);
+
+    EXPECT_EQ(ids.size(), 2500);
+    EXPECT_EQ(std::distance(snapshot->begin(), snapshot->end()), 5000);
+
+    // The previous version is unchanged
+    EXPECT_EQ(snapshot->find("0")->getMessage(), "First");
+    EXPECT_EQ(snapshot->find("1")->getMessage(), "First");
+}
+
 TEST_F(TimerDAOTest, findAll)
 {
     expectEmpty();
@@ -295,4 +544,58 @@ TEST_F(TimerDAOTest, loadTimers)
         EXPECT_EQ(timers[i].getMessage(), "Hey! This is a simple message. My id is " + id);
         checkFileContent(id, timers[i]);
     }
-}
\ No newline at end of file
+}
+TEST_F(TimerDAOTest, followJournals)
+{
+    dao.setJournaled(true);
+    dao.add("kept", createMockTimerDTO("kept", "Stored before the follower loads"));
+
+    TimerDAO follower;
+    follower.loadTimers();
+    EXPECT_TRUE(follower.followJournals().empty());
+
+    dao.add("added", createMockTimerDTO("added", "Added"));
+    dao.update("kept", createMockTimerDTO("kept", "Updated"));
+
+    auto changed = follower.followJournals();
+    std::sort(changed.begin(), changed.end());
+
+    EXPECT_EQ(changed, std::vector<std::string>({ "added", "kept" }));
+    EXPECT_EQ(follower.findOne("added").getMessage(), "Added");
+    EXPECT_EQ(follower.findOne("kept").getMessage(), "Updated");
+
+    dao.deleteByID("added");
+
+    EXPECT_EQ(follower.followJournals(), std::vector<std::string>({ "added" }));
+    EXPECT_FALSE(follower.idExists("added"));
+
+    // A reset journal only holds the changes since, the follower reloads everything
+    dao.resetJournals();
+    dao.add("after", createMockTimerDTO("after", "After the reset"));
+
+    EXPECT_EQ(follower.followJournals().size(), 2);
+    EXPECT_TRUE(follower.idExists("after"));
+    EXPECT_TRUE(follower.idExists("kept"));
+}
+
+TEST_F(TimerDAOTest, journalsOnlyWhenEnabled)
+{
+    dao.add("unjournaled", createMockTimerDTO("unjournaled"));
+    EXPECT_FALSE(std::filesystem::exists("data/timers/journal.log"));
+
+    dao.setJournaled(true, 64);
+    dao.resetJournals();
+
+    TimerDAO follower;
+    follower.loadTimers();
+
+    for (int i = 0; i < 20; ++i)
+        dao.add(std::to_string(i), createMockTimerDTO(std::to_string(i)));
+
+    // Reset once past its maximum size, the journal does not grow with the mutations
+    EXPECT_LE(std::filesystem::file_size("data/timers/journal.log"), 64 + 8);
+
+    auto changed = follower.followJournals();
+    EXPECT_EQ(changed.size(), 21);
+    EXPECT_EQ(follower.getDataMap().size(), 21);
+}
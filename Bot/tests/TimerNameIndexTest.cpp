@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "DAO/TimerNameIndex.h"
+
+class TimerNameIndexTest : public ::testing::Test
+{
+public:
+    TimerNameIndexTest() = default;
+
+    ~TimerNameIndexTest() = default;
+
+protected:
+    TimerDTO createMockTimerDTO(const std::string& name, const dpp::snowflake& guild)
+    {
+        TimerDTO timer = TimerDTO();
+            timer.setName(name);
+            timer.setGuild(guild);
+        return timer;
+    }
+
+protected:
+    TimerNameIndex index;
+};
+
+TEST_F(TimerNameIndexTest, FindByPrefix)
+{
+    for (const char* name : { "raid", "reset", "raid_hard", "event", "raid_easy" })
+        index.add(1, name);
+
+    EXPECT_EQ(index.findByPrefix(1, "raid", 25), (std::vector<std::string>{ "raid", "raid_easy", "raid_hard" }));
+    EXPECT_EQ(index.findByPrefix(1, "r", 2), (std::vector<std::string>{ "raid", "raid_easy" }));
+    EXPECT_EQ(index.findByPrefix(1, "", 25).size(), 5);
+    EXPECT_TRUE(index.findByPrefix(1, "x", 25).empty());
+}
+
+TEST_F(TimerNameIndexTest, ScopedPerGuild)
+{
+    index.add(1, "raid");
+    index.add(2, "reset");
+
+    EXPECT_EQ(index.findByPrefix(1, "r", 25), std::vector<std::string>{ "raid" });
+    EXPECT_EQ(index.findByPrefix(2, "r", 25), std::vector<std::string>{ "reset" });
+    EXPECT_TRUE(index.findByPrefix(3, "r", 25).empty());
+}
+
+TEST_F(TimerNameIndexTest, IncrementalUpdates)
+{
+    TimerSnapshot::Builder timers;
+    timers.set("b", std::make_shared<const TimerDTO>(createMockTimerDTO("b", 1)));
+    timers.set("a", std::make_shared<const TimerDTO>(createMockTimerDTO("a", 1)));
+    timers.set("c", std::make_shared<const TimerDTO>(createMockTimerDTO("c", 2)));
+    index.rebuild(*timers.build(1));
+
+    EXPECT_EQ(index.size(1), 2);
+    EXPECT_EQ(index.size(2), 1);
+
+    index.add(1, "ab");
+    index.add(1, "ab");
+    index.remove(1, "a");
+    index.remove(1, "unknown");
+    index.remove(2, "c");
+
+    EXPECT_EQ(index.findByPrefix(1, "", 25), (std::vector<std::string>{ "ab", "b" }));
+    EXPECT_EQ(index.size(2), 0);
+}
+
+TEST_F(TimerNameIndexTest, QueriedDuringUpdates)
+{
+    index.add(1, "raid");
+
+    std::atomic<bool> done = false;
+
+    std::thread writer([&]() {
+        for (int i = 0; i < 1000; ++i)
+        {
+            index.add(1, "reset_" + std::to_string(i));
+            index.remove(1, "reset_" + std::to_string(i));
+        }
+
+        done = true;
+    });
+
+    // Queried without any other lock while the writer updates the index
+    while (!done)
+        ASSERT_EQ(index.findByPrefix(1, "raid", 25), std::vector<std::string>{ "raid" });
+
+    writer.join();
+
+    EXPECT_EQ(index.size(1), 1);
+}
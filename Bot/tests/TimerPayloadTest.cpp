@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "Controllers/TimerController.h"
+#include "Discord/TimerPayload.h"
+
+class TimerPayloadTest : public ::testing::Test
+{
+public:
+    TimerPayloadTest() = default;
+
+    ~TimerPayloadTest() = default;
+
+protected:
+    TimerDTO createMockTimerDTO(const std::string& message)
+    {
+        TimerDTO timer = TimerDTO();
+            timer.setName("payload");
+            timer.setChannel(dpp::snowflake(1234567890));
+            timer.setMessage(message);
+            timer.setInterval(60);
+            auto now = std::chrono::system_clock::now();
+            timer.setStart(now);
+            timer.setEnd(now + std::chrono::hours(72));
+        return timer;
+    }
+};
+
+TEST_F(TimerPayloadTest, StaticMessage)
+{
+    auto dto = createMockTimerDTO("Hello from {name}!");
+    TimerController::Timer timer(dto);
+    TimerPayload payload(timer.buildMessage(), dto.getEnd());
+
+    std::string buffer;
+    const auto& body = payload.render(buffer, dto.getStart());
+
+    EXPECT_TRUE(payload.isStatic());
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(body, timer.buildMessage().build_json());
+    EXPECT_NE(body.find("Hello from payload!"), std::string::npos);
+}
+
+TEST_F(TimerPayloadTest, DynamicPlaceholders)
+{
+    auto dto = createMockTimerDTO("{rem:days}d {rem:hours}h {rem:minuts}m {rem:seconds}s left for {name}");
+    TimerController::Timer timer(dto);
+    TimerPayload payload(timer.buildMessage(), dto.getEnd());
+
+    EXPECT_FALSE(payload.isStatic());
+
+    std::string buffer;
+    auto now = dto.getEnd() - std::chrono::hours(50) - std::chrono::seconds(7);
+    const auto& body = payload.render(buffer, now);
+
+    EXPECT_EQ(&body, &buffer);
+    EXPECT_NE(body.find("2d 50h 3000m 180007s left for payload"), std::string::npos);
+    EXPECT_EQ(body.find("{rem:"), std::string::npos);
+
+    // Rendering again reuses the buffer and only changes the dynamic spans
+    now += std::chrono::hours(49);
+    payload.render(buffer, now);
+    EXPECT_NE(buffer.find("0d 1h 60m 3607s left for payload"), std::string::npos);
+}
+
+TEST_F(TimerPayloadTest, UnknownBracesAreKept)
+{
+    auto dto = createMockTimerDTO("{rem:weeks} {rem:days");
+    TimerController::Timer timer(dto);
+    TimerPayload payload(timer.buildMessage(), dto.getEnd());
+
+    std::string buffer;
+    EXPECT_TRUE(payload.isStatic());
+    EXPECT_NE(payload.render(buffer, dto.getStart()).find("{rem:weeks} {rem:days"), std::string::npos);
+}
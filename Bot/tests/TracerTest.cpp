@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "Tracing/Tracer.h"
+
+class TracerTest : public ::testing::Test
+{
+public:
+    TracerTest() = default;
+
+    ~TracerTest() = default;
+
+    void SetUp() override
+    {
+        Tracer::Clear();
+        Tracer::SetEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        Tracer::SetEnabled(false);
+        Tracer::Clear();
+    }
+
+    size_t countOccurrences(const std::string& text, const std::string& pattern)
+    {
+        size_t count = 0;
+
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+            ++count;
+
+        return count;
+    }
+};
+
+TEST_F(TracerTest, ExportsSpansOfEveryThread)
+{
+    {
+        TraceSpan span("main");
+    }
+
+    std::thread worker([]() {
+        TraceSpan span("worker");
+    });
+    worker.join();
+
+    auto trace = Tracer::ExportChromeTrace();
+
+    EXPECT_TRUE(trace.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[{"));
+    EXPECT_TRUE(trace.ends_with("}]}"));
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"main\",\"ph\":\"X\""), 1);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"worker\",\"ph\":\"X\""), 1);
+}
+
+TEST_F(TracerTest, DisabledRecordsNothing)
+{
+    Tracer::SetEnabled(false);
+
+    {
+        TraceSpan span("disabled");
+    }
+
+    EXPECT_EQ(Tracer::ExportChromeTrace(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}");
+}
+
+TEST_F(TracerTest, ClearDropsSpans)
+{
+    {
+        TraceSpan span("before");
+    }
+
+    Tracer::Clear();
+
+    {
+        TraceSpan span("after");
+    }
+
+    auto trace = Tracer::ExportChromeTrace();
+
+    EXPECT_EQ(countOccurrences(trace, "before"), 0);
+    EXPECT_EQ(countOccurrences(trace, "after"), 1);
+}
+
+TEST_F(TracerTest, RingKeepsMostRecentSpans)
+{
+    for (size_t i = 0; i < Tracer::EVENTS_PER_THREAD; ++i)
+        Tracer::Record("old", Tracer::Now(), 1);
+
+    for (size_t i = 0; i < 10; ++i)
+        Tracer::Record("new", Tracer::Now(), 1);
+
+    auto trace = Tracer::ExportChromeTrace();
+
+    EXPECT_EQ(countOccurrences(trace, "\"old\""), Tracer::EVENTS_PER_THREAD - 10);
+    EXPECT_EQ(countOccurrences(trace, "\"new\""), 10);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "Threading/WorkerPool.h"
+
+class WorkerPoolTest : public ::testing::Test
+{
+public:
+    WorkerPoolTest() = default;
+
+    ~WorkerPoolTest() = default;
+
+protected:
+    void waitIdle(const WorkerPool& pool)
+    {
+        while (pool.getPendingCount() > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+};
+
+TEST_F(WorkerPoolTest, SameKeyRunsInOrder)
+{
+    WorkerPool pool(4, 1024);
+    std::vector<int> order;
+    std::atomic<int> running = 0;
+    bool overlapped = false;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(pool.submit("timer", [&, i]() {
+            if (++running > 1)
+                overlapped = true;
+
+            order.push_back(i);
+            --running;
+        }));
+    }
+
+    waitIdle(pool);
+
+    EXPECT_FALSE(overlapped);
+    ASSERT_EQ(order.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(order[i], i);
+}
+
+TEST_F(WorkerPoolTest, DifferentKeysRunConcurrently)
+{
+    WorkerPool pool(2, 1024);
+    std::atomic<int> started = 0;
+    std::atomic<bool> release = false;
+
+    // Each task waits for the other one, so this completes only if both run at the same time
+    for (const char* key : { "first", "second" })
+    {
+        pool.submit(key, [&]() {
+            ++started;
+            while (started < 2 && !release)
+                std::this_thread::yield();
+        });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (started < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+
+    release = true;
+    waitIdle(pool);
+
+    EXPECT_EQ(started, 2);
+}
+
+TEST_F(WorkerPoolTest, RejectsBeyondCapacity)
+{
+    WorkerPool pool(1, 2);
+    std::atomic<bool> release = false;
+
+    EXPECT_TRUE(pool.submit([&]() { while (!release) std::this_thread::yield(); }));
+    EXPECT_TRUE(pool.submit("timer", []() {}));
+    EXPECT_FALSE(pool.submit("timer", []() {}));
+    EXPECT_FALSE(pool.submit([]() {}));
+
+    release = true;
+    waitIdle(pool);
+
+    EXPECT_TRUE(pool.submit([]() {}));
+}